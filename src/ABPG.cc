@@ -16,6 +16,7 @@
 #include "Potentials.h"
 #include "ProjectedMatricesInterface.h"
 #include "LocGridOrbitals.h"
+#include "MGmol_MPI.h"
 
 #include <iostream>
 using namespace std;
@@ -27,12 +28,29 @@ void ABPG<T>::setup(T& orbitals)
 
     if (ct.wf_dyn == 1) // use Anderson extrapolation
     {
+        int m = ct.wf_m;
+        if (ct.getAndersonMemoryBudget() > 0.)
+        {
+            // size of one set of orbitals (max. over MPI tasks)
+            double size = (double)orbitals.chromatic_number()
+                          * (double)orbitals.getLocNumpt()
+                          * (double)orbitals.subdivx() * sizeof(ORBDTYPE);
+            MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+            mmpi.allreduce(&size, 1, MPI_MAX);
+
+            m = AndersonMix<T>::maxHistoryLength(
+                m, 1.e6 * ct.getAndersonMemoryBudget(), size);
+            if (onpe0 && m < ct.wf_m)
+                os_ << "ABPG: Anderson history length reduced to " << m
+                    << " to fit memory budget" << endl;
+        }
+
         if( ct.getOrbitalsType() == OrbitalsType::Orthonormal )
         wf_mix_ = new OrthoAndersonMix<T>(
-            ct.wf_m, ct.betaAnderson, orbitals);
+            m, ct.betaAnderson, orbitals);
         else
             wf_mix_ = new AndersonMix<T>(
-                ct.wf_m, ct.betaAnderson, orbitals);
+                m, ct.betaAnderson, orbitals);
     }
 }
 
@@ -19,6 +19,7 @@
 #include "Solution.h"
 #endif
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 using namespace std;
@@ -65,6 +66,19 @@ AndersonMix<T>::~AndersonMix()
         delete fi_[i];
 }
 
+// m trial solutions and m residuals are stored
+template <class T>
+int AndersonMix<T>::maxHistoryLength(
+    const int m, const double budget, const double size_solution)
+{
+    if (budget <= 0.) return m;
+
+    assert(size_solution > 0.);
+    int mmax = (int)(budget / (2. * size_solution));
+
+    return min(m, mmax);
+}
+
 template <class T>
 void AndersonMix<T>::restart(void)
 {
@@ -45,6 +45,11 @@ public:
 
     virtual ~AndersonMix();
 
+    // history length fitting in a memory budget (in bytes),
+    // given the size of one trial solution
+    static int maxHistoryLength(
+        const int m, const double budget, const double size_solution);
+
     // update trial solution based on residual
     // need work array for temporary storage
     void update(T& res, T& work, std::ostream& os, const bool verbose);
@@ -0,0 +1,156 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "CentersCellList.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+// max. number of bins in each direction
+static const int max_nbins = 64;
+
+CentersCellList::CentersCellList(
+    const Vector3D& origin, const Vector3D& ll, const short bc[3])
+    : origin_(origin), ll_(ll)
+{
+    for (short d = 0; d < 3; d++)
+    {
+        assert(ll_[d] > 0.);
+        bc_[d]      = bc[d];
+        nbins_[d]   = 1;
+        binsize_[d] = ll_[d];
+    }
+}
+
+void CentersCellList::binCoords(const Vector3D& center, int ib[3]) const
+{
+    for (short d = 0; d < 3; d++)
+    {
+        // bring coordinate back into domain
+        double x = center[d] - origin_[d];
+        x -= floor(x / ll_[d]) * ll_[d];
+
+        ib[d] = (int)(x / binsize_[d]);
+        if (ib[d] >= nbins_[d]) ib[d] = nbins_[d] - 1;
+        if (ib[d] < 0) ib[d] = 0;
+    }
+}
+
+int CentersCellList::binIndex(const Vector3D& center) const
+{
+    int ib[3];
+    binCoords(center, ib);
+
+    return (ib[0] * nbins_[1] + ib[1]) * nbins_[2] + ib[2];
+}
+
+void CentersCellList::setup(
+    const vector<Vector3D>& centers, const double binsize)
+{
+    assert(binsize > 0.);
+
+    for (short d = 0; d < 3; d++)
+    {
+        nbins_[d] = (int)(ll_[d] / binsize);
+        if (nbins_[d] < 1) nbins_[d] = 1;
+        if (nbins_[d] > max_nbins) nbins_[d] = max_nbins;
+        binsize_[d] = ll_[d] / (double)nbins_[d];
+    }
+
+    bins_.clear();
+    bins_.resize(nbins_[0] * nbins_[1] * nbins_[2]);
+
+    centers_ = centers;
+    center2bin_.resize(centers_.size());
+    for (int i = 0; i < (int)centers_.size(); i++)
+    {
+        const int ibin = binIndex(centers_[i]);
+        bins_[ibin].push_back(i);
+        center2bin_[i] = ibin;
+    }
+}
+
+void CentersCellList::removeFromBin(const int i, const int ibin)
+{
+    vector<int>& bin(bins_[ibin]);
+    vector<int>::iterator it = find(bin.begin(), bin.end(), i);
+    assert(it != bin.end());
+    *it = bin.back();
+    bin.pop_back();
+}
+
+void CentersCellList::update(const int i, const Vector3D& center)
+{
+    assert(i < (int)centers_.size());
+
+    centers_[i] = center;
+
+    const int ibin = binIndex(center);
+    if (ibin != center2bin_[i])
+    {
+        removeFromBin(i, center2bin_[i]);
+        bins_[ibin].push_back(i);
+        center2bin_[i] = ibin;
+    }
+}
+
+void CentersCellList::getNeighbors(
+    const Vector3D& center, const double r, vector<int>& indexes) const
+{
+    indexes.clear();
+
+    int ib[3];
+    binCoords(center, ib);
+
+    // range of bins to visit in each direction
+    int imin[3];
+    int imax[3];
+    for (short d = 0; d < 3; d++)
+    {
+        const double k = ceil(r / binsize_[d]);
+        if (2. * k + 1. >= (double)nbins_[d])
+        {
+            imin[d] = 0;
+            imax[d] = nbins_[d] - 1;
+        }
+        else
+        {
+            imin[d] = ib[d] - (int)k;
+            imax[d] = ib[d] + (int)k;
+        }
+    }
+
+    for (int i = imin[0]; i <= imax[0]; i++)
+    {
+        const int i0 = (i + nbins_[0]) % nbins_[0];
+        for (int j = imin[1]; j <= imax[1]; j++)
+        {
+            const int j0 = (j + nbins_[1]) % nbins_[1];
+            for (int k = imin[2]; k <= imax[2]; k++)
+            {
+                const int k0 = (k + nbins_[2]) % nbins_[2];
+
+                const vector<int>& bin(
+                    bins_[(i0 * nbins_[1] + j0) * nbins_[2] + k0]);
+                for (vector<int>::const_iterator it = bin.begin();
+                     it != bin.end(); ++it)
+                {
+                    const double d = centers_[*it].minimage(center, ll_, bc_);
+                    if (d < r) indexes.push_back(*it);
+                }
+            }
+        }
+    }
+
+    sort(indexes.begin(), indexes.end());
+}
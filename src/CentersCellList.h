@@ -0,0 +1,65 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_CENTERSCELLLIST_H
+#define MGMOL_CENTERSCELLLIST_H
+
+#include "Vector3D.h"
+
+#include <vector>
+
+// Spatial index for a set of centers in a (possibly periodic) domain.
+// The domain is divided into a uniform grid of bins, each bin holding
+// the list of indexes of centers located inside it.
+// Neighbors within a given distance are found by visiting only the bins
+// close to the query point, instead of all the centers.
+class CentersCellList
+{
+private:
+    Vector3D origin_;
+    Vector3D ll_;
+    short bc_[3];
+
+    // number of bins in each direction
+    int nbins_[3];
+
+    // bin sizes
+    double binsize_[3];
+
+    // list of indexes of centers in each bin
+    std::vector<std::vector<int>> bins_;
+
+    // centers and bin of each center
+    std::vector<Vector3D> centers_;
+    std::vector<int> center2bin_;
+
+    int binIndex(const Vector3D& center) const;
+    void binCoords(const Vector3D& center, int ib[3]) const;
+    void removeFromBin(const int i, const int ibin);
+
+public:
+    CentersCellList(
+        const Vector3D& origin, const Vector3D& ll, const short bc[3]);
+
+    // build list with bins of size at least binsize
+    void setup(const std::vector<Vector3D>& centers, const double binsize);
+
+    // move center i to new position
+    void update(const int i, const Vector3D& center);
+
+    int size() const { return (int)centers_.size(); }
+
+    // get indexes (sorted in ascending order) of centers at distance
+    // smaller than r from center
+    void getNeighbors(const Vector3D& center, const double r,
+        std::vector<int>& indexes) const;
+};
+
+#endif
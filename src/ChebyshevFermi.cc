@@ -0,0 +1,173 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "ChebyshevFermi.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+ChebyshevFermi::ChebyshevFermi(const double emin, const double emax,
+    const double width, const int order)
+    : emin_(emin), emax_(emax), width_(width), order_(order)
+{
+    assert(emax_ > emin_);
+    assert(width_ > 0.);
+    assert(order_ > 0);
+
+    // Chebyshev-Gauss quadrature points
+    nquad_ = 2 * (order_ + 1);
+    energies_.resize(nquad_);
+    cos_.resize(nquad_ * (order_ + 1));
+
+    const double c = center();
+    const double s = 1. / scale();
+    for (int j = 0; j < nquad_; j++)
+    {
+        const double theta = M_PI * (j + 0.5) / (double)nquad_;
+        energies_[j]       = c + s * cos(theta);
+        for (int k = 0; k <= order_; k++)
+            cos_[j + k * nquad_] = cos(k * theta);
+    }
+}
+
+int ChebyshevFermi::estimateOrder(const double emin, const double emax,
+    const double width, const int ndigits)
+{
+    assert(width > 0.);
+
+    // Chebyshev coefficients of Fermi function decay like exp(-k*pi*w),
+    // with w the width scaled to interval [-1,1]
+    const double w = 2. * width / (emax - emin);
+
+    return (int)ceil(ndigits * log(10.) / (M_PI * w)) + 1;
+}
+
+double ChebyshevFermi::minWidth(const double emin, const double emax,
+    const int order, const int ndigits)
+{
+    assert(order > 1);
+
+    const double w = ndigits * log(10.) / (M_PI * (order - 1));
+
+    return 0.5 * w * (emax - emin);
+}
+
+void ChebyshevFermi::project(
+    const vector<double>& f, vector<double>& coeffs) const
+{
+    assert((int)f.size() == nquad_);
+
+    coeffs.resize(order_ + 1);
+    const double alpha = 2. / (double)nquad_;
+    for (int k = 0; k <= order_; k++)
+    {
+        const double* const pcos = &cos_[k * nquad_];
+
+        double sum = 0.;
+        for (int j = 0; j < nquad_; j++)
+            sum += f[j] * pcos[j];
+        coeffs[k] = alpha * sum;
+    }
+    coeffs[0] *= 0.5;
+}
+
+void ChebyshevFermi::computeCoefficients(
+    const double mu, vector<double>& coeffs) const
+{
+    vector<double> f(nquad_);
+    for (int j = 0; j < nquad_; j++)
+    {
+        const double t = (energies_[j] - mu) / width_;
+        if (t > 0.)
+        {
+            const double e = exp(-t);
+            f[j]           = e / (1. + e);
+        }
+        else
+        {
+            f[j] = 1. / (1. + exp(t));
+        }
+    }
+
+    project(f, coeffs);
+}
+
+void ChebyshevFermi::computeEntropyCoefficients(
+    const double mu, vector<double>& coeffs) const
+{
+    // with t=(E-mu)/width, s = ln(1+exp(-|t|)) + |t|*f(|t|)
+    vector<double> s(nquad_);
+    for (int j = 0; j < nquad_; j++)
+    {
+        const double t = fabs(energies_[j] - mu) / width_;
+        const double e = exp(-t);
+        s[j]           = log1p(e) + t * e / (1. + e);
+    }
+
+    project(s, coeffs);
+}
+
+double ChebyshevFermi::trace(
+    const vector<double>& moments, const double mu) const
+{
+    assert((int)moments.size() > order_);
+
+    vector<double> coeffs;
+    computeCoefficients(mu, coeffs);
+
+    double sum = 0.;
+    for (int k = 0; k <= order_; k++)
+        sum += coeffs[k] * moments[k];
+
+    return sum;
+}
+
+double ChebyshevFermi::entropy(
+    const vector<double>& moments, const double mu) const
+{
+    assert((int)moments.size() > order_);
+
+    vector<double> coeffs;
+    computeEntropyCoefficients(mu, coeffs);
+
+    double sum = 0.;
+    for (int k = 0; k <= order_; k++)
+        sum += coeffs[k] * moments[k];
+
+    return sum;
+}
+
+double ChebyshevFermi::computeChemicalPotential(
+    const vector<double>& moments, const double nocc) const
+{
+    const int maxit  = 100;
+    const double tol = 1.e-12;
+
+    // trace(mu) is increasing with mu
+    double mu1 = emin_ - 10. * width_;
+    double mu2 = emax_ + 10. * width_;
+    for (int it = 0; it < maxit; it++)
+    {
+        const double mu = 0.5 * (mu1 + mu2);
+        const double f  = trace(moments, mu) - nocc;
+
+        if (fabs(f) < tol) return mu;
+
+        if (f < 0.)
+            mu1 = mu;
+        else
+            mu2 = mu;
+    }
+
+    return 0.5 * (mu1 + mu2);
+}
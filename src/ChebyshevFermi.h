@@ -0,0 +1,89 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_CHEBYSHEVFERMI_H
+#define MGMOL_CHEBYSHEVFERMI_H
+
+#include <vector>
+
+// Chebyshev expansion of the Fermi-Dirac function
+//   f(E) = 1 / (1 + exp((E-mu)/width))
+// for E in interval [emin,emax], mapped onto [-1,1]:
+//   f(E) = sum_k c_k(mu) T_k(x), x = (E-center)/half_width
+// Given the moments tr(T_k(X)) of a matrix X, the trace of f(X)
+// can be evaluated for any mu without additional matrix operations.
+class ChebyshevFermi
+{
+private:
+    // spectral interval
+    double emin_;
+    double emax_;
+
+    // kB*T
+    double width_;
+
+    // max. degree of Chebyshev polynomials
+    int order_;
+
+    // values of cos(k*theta_j) at quadrature points,
+    // stored as [j+k*nquad]
+    int nquad_;
+    std::vector<double> cos_;
+
+    // energies corresponding to quadrature points
+    std::vector<double> energies_;
+
+    // Chebyshev coefficients of function given by its values
+    // at quadrature points
+    void project(
+        const std::vector<double>& f, std::vector<double>& coeffs) const;
+
+public:
+    ChebyshevFermi(const double emin, const double emax, const double width,
+        const int order);
+
+    // degree needed to reach ndigits accuracy for Fermi function with
+    // given width, on interval [emin,emax]
+    static int estimateOrder(const double emin, const double emax,
+        const double width, const int ndigits);
+
+    // smallest width that can be represented with accuracy ndigits
+    // by a polynomial of degree order on interval [emin,emax]
+    static double minWidth(const double emin, const double emax,
+        const int order, const int ndigits);
+
+    int order() const { return order_; }
+    double width() const { return width_; }
+
+    // map energy interval onto [-1,1]: x = scale*(E - center)
+    double center() const { return 0.5 * (emax_ + emin_); }
+    double scale() const { return 2. / (emax_ - emin_); }
+
+    // coefficients c_k for chemical potential mu, k=0..order
+    void computeCoefficients(const double mu, std::vector<double>& coeffs) const;
+
+    // coefficients c_k of entropy function
+    //   s(E) = -f(E)*ln(f(E)) - (1-f(E))*ln(1-f(E))
+    // for chemical potential mu, k=0..order
+    void computeEntropyCoefficients(
+        const double mu, std::vector<double>& coeffs) const;
+
+    // tr(f(X)) from moments tr(T_k(X))
+    double trace(const std::vector<double>& moments, const double mu) const;
+
+    // tr(s(X)) from moments tr(T_k(X))
+    double entropy(const std::vector<double>& moments, const double mu) const;
+
+    // chemical potential mu such that tr(f(X))=nocc, by bisection
+    double computeChemicalPotential(
+        const std::vector<double>& moments, const double nocc) const;
+};
+
+#endif
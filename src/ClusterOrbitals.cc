@@ -12,6 +12,7 @@
 #include "Control.h"
 #include "DataDistribution.h"
 #include "Mesh.h"
+#include "ShortSightedInverse.h"
 #include <vector>
 
 using namespace std;
@@ -32,6 +33,12 @@ ClusterOrbitals::ClusterOrbitals(LocalizationRegions* lrs)
     avg_locfcns_        = 0.;
     old_avg_locfcns_    = 0.;
     avg_locfcns_global_ = 0.;
+    avg_cost_global_    = 0.;
+    avg_weight_         = 1.;
+    cluster_cost_       = 0.;
+
+    predicted_imbalance_ = 0.;
+    last_measured_time_  = 0.;
 
     // subdomain bias
     subdom_bias_ = 0.;
@@ -93,6 +100,15 @@ void ClusterOrbitals::initializeRegionsData()
     avg_locfcns_global_
         = (double)lrs_->globalNumLRs() / (double)myPEenv.n_mpi_tasks();
 
+    // compute average cost of clusters
+    assert((int)weights_.size() == lrs_->globalNumLRs());
+    double total_cost = 0.;
+    for (std::vector<double>::const_iterator it = weights_.begin();
+         it != weights_.end(); ++it)
+        total_cost += *it;
+    avg_cost_global_ = total_cost / (double)myPEenv.n_mpi_tasks();
+    avg_weight_      = total_cost / (double)lrs_->globalNumLRs();
+
     for (std::vector<int>::iterator it = locfcns_.begin(); it != locfcns_.end();
          ++it)
     {
@@ -140,12 +156,14 @@ void ClusterOrbitals::initializeRegionsData()
 // compute local bias
 void ClusterOrbitals::computeLocalBias()
 {
-    int sz       = (int)cluster_indexes_.size();
-    double denom = sz > 0 ? (double)sz : min(0.5, 0.5 * avg_locfcns_global_);
-    double ratio = avg_locfcns_global_ / denom;
+    // cluster cost is cluster size if each function has unit cost
+    double denom = cluster_cost_ > 0.
+                       ? cluster_cost_
+                       : min(0.5 * avg_weight_, 0.5 * avg_cost_global_);
+    double ratio = avg_cost_global_ / denom;
 
     // test switch
-    bool test_switch = (denom < avg_locfcns_global_);
+    bool test_switch = (denom < avg_cost_global_);
     if (isswitched_ != test_switch)
     {
         // modify alpha
@@ -269,7 +287,14 @@ bool ClusterOrbitals::checkConv()
     // local convergence criterion
 
     // (strong convergence/ early termination)
-    int sconv = (max_cluster_size_ == ceil(avg_locfcns_global_)) ? 0 : 1;
+    Control& ct = *(Control::instance());
+    int sconv   = (max_cluster_size_ == ceil(avg_locfcns_global_)) ? 0 : 1;
+    // with non-uniform costs, stop when imbalance is below threshold
+    if (ct.load_balancing_cost_model > 0)
+        sconv = (cluster_cost_ > (1. + ct.load_balancing_imbalance_threshold)
+                                     * avg_cost_global_)
+                    ? 1
+                    : 0;
     // (weak convergence)
     double diff = old_avg_locfcns_ - avg_locfcns_;
     int wconv   = (fabs(diff) <= 1.0e-6) ? 0 : 1;
@@ -304,6 +329,9 @@ int ClusterOrbitals::computeClusters(const short maxiters)
     // timer begin
     computeClusters_tm_.start();
 
+    // estimate cost of functions based on current clusters
+    computeWeights();
+
     // reset data
     reset();
     // initialize locally centered regions data
@@ -385,6 +413,17 @@ int ClusterOrbitals::computeClusters(const short maxiters)
              << ", global max cluster = " << locmax << ", conv = " << conv
              << endl;
 
+    double maxcost = cluster_cost_;
+    mmpi.allreduce(&maxcost, 1, MPI_MAX);
+    predicted_imbalance_
+        = avg_cost_global_ > 0. ? maxcost / avg_cost_global_ - 1. : 0.;
+    if (onpe0 && ct.load_balancing_cost_model > 0)
+        cout << "Predicted imbalance (max/avg cost - 1) = "
+             << predicted_imbalance_ << endl;
+
+    // restart measurements for new clusters
+    last_measured_time_ = measuredTime();
+
     ///*
     // write to vtk file
     //   writeVTKDataset("final_clusters",myPEenv,vtkfile);
@@ -420,7 +459,10 @@ void ClusterOrbitals::setup()
     double subdom_width[3] = {};
     for (int k = 0; k < 3; k++)
     {
-        subdom_width[k] = domain[k] / myPEenv.n_mpi_task(k);
+        const std::vector<unsigned>& partition(mygrid.partition(k));
+        subdom_width[k]
+            = (double)(*std::min_element(partition.begin(), partition.end()))
+              * mygrid.hgrid(k);
     }
     cluster_range_radius_  = *std::min_element(subdom_width, subdom_width + 3);
     const int max_steps[3] = { subdom_steps_, subdom_steps_, subdom_steps_ };
@@ -458,6 +500,7 @@ void ClusterOrbitals::reset()
     avg_locfcns_        = 0.;
     old_avg_locfcns_    = 0.;
     avg_locfcns_global_ = 0.;
+    cluster_cost_       = 0.;
 }
 
 // determine which cluster owns which region
@@ -511,11 +554,134 @@ void ClusterOrbitals::updateCluster()
     comm_data_->getColumnIndexes(lrindex, cluster_indexes_);
 
     max_cluster_size_ = comm_data_->nzmax();
+
+    cluster_cost_ = 0.;
+    for (std::vector<int>::const_iterator it = cluster_indexes_.begin();
+         it != cluster_indexes_.end(); ++it)
+        cluster_cost_ += weights_[*it];
     // compute "local average" cluster size
     //   assert(n > 0);
     old_avg_locfcns_ = avg_locfcns_;
     avg_locfcns_     = (double)comm_data_->nnzmat() / (double)comm_data_->n();
 }
+double ClusterOrbitals::measuredTime() const
+{
+    // the short-sighted inverse is computed for the functions
+    // in cluster assigned to this proc.
+    return ShortSightedInverse::computeInvSTime();
+}
+
+// Set weights_ to cost of each function:
+// 0: one per function (clusters balanced by size)
+// 1: number of overlapping functions, which determines the sizes of
+//    rows of sparse matrices and local solvers
+// 2: time measured since clusters were computed, divided equally
+//    among functions of cluster. Cost model is used if no timing available.
+void ClusterOrbitals::computeWeights()
+{
+    Control& ct       = *(Control::instance());
+    MGmol_MPI& mmpi   = *(MGmol_MPI::instance());
+    const int nglobal = lrs_->globalNumLRs();
+
+    if (ct.load_balancing_cost_model == 0)
+    {
+        weights_.assign(nglobal, 1.);
+        return;
+    }
+
+    weights_.assign(nglobal, 0.);
+
+    bool measured = false;
+    if (ct.load_balancing_cost_model == 2)
+    {
+        const double t = measuredTime() - last_measured_time_;
+        if (!cluster_indexes_.empty())
+        {
+            const double w = t / (double)cluster_indexes_.size();
+            for (std::vector<int>::const_iterator it = cluster_indexes_.begin();
+                 it != cluster_indexes_.end(); ++it)
+                weights_[*it] = w;
+        }
+        double tmin = t;
+        mmpi.allreduce(&tmin, 1, MPI_MIN);
+        measured = (tmin > 0.);
+    }
+    if (!measured)
+    {
+        weights_.assign(nglobal, 0.);
+        computeModelWeights();
+    }
+
+    mmpi.allreduce(&weights_[0], nglobal, MPI_SUM);
+
+    // make sure each function has a non-zero cost
+    double avg = 0.;
+    for (int i = 0; i < nglobal; i++)
+        avg += weights_[i];
+    avg /= (double)nglobal;
+    if (avg <= 0.) avg = 1.;
+    for (int i = 0; i < nglobal; i++)
+        weights_[i] = max(weights_[i], 1.e-3 * avg);
+
+    if (onpe0 && ct.verbose > 1)
+        cout << "ClusterOrbitals: average cost per function = " << avg
+             << (measured ? " (measured)" : " (model)") << endl;
+}
+
+void ClusterOrbitals::computeModelWeights()
+{
+    Control& ct            = *(Control::instance());
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    const Vector3D ll(mygrid.ll(0), mygrid.ll(1), mygrid.ll(2));
+
+    std::vector<int> local_gids;
+    lrs_->getLocalSubdomainIndices(local_gids);
+    const std::vector<int>& overlap_gids(lrs_->getOverlapGids());
+
+    for (std::vector<int>::const_iterator it = local_gids.begin();
+         it != local_gids.end(); ++it)
+    {
+        const Vector3D& center(lrs_->getCenter(*it));
+        const float radius = lrs_->radius(*it);
+
+        int count = 0;
+        for (std::vector<int>::const_iterator jt = overlap_gids.begin();
+             jt != overlap_gids.end(); ++jt)
+        {
+            const double d
+                = center.minimage(lrs_->getCenter(*jt), ll, ct.bcPoisson);
+            if (d < radius + lrs_->radius(*jt)) count++;
+        }
+        weights_[*it] = (double)max(count, 1);
+    }
+}
+
+// Compare time measured since last computation of clusters on each proc.
+// Return true if imbalance is above threshold, or if timings are not used.
+bool ClusterOrbitals::needsRebalancing()
+{
+    Control& ct = *(Control::instance());
+    if (ct.load_balancing_cost_model != 2) return true;
+
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+    Mesh* mymesh    = Mesh::instance();
+
+    const double t = measuredTime() - last_measured_time_;
+    double tmax    = t;
+    double tavg    = t;
+    mmpi.allreduce(&tmax, 1, MPI_MAX);
+    mmpi.allreduce(&tavg, 1, MPI_SUM);
+    tavg /= (double)mymesh->peenv().n_mpi_tasks();
+
+    const double imbalance = tavg > 0. ? tmax / tavg - 1. : 0.;
+    if (onpe0 && ct.verbose > 0)
+        cout << "ClusterOrbitals: measured imbalance = " << imbalance
+             << ", predicted = " << predicted_imbalance_ << endl;
+
+    return (imbalance > ct.load_balancing_imbalance_threshold);
+}
+
 // Print results in vtk format for visualization in visIT
 void ClusterOrbitals::writeVTKHeader(
     const int npx, const int npy, const int npz, std::ofstream& os)
@@ -51,6 +51,13 @@ private:
                              // localized functions
     int max_cluster_size_; // max. size of cluster in neighborhood
 
+    std::vector<double> weights_; // estimated cost of each function (by gid)
+    double avg_cost_global_; // global average cost of a cluster
+    double avg_weight_; // global average cost of one function
+    double cluster_cost_; // cost of cluster assigned to this proc.
+    double predicted_imbalance_; // max/avg cost - 1 for last clusters
+    double last_measured_time_; // timer value when clusters were computed
+
     int subdom_id_; // subdomain id ( == pid)
     short subdom_id_pos_; // position of subdomain info in subdomains data
     Vector3D* subdom_ll_; // subdomain dimension
@@ -81,6 +88,9 @@ private:
     double computeSquaredDistanceBetweenCenters(
         const Vector3D& center1, const Vector3D& center2) const;
     bool checkConv();
+    void computeWeights(); // estimate cost of each function
+    void computeModelWeights(); // cost model for locally centered functions
+    double measuredTime() const; // time spent in cluster dependent work
     void reset();
     void computeLocalRegionOwnership();
     void updateCluster();
@@ -95,6 +105,7 @@ public:
     int computeClusters(const short
             maxiters); // compute cluster of variables assigned to procs.
     ~ClusterOrbitals(); // destructor
+    bool needsRebalancing(); // check measured imbalance against threshold
     const std::vector<int>& getClusterIndices() const
     {
         return cluster_indexes_;
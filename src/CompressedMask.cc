@@ -0,0 +1,178 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "CompressedMask.h"
+
+using namespace std;
+
+void CompressedMask::setup(const lmasktype* const mask, const int dim0,
+    const int dim1, const int dim2)
+{
+    assert(dim2 < 65536);
+
+    clear();
+
+    dim0_ = dim0;
+    dim1_ = dim1;
+    dim2_ = dim2;
+
+    const int nrows = dim0 * dim1;
+    run_ptr_.resize(nrows + 1);
+    shell_ptr_.resize(nrows + 1);
+
+    const lmasktype* pmask = mask;
+    for (int row = 0; row < nrows; row++)
+    {
+        run_ptr_[row]   = (int)run_begin_.size();
+        shell_ptr_[row] = (int)shell_z_.size();
+
+        bool in_run = false;
+        for (int iz = 0; iz < dim2; iz++)
+        {
+            const lmasktype val = pmask[iz];
+            assert(val >= 0 && val <= 1);
+
+            if (val > 0.)
+            {
+                if (!in_run)
+                {
+                    run_begin_.push_back((unsigned short)iz);
+                    in_run = true;
+                }
+                if (val < 1.)
+                {
+                    shell_z_.push_back((unsigned short)iz);
+                    shell_val_.push_back(val);
+                }
+            }
+            else if (in_run)
+            {
+                run_end_.push_back((unsigned short)iz);
+                in_run = false;
+            }
+        }
+        if (in_run) run_end_.push_back((unsigned short)dim2);
+
+        pmask += dim2;
+    }
+    run_ptr_[nrows]   = (int)run_begin_.size();
+    shell_ptr_[nrows] = (int)shell_z_.size();
+
+    assert(run_begin_.size() == run_end_.size());
+    assert(shell_z_.size() == shell_val_.size());
+}
+
+void CompressedMask::clear()
+{
+    dim0_ = 0;
+    dim1_ = 0;
+    dim2_ = 0;
+
+    // release memory
+    vector<int>().swap(run_ptr_);
+    vector<unsigned short>().swap(run_begin_);
+    vector<unsigned short>().swap(run_end_);
+    vector<int>().swap(shell_ptr_);
+    vector<unsigned short>().swap(shell_z_);
+    vector<lmasktype>().swap(shell_val_);
+}
+
+template <typename T>
+void CompressedMask::multiply(T* u, const int incx, const int incy) const
+{
+    int row = 0;
+    for (int ix = 0; ix < dim0_; ix++)
+    {
+        T* pux = u + ix * incx;
+        for (int iy = 0; iy < dim1_; iy++)
+        {
+            T* const pu = pux + iy * incy;
+
+            zeroOutsideRuns(pu, row);
+
+            for (int s = shell_ptr_[row]; s < shell_ptr_[row + 1]; s++)
+                pu[shell_z_[s]] *= (T)shell_val_[s];
+
+            row++;
+        }
+    }
+}
+
+template <typename T>
+void CompressedMask::cut(T* u, const int incx, const int incy) const
+{
+    int row = 0;
+    for (int ix = 0; ix < dim0_; ix++)
+    {
+        T* pux = u + ix * incx;
+        for (int iy = 0; iy < dim1_; iy++)
+        {
+            T* const pu = pux + iy * incy;
+
+            zeroOutsideRuns(pu, row);
+
+            // mask=1 inside runs
+            for (int r = run_ptr_[row]; r < run_ptr_[row + 1]; r++)
+                for (int iz = run_begin_[r]; iz < run_end_[r]; iz++)
+                {
+                    if (pu[iz] > 1.)
+                        pu[iz] = 1.;
+                    else if (pu[iz] < -1.)
+                        pu[iz] = -1.;
+                }
+
+            for (int s = shell_ptr_[row]; s < shell_ptr_[row + 1]; s++)
+            {
+                const T umask = (T)shell_val_[s];
+                T& val        = pu[shell_z_[s]];
+                if (val > umask)
+                    val = umask;
+                else if (val < -umask)
+                    val = -umask;
+            }
+
+            row++;
+        }
+    }
+}
+
+void CompressedMask::expand(vector<lmasktype>& mask) const
+{
+    mask.assign(size(), 0.);
+
+    const int nrows = dim0_ * dim1_;
+    for (int row = 0; row < nrows; row++)
+    {
+        lmasktype* const pmask = &mask[row * dim2_];
+        for (int r = run_ptr_[row]; r < run_ptr_[row + 1]; r++)
+            for (int iz = run_begin_[r]; iz < run_end_[r]; iz++)
+                pmask[iz] = 1.;
+        for (int s = shell_ptr_[row]; s < shell_ptr_[row + 1]; s++)
+            pmask[shell_z_[s]] = shell_val_[s];
+    }
+}
+
+size_t CompressedMask::memory() const
+{
+    return (run_ptr_.size() + shell_ptr_.size()) * sizeof(int)
+           + (run_begin_.size() + run_end_.size() + shell_z_.size())
+                 * sizeof(unsigned short)
+           + shell_val_.size() * sizeof(lmasktype);
+}
+
+// explicit instantiations
+template void CompressedMask::multiply(
+    float* u, const int incx, const int incy) const;
+template void CompressedMask::multiply(
+    double* u, const int incx, const int incy) const;
+template void CompressedMask::cut(
+    float* u, const int incx, const int incy) const;
+template void CompressedMask::cut(
+    double* u, const int incx, const int incy) const;
@@ -0,0 +1,89 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_COMPRESSEDMASK_H
+#define MGMOL_COMPRESSEDMASK_H
+
+#include "global.h"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+// Compressed representation of a localization mask on a 3D block of
+// dim0 x dim1 x dim2 grid points (z index fastest).
+// Masks values are 0 or 1 except on a thin shell, so for each (x,y) row
+// we store intervals [begin,end) of z indexes where the mask is not 0,
+// plus an explicit list of "shell" points where 0<mask<1.
+class CompressedMask
+{
+private:
+    int dim0_;
+    int dim1_;
+    int dim2_;
+
+    // for each row, index of first interval in run_begin_/run_end_
+    std::vector<int> run_ptr_;
+    std::vector<unsigned short> run_begin_;
+    std::vector<unsigned short> run_end_;
+
+    // for each row, index of first shell point in shell_z_/shell_val_
+    std::vector<int> shell_ptr_;
+    std::vector<unsigned short> shell_z_;
+    std::vector<lmasktype> shell_val_;
+
+    template <typename T>
+    void zeroOutsideRuns(T* pu, const int row) const
+    {
+        int iz = 0;
+        for (int r = run_ptr_[row]; r < run_ptr_[row + 1]; r++)
+        {
+            for (; iz < run_begin_[r]; iz++)
+                pu[iz] = 0.;
+            iz = run_end_[r];
+        }
+        for (; iz < dim2_; iz++)
+            pu[iz] = 0.;
+    }
+
+public:
+    CompressedMask() : dim0_(0), dim1_(0), dim2_(0) {}
+
+    // build from dense array of mask values
+    void setup(const lmasktype* const mask, const int dim0, const int dim1,
+        const int dim2);
+
+    void clear();
+
+    // number of points in dense representation
+    int size() const { return dim0_ * dim1_ * dim2_; }
+
+    int nruns() const { return (int)run_begin_.size(); }
+    int nshell() const { return (int)shell_z_.size(); }
+
+    // u <- u*mask, for u with strides incx and incy in directions x and y
+    template <typename T>
+    void multiply(T* u, const int incx, const int incy) const;
+
+    // u <- sign(u)*min(|u|,mask)
+    template <typename T>
+    void cut(T* u, const int incx, const int incy) const;
+
+    // rebuild dense array of mask values
+    void expand(std::vector<lmasktype>& mask) const;
+
+    // memory (in bytes) used by compressed representation
+    size_t memory() const;
+
+    // memory (in bytes) that would be used by dense representation
+    size_t denseMemory() const { return size() * sizeof(lmasktype); }
+};
+
+#endif
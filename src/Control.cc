@@ -14,6 +14,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstring>
+#include <sstream>
 //#include <iomanip>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -78,10 +79,15 @@ Control::Control()
     conv_criterion_        = 0;
     steps                  = 0;
     dm_algo_               = 0;
+    dist_eigensolver_      = 0;
+    nb_extra_eigenpairs_   = 10;
     dm_approx_order        = 500;
-    dm_approx_ndigits      = 1;
+    dm_approx_ndigits      = 6;
     dm_approx_power_maxits = 100;
 
+    xlbomd_dissipation_order_ = 5;
+    xlbomd_scf_steps_         = 2;
+
     // undefined values
     it_algo_type_                    = -1;
     DM_solver_                       = -1;
@@ -133,6 +139,8 @@ Control::Control()
     bcPoisson[1]                      = -1;
     bcPoisson[2]                      = -1;
     out_restart_file_type             = -1;
+    out_restart_sparse                = -1;
+    out_restart_compression           = -1;
     spread_radius                     = -1.;
     iprint_residual                   = -1;
     override_restart                  = -1;
@@ -145,9 +153,17 @@ Control::Control()
     conv_tol                          = -1.;
     thermostat_type                   = -1;
     hartree_reset_                    = -1;
+    adaptive_scf_                     = -1;
     threshold_eigenvalue_gram_        = -1.;
     threshold_eigenvalue_gram_quench_ = -1.;
     pair_mlwf_distance_threshold_     = -1.;
+    anderson_memory_budget_           = -1.;
+
+    load_balancing_cost_model          = -1;
+    load_balancing_imbalance_threshold = -1.;
+    images_method                      = -1;
+    images_climbing                    = -1;
+    images_spring_constant             = -1.;
 
     // data members set once for all (not accessible through interface)
     screening_const = 0.;
@@ -246,6 +262,24 @@ void Control::print(ostream& os)
     {
         os << " Density matrix computation algorithm = "
            << " Diagonalization " << endl;
+        switch (DistEigensolver())
+        {
+            case DistEigensolverType::Syevd:
+                str = "syevd";
+                break;
+            case DistEigensolverType::Syevr:
+                str = "syevr";
+                break;
+            default:
+                str = "syev";
+        }
+        os << " Eigensolver = " << str << endl;
+    }
+    if (DMEigensolver() == DMEigensolverType::Chebyshev)
+    {
+        os << " Density matrix computation algorithm = "
+           << " Chebyshev approximation, max. order " << dm_approx_order
+           << ", " << dm_approx_ndigits << " digits" << endl;
     }
     os << " Load balancing alpha for computing bias = " << load_balancing_alpha
        << endl;
@@ -255,8 +289,14 @@ void Control::print(ostream& os)
        << load_balancing_max_iterations << endl;
     os << " Control parameter for recomputing load balancing = "
        << load_balancing_modulo << endl;
+    os << " Load balancing cost model = " << load_balancing_cost_model
+       << ", imbalance threshold = " << load_balancing_imbalance_threshold
+       << endl;
     os << " Load balancing output filename = " << load_balancing_output_file
        << endl;
+    os << " Images method = " << (images_method == 1 ? "NEB" : "independent")
+       << ", climbing image = " << images_climbing
+       << ", spring constant = " << images_spring_constant << endl;
     if (loc_mode_) os << " Localization radius       = " << cut_radius << endl;
     os << endl;
 
@@ -323,7 +363,7 @@ void Control::sync(void)
     if (onpe0 && verbose > 0) (*MPIdata::sout) << "Control::sync()" << endl;
 #ifdef USE_MPI
     // pack
-    const short size_short_buffer = 89;
+    const short size_short_buffer = 94;
     short* short_buffer           = new short[size_short_buffer];
     if (mype_ == 0)
     {
@@ -403,14 +443,24 @@ void Control::sync(void)
         short_buffer[73] = load_balancing_modulo;
         short_buffer[74] = write_clusters;
         short_buffer[75] = DM_solver_;
-        short_buffer[80] = dm_algo_;
-        short_buffer[81] = dm_approx_order;
-        short_buffer[82] = dm_approx_ndigits;
-        short_buffer[83] = dm_approx_power_maxits;
-        short_buffer[84] = spread_penalty_type_;
-        short_buffer[85] = dm_use_old_;
-        short_buffer[86] = max_electronic_steps_tight_;
-        short_buffer[88] = hartree_reset_;
+        short_buffer[76] = dist_eigensolver_;
+        short_buffer[77] = nb_extra_eigenpairs_;
+        short_buffer[78] = xlbomd_dissipation_order_;
+        short_buffer[79] = dm_algo_;
+        short_buffer[80] = dm_approx_order;
+        short_buffer[81] = dm_approx_ndigits;
+        short_buffer[82] = dm_approx_power_maxits;
+        short_buffer[83] = spread_penalty_type_;
+        short_buffer[84] = dm_use_old_;
+        short_buffer[85] = max_electronic_steps_tight_;
+        short_buffer[86] = xlbomd_scf_steps_;
+        short_buffer[87] = hartree_reset_;
+        short_buffer[88] = adaptive_scf_;
+        short_buffer[89] = load_balancing_cost_model;
+        short_buffer[90] = images_method;
+        short_buffer[91] = images_climbing;
+        short_buffer[92] = out_restart_sparse;
+        short_buffer[93] = out_restart_compression;
     }
     else
     {
@@ -430,7 +480,7 @@ void Control::sync(void)
         memset(&int_buffer[0], 0, size_int_buffer * sizeof(int));
     }
 
-    const short size_float_buffer = 42;
+    const short size_float_buffer = 45;
     float* float_buffer           = new float[size_float_buffer];
     if (mype_ == 0)
     {
@@ -475,6 +525,9 @@ void Control::sync(void)
         float_buffer[39] = overallocate_factor_;
         float_buffer[40] = threshold_eigenvalue_gram_quench_;
         float_buffer[41] = pair_mlwf_distance_threshold_;
+        float_buffer[42] = anderson_memory_budget_;
+        float_buffer[43] = load_balancing_imbalance_threshold;
+        float_buffer[44] = images_spring_constant;
     }
     else
     {
@@ -520,6 +573,16 @@ void Control::sync(void)
         mpirc = MPI_Bcast(&pseudopot_flags_[i], 1, MPI_SHORT, 0, comm_global_);
     }
 
+    for (short d = 0; d < 3; d++)
+    {
+        int npart = (int)mesh_partition_[d].size();
+        mpirc     = MPI_Bcast(&npart, 1, MPI_INT, 0, comm_global_);
+        mesh_partition_[d].resize(npart);
+        if (npart > 0)
+            mpirc = MPI_Bcast(&mesh_partition_[d][0], npart, MPI_UNSIGNED, 0,
+                comm_global_);
+    }
+
     if (mpirc != MPI_SUCCESS)
     {
         (*MPIdata::sout) << "MPI Bcast of Control failed!!!" << endl;
@@ -603,14 +666,24 @@ void Control::sync(void)
     load_balancing_modulo            = short_buffer[73];
     write_clusters                   = short_buffer[74];
     DM_solver_                       = short_buffer[75];
-    dm_algo_                         = short_buffer[80];
-    dm_approx_order                  = short_buffer[81];
-    dm_approx_ndigits                = short_buffer[82];
-    dm_approx_power_maxits           = short_buffer[83];
-    spread_penalty_type_             = short_buffer[84];
-    dm_use_old_                      = short_buffer[85];
-    max_electronic_steps_tight_      = short_buffer[86];
-    hartree_reset_                   = short_buffer[88];
+    dist_eigensolver_                = short_buffer[76];
+    nb_extra_eigenpairs_             = short_buffer[77];
+    xlbomd_dissipation_order_        = short_buffer[78];
+    dm_algo_                         = short_buffer[79];
+    dm_approx_order                  = short_buffer[80];
+    dm_approx_ndigits                = short_buffer[81];
+    dm_approx_power_maxits           = short_buffer[82];
+    spread_penalty_type_             = short_buffer[83];
+    dm_use_old_                      = short_buffer[84];
+    max_electronic_steps_tight_      = short_buffer[85];
+    xlbomd_scf_steps_                = short_buffer[86];
+    hartree_reset_                   = short_buffer[87];
+    adaptive_scf_                    = short_buffer[88];
+    load_balancing_cost_model        = short_buffer[89];
+    images_method                    = short_buffer[90];
+    images_climbing                  = short_buffer[91];
+    out_restart_sparse               = short_buffer[92];
+    out_restart_compression          = short_buffer[93];
 
     numst    = int_buffer[0];
     nel_     = int_buffer[1];
@@ -658,6 +731,10 @@ void Control::sync(void)
     overallocate_factor_              = float_buffer[39];
     threshold_eigenvalue_gram_quench_ = float_buffer[40];
     pair_mlwf_distance_threshold_     = float_buffer[41];
+    anderson_memory_budget_           = float_buffer[42];
+
+    load_balancing_imbalance_threshold = float_buffer[43];
+    images_spring_constant             = float_buffer[44];
     max_electronic_steps_loose_       = max_electronic_steps;
 
     delete[] short_buffer;
@@ -752,6 +829,26 @@ int Control::checkState()
                          << endl;
         return -1;
     }
+    if (load_balancing_cost_model < 0 || load_balancing_cost_model > 2)
+    {
+        (*MPIdata::sout) << "Control::checkState() -> Invalid cost option "
+                            "for load balancing"
+                         << endl;
+        return -1;
+    }
+    if (out_restart_compression < 0 || out_restart_compression > 9)
+    {
+        (*MPIdata::sout) << "Control::checkState() -> Invalid compression "
+                            "level for restart files"
+                         << endl;
+        return -1;
+    }
+    if (images_method < 0 || images_method > 1)
+    {
+        (*MPIdata::sout) << "Control::checkState() -> Invalid images method"
+                         << endl;
+        return -1;
+    }
     if (wf_dyn != 0 && wf_dyn != 1)
     {
         (*MPIdata::sout) << "Control::checkState() -> Invalid quench method"
@@ -761,13 +858,31 @@ int Control::checkState()
     if (AtomsDynamic() == AtomsDynamicType::MD)
         if (!(WFExtrapolation() == WFExtrapolationType::Reversible
                 || WFExtrapolation() == WFExtrapolationType::Order2
-                || WFExtrapolation() == WFExtrapolationType::Order3))
+                || WFExtrapolation() == WFExtrapolationType::Order3
+                || WFExtrapolation() == WFExtrapolationType::XLBOMD))
         {
             (*MPIdata::sout) << "Control::checkState() -> Invalid option for "
                                 "WF extrapolation in MD!!!"
                              << endl;
             return -1;
         }
+    if (WFExtrapolation() == WFExtrapolationType::XLBOMD)
+    {
+        if (xlbomd_dissipation_order_ < 3 || xlbomd_dissipation_order_ > 7)
+        {
+            (*MPIdata::sout) << "Control::checkState() -> Invalid order for "
+                                "XL-BOMD dissipation: "
+                             << xlbomd_dissipation_order_ << endl;
+            return -1;
+        }
+        if (xlbomd_scf_steps_ < 1)
+        {
+            (*MPIdata::sout) << "Control::checkState() -> Invalid number of "
+                                "SCF steps for XL-BOMD"
+                             << endl;
+            return -1;
+        }
+    }
     if (init_loc != 0 && init_loc != 1)
     {
         (*MPIdata::sout)
@@ -1408,6 +1523,17 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         ngpts_[1] = vm["Mesh.ny"].as<short>();
         ngpts_[2] = vm["Mesh.nz"].as<short>();
 
+        const string partition_keys[3]
+            = { "Mesh.partition_x", "Mesh.partition_y", "Mesh.partition_z" };
+        for (short d = 0; d < 3; d++)
+        {
+            mesh_partition_[d].clear();
+            istringstream iss(vm[partition_keys[d]].as<string>());
+            unsigned n;
+            while (iss >> n)
+                mesh_partition_[d].push_back(n);
+        }
+
         if (vm.count("Potentials.pseudopotential"))
         {
             short filter_flag
@@ -1474,6 +1600,9 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         (*MPIdata::sout) << "Output restart file: " << out_restart_file
                          << " with info level " << out_restart_info << endl;
 
+        out_restart_sparse = vm["Restart.output_sparse"].as<bool>() ? 1 : 0;
+        out_restart_compression = vm["Restart.output_compression"].as<short>();
+
         checkpoint = vm["Restart.interval"].as<short>();
 
         rescale_v_ = vm["Restart.rescale_v"].as<double>();
@@ -1547,6 +1676,8 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
             wf_dyn        = 1;
             wf_m          = vm["ABPG.m"].as<short>();
             betaAnderson  = vm["ABPG.beta"].as<float>();
+
+            anderson_memory_budget_ = vm["ABPG.max_memory"].as<float>();
         }
         if (str.compare("PSD") == 0)
         {
@@ -1666,6 +1797,7 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         str = vm["Coloring.algo"].as<string>();
         if (str.compare("RLF") == 0) coloring_algo_ = 0;
         if (str.compare("Greedy") == 0) coloring_algo_ = 1;
+        if (str.compare("JP") == 0) coloring_algo_ = 2;
 
         str = vm["Coloring.scope"].as<string>();
         if (str.compare("local") == 0) coloring_algo_ += 10;
@@ -1674,6 +1806,7 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         max_electronic_steps        = vm["Quench.max_steps"].as<short>();
         max_electronic_steps_loose_ = max_electronic_steps;
         max_electronic_steps_tight_ = vm["Quench.max_steps_tight"].as<short>();
+        adaptive_scf_ = vm["Quench.adaptive"].as<bool>() ? 1 : 0;
         if (str.compare("QUENCH") == 0)
         {
             atoms_dyn_ = 0;
@@ -1741,6 +1874,13 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
 
             // override value of wf_extrapolation for XL-BOMD
             str = vm["MD.type"].as<string>();
+            if (str.compare("XLBOMD") == 0)
+            {
+                wf_extrapolation_ = 3;
+                xlbomd_dissipation_order_
+                    = vm["MD.XLBOMD_dissipation_order"].as<short>();
+                xlbomd_scf_steps_ = vm["MD.XLBOMD_scf_steps"].as<short>();
+            }
         } // MD
         else
         {
@@ -1825,12 +1965,34 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         if (str.compare("MVP") == 0) DM_solver_ = 1;
         if (str.compare("HMVP") == 0) DM_solver_ = 2;
 
+        str = vm["DensityMatrix.algo"].as<string>();
+        if (str.compare("Diagonalization") == 0) dm_algo_ = 0;
+        if (str.compare("Chebyshev") == 0) dm_algo_ = 1;
+        if (str.compare("SP2") == 0) dm_algo_ = 2;
+        dm_approx_order   = vm["DensityMatrix.approx_order"].as<short>();
+        dm_approx_ndigits = vm["DensityMatrix.approx_ndigits"].as<short>();
+        dm_approx_power_maxits
+            = vm["DensityMatrix.approx_power_maxits"].as<short>();
+
+        str = vm["DensityMatrix.eigensolver"].as<string>();
+        if (str.compare("syev") == 0) dist_eigensolver_ = 0;
+        if (str.compare("syevd") == 0) dist_eigensolver_ = 1;
+        if (str.compare("syevr") == 0) dist_eigensolver_ = 2;
+        nb_extra_eigenpairs_
+            = vm["DensityMatrix.nb_extra_eigenpairs"].as<short>();
+
         load_balancing_alpha = vm["LoadBalancing.alpha"].as<float>();
         load_balancing_damping_tol
             = vm["LoadBalancing.damping_tol"].as<float>();
         load_balancing_max_iterations
             = vm["LoadBalancing.max_iterations"].as<short>();
         load_balancing_modulo = vm["LoadBalancing.modulo"].as<short>();
+        str                   = vm["LoadBalancing.cost"].as<string>();
+        if (str.compare("size") == 0) load_balancing_cost_model = 0;
+        if (str.compare("model") == 0) load_balancing_cost_model = 1;
+        if (str.compare("measured") == 0) load_balancing_cost_model = 2;
+        load_balancing_imbalance_threshold
+            = vm["LoadBalancing.imbalance_threshold"].as<float>();
         load_balancing_output_file
             = vm["LoadBalancing.output_file"].as<string>();
         if (load_balancing_output_file.compare("") == 0)
@@ -1838,6 +2000,12 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         else
             write_clusters = 1;
 
+        str = vm["Images.method"].as<string>();
+        if (str.compare("independent") == 0) images_method = 0;
+        if (str.compare("NEB") == 0) images_method = 1;
+        images_climbing        = vm["Images.climbing"].as<bool>() ? 1 : 0;
+        images_spring_constant = vm["Images.spring_constant"].as<float>();
+
         // derived flags
         loc_mode_ = cut_radius < 100. ? true : false;
         if (coloring_algo_ >= 10)
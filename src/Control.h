@@ -48,6 +48,7 @@ enum class WFExtrapolationType
     Order2,
     Order3,
     Reversible,
+    XLBOMD,
     UNDEFINED    
 };
 
@@ -71,13 +72,19 @@ enum class DMNonLinearSolverType
 enum class DMEigensolverType
 {
     Eigensolver,
-#ifdef __MGMOL_CHEBYSHEV__
     Chebyshev,
-#endif
     SP2,
     UNDEFINED
 };
 
+enum class DistEigensolverType
+{
+    Syev,
+    Syevd,
+    Syevr,
+    UNDEFINED
+};
+
 enum class OrbitalsType
 {
     Eigenfunctions,
@@ -133,6 +140,10 @@ private:
     // Max. distance between pairs for MLWF transform
     float pair_mlwf_distance_threshold_;
 
+    // memory budget (in MB per MPI task) for Anderson history (<=0: none),
+    // which requires 2*m copies of the orbitals
+    float anderson_memory_budget_;
+
     // relative tolerance of KS energy convergence
     float conv_rtol_;
 
@@ -149,6 +160,9 @@ private:
     // Number of electronic steps per ionic step
     short max_electronic_steps_loose_;
     short max_electronic_steps_tight_;
+
+    // adapt cost of SCF iterations to convergence rate
+    short adaptive_scf_;
     //
     // dielectric flag for Poisson solver
     // 0 = no diel. parameter with MG solver for Poisson
@@ -182,6 +196,18 @@ private:
 
     short dm_algo_;
 
+    // ScaLapack eigensolver used in diagonalization of projected matrices
+    short dist_eigensolver_;
+
+    // number of unoccupied eigenpairs computed in addition to occupied
+    // ones when computing a partial spectrum
+    short nb_extra_eigenpairs_;
+
+    // XL-BOMD: order K of dissipation scheme, and max. number of SCF
+    // iterations per MD step
+    short xlbomd_dissipation_order_;
+    short xlbomd_scf_steps_;
+
     // flag to decide if condition number of Gram matrix
     // should be computed during quench (value 2) or
     // only at the end of quench (value 1)
@@ -239,6 +265,7 @@ public:
     bool globalColoring() const { return (coloring_algo_ / 10 == 0); }
 
     bool RLFColoring() const { return (coloring_algo_ % 10 == 0); }
+    bool JPColoring() const { return (coloring_algo_ % 10 == 2); }
     bool use_old_dm() const { return (dm_use_old_ == 1); }
 
     std::string getFullFilename(const std::string& filename)
@@ -262,6 +289,8 @@ public:
 
     bool blockPrecond() const { return (precond_type_ / 10 == 1); }
 
+    bool adaptiveSCF() const { return (adaptive_scf_ > 0); }
+
     void convergeTightly()
     {
         max_electronic_steps = max_electronic_steps_tight_;
@@ -339,6 +368,16 @@ public:
         return pair_mlwf_distance_threshold_;
     }
 
+    float getAndersonMemoryBudget() const { return anderson_memory_budget_; }
+
+    short nbExtraEigenpairs() const { return nb_extra_eigenpairs_; }
+
+    short getXLBOMDdissipationOrder() const
+    {
+        return xlbomd_dissipation_order_;
+    }
+    short getXLBOMDscfSteps() const { return xlbomd_scf_steps_; }
+
     void global_exit(int i);
 
     bool Mehrstellen() const { return (lap_type == 0 || lap_type == 10); }
@@ -376,6 +415,10 @@ public:
     // mesh
     unsigned ngpts_[3];
 
+    // number of mesh points owned by each MPI task in each direction
+    // (empty for a uniform decomposition)
+    std::vector<unsigned> mesh_partition_[3];
+
     short wf_dyn; // quench method
     short wf_m; // number of wf to keep in memory
 
@@ -542,6 +585,11 @@ public:
     short restart_file_type;
     short out_restart_file_type;
     short override_restart;
+    // write localized orbitals only over bounding box of their support
+    // on each task (distributed restart files only)
+    short out_restart_sparse;
+    // deflate compression level for sparse orbitals datasets (0 = none)
+    short out_restart_compression;
 
     short verbose;
 
@@ -549,9 +597,21 @@ public:
     float load_balancing_damping_tol;
     short load_balancing_max_iterations;
     short load_balancing_modulo;
+    // cost of each function: 0 = 1 per function, 1 = cost model,
+    // 2 = measured timings
+    short load_balancing_cost_model;
+    // rebalance only when imbalance (max/avg-1) exceeds threshold
+    float load_balancing_imbalance_threshold;
     short write_clusters;
     std::string load_balancing_output_file;
 
+    // ensemble of images: 0 = independent relaxations, 1 = NEB
+    short images_method;
+    // use climbing image for highest energy NEB image
+    short images_climbing;
+    // spring constant between NEB images [Ha/bohr^2]
+    float images_spring_constant;
+
     float reducedCutRadius() const { return 0.5 * cut_radius; }
     std::vector<Species>& getSpecies() { return sp_; }
     void setSpecies(Potentials& pot);
@@ -625,6 +685,8 @@ public:
                 return WFExtrapolationType::Order2;
             case 2:
                 return WFExtrapolationType::Order3;
+            case 3:
+                return WFExtrapolationType::XLBOMD;
             default:
                 return WFExtrapolationType::UNDEFINED;
         }
@@ -668,10 +730,8 @@ public:
         {
             case 0:
                 return DMEigensolverType::Eigensolver;
-#ifdef __MGMOL_CHEBYSHEV__
             case 1:
                 return DMEigensolverType::Chebyshev;
-#endif
             case 2:
                 return DMEigensolverType::SP2;
             default:
@@ -679,6 +739,21 @@ public:
         }
     }
 
+    DistEigensolverType DistEigensolver() const
+    {
+        switch (dist_eigensolver_)
+        {
+            case 0:
+                return DistEigensolverType::Syev;
+            case 1:
+                return DistEigensolverType::Syevd;
+            case 2:
+                return DistEigensolverType::Syevr;
+            default:
+                return DistEigensolverType::UNDEFINED;
+        }
+    }
+
     OrbitalsType getOrbitalsType()
     {
         switch(orbital_type_)
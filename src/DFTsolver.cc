@@ -20,6 +20,7 @@
 #include "Potentials.h"
 #include "ProjectedMatricesInterface.h"
 #include "Rho.h"
+#include "SCFController.h"
 
 template <class T>
 DFTsolver<T>::DFTsolver(Hamiltonian<T>* hamiltonian,
@@ -284,6 +285,8 @@ int DFTsolver<T>::solve(T& orbitals, T& work_orbitals,
         electrostat_->resetSolution();
     }
 
+    SCFController scf_control(ct.adaptiveSCF(), ct.conv_tol);
+
     // main electronic structure outer loop
     for (short step = 0; step <= max_steps; step++)
     {
@@ -298,16 +301,31 @@ int DFTsolver<T>::solve(T& orbitals, T& work_orbitals,
         proj_matrices_->resetDotProductMatrices();
 
         // Generate new density
+        scf_control.startPhase();
         rho_->update(orbitals);
+        scf_control.stopPhase(SCFController::Density);
 
         // Update potential
-        if (testUpdatePot()) mgmol_strategy_->update_pot(ions);
+        if (testUpdatePot())
+        {
+            scf_control.startPhase();
+            // fewer sweeps than current setting (ct.vh_init, or
+            // ct.vh_its with PB solver), restored after solve
+            const short max_sweeps = electrostat_->maxSweeps();
+            const short nsweeps = scf_control.hartreeSweeps(max_sweeps);
+            if (nsweeps != max_sweeps) electrostat_->setup(nsweeps);
+            mgmol_strategy_->update_pot(ions);
+            if (nsweeps != max_sweeps) electrostat_->setup(max_sweeps);
+            scf_control.stopPhase(SCFController::Hartree);
+        }
 
+        scf_control.startPhase();
         mgmol_strategy_->updateHmatrix(orbitals, ions);
 
         // theta = invB * Hij
         // (to be used for energy and gradient computation)
         proj_matrices_->updateThetaAndHB();
+        scf_control.stopPhase(SCFController::Hamiltonian);
 
         if (step == max_steps) break;
 
@@ -322,6 +340,9 @@ int DFTsolver<T>::solve(T& orbitals, T& work_orbitals,
         // test for convergence
         retval = checkConvergenceEnergy(step, max_steps);
 
+        // energy variation not reliable if DM was not updated
+        if (retval == 0 && !scf_control.dmUpToDate()) retval = 1;
+
         // terminate if convergence problem
         if (retval < 0) return retval;
 
@@ -346,9 +367,11 @@ int DFTsolver<T>::solve(T& orbitals, T& work_orbitals,
 
         // one step wave functions update
         // S and S^-1 should be up to date after that call
+        scf_control.startPhase();
         const double restol = ct.checkResidual() ? ct.conv_tol : -1.;
         retval = orbitals_stepper_->update(orbitals, ions, ct.precond_factor,
             orthof, work_orbitals, accelerate_, print_res, restol);
+        scf_control.stopPhase(SCFController::OrbitalsUpdate);
 
         // rebuild dm with new overlap matrix
         dm_strategy_->dressDM();
@@ -379,12 +402,21 @@ int DFTsolver<T>::solve(T& orbitals, T& work_orbitals,
                     << "Condition Number of S: " << condS << endl;
         }
 
-        // updated Hij needed to compute new DM
-        if (dm_strategy_->needH())
-            mgmol_strategy_->updateHmatrix(orbitals, ions);
-
         // compute new density matrix
-        dm_strategy_->update();
+        if (scf_control.updateDM())
+        {
+            scf_control.startPhase();
+
+            // updated Hij needed to compute new DM
+            if (dm_strategy_->needH())
+                mgmol_strategy_->updateHmatrix(orbitals, ions);
+
+            dm_strategy_->update();
+
+            scf_control.stopPhase(SCFController::DMUpdate);
+        }
+
+        scf_control.endIteration(testUpdatePot() ? de_ : deig_);
 
         incInnerIt();
 
@@ -392,6 +424,9 @@ int DFTsolver<T>::solve(T& orbitals, T& work_orbitals,
 
     if (iprint && !ct.short_sighted) mgmol_strategy_->printEigAndOcc();
 
+    if (scf_control.active() && onpe0 && ct.verbose > 0)
+        scf_control.printCosts(os_);
+
 #ifdef HAVE_ARPACK
     if (ct.precond_factor_computed)
     {
@@ -48,6 +48,8 @@ public:
 
     int getOrbitalsIndex() const { return orbitals_index_; }
 
+    double getOrbitalOccupation() const { return orbital_occupation_; }
+
     bool occupationsUptodate() const { return occ_uptodate_; }
     bool fromUniformOccupations() const { return uniform_occ_; }
     DISTMATDTYPE getVal(const int i) const
@@ -2016,6 +2016,129 @@ void DistMatrix<float>::matgather(float* const a, const int lda) const
 #endif
     matgather_tm_.stop();
 }
+template <class T>
+template <typename T2>
+void DistMatrix<T>::multiplyFromLeft(const int m, const double alpha,
+    const T2* const a, const int lda, const double beta, T2* const c,
+    const int ldc) const
+{
+    multiplyFromLeft_tm_.start();
+
+    assert(lda >= m);
+    assert(ldc >= m);
+
+#ifdef SCALAPACK
+    const MPI_Datatype mpitype = (sizeof(T) == sizeof(double)) ? MPI_DOUBLE
+                                                                : MPI_FLOAT;
+
+    int npes;
+    MPI_Comm_size(comm_global_, &npes);
+
+    // position of each PE in process grid (-1 for inactive PEs)
+    int mypos[2] = { active_ ? myrow_ : -1, active_ ? mycol_ : -1 };
+    std::vector<int> pos(2 * npes);
+    MPI_Allgather(mypos, 2, MPI_INT, pos.data(), 2, MPI_INT, comm_global_);
+
+    // number of local columns on each process column
+    int izero = 0;
+    std::vector<int> ncols(npcol_);
+    for (int pc = 0; pc < npcol_; pc++)
+        ncols[pc] = numroc(&n_, &nb_, &pc, &izero, &npcol_);
+
+    const int nbrows = (m_ + mb_ - 1) / mb_;
+
+    // double buffering to overlap communications with computations
+    std::vector<T> sendbuf[2];
+    std::vector<T> recvbuf[2];
+    std::vector<int> counts[2];
+    std::vector<int> displs[2];
+    MPI_Request request[2];
+    for (short i = 0; i < 2; i++)
+    {
+        sendbuf[i].resize(mb_ * nloc_);
+        recvbuf[i].resize(mb_ * n_);
+        counts[i].resize(npes);
+        displs[i].resize(npes);
+    }
+
+    // block row ib, unpacked in global column order
+    std::vector<T> panel(mb_ * n_);
+
+    // at step ib, start gathering block row ib on all PEs
+    // while computing contribution of block row ib-1
+    for (int ib = 0; ib <= nbrows; ib++)
+    {
+        if (ib < nbrows)
+        {
+            const short ibuf = ib % 2;
+            const int pr     = ib % nprow_;
+            const int nrows  = std::min(mb_, m_ - ib * mb_);
+
+            int displ = 0;
+            for (int p = 0; p < npes; p++)
+            {
+                const int pc    = pos[2 * p + 1];
+                counts[ibuf][p] = (pos[2 * p] == pr) ? nrows * ncols[pc] : 0;
+                displs[ibuf][p] = displ;
+                displ += counts[ibuf][p];
+            }
+
+            int sendcount = 0;
+            if (active_ && myrow_ == pr)
+            {
+                const int x0 = (ib / nprow_) * mb_;
+                T* const buf = sendbuf[ibuf].data();
+                for (int y = 0; y < nloc_; y++)
+                    for (int x = 0; x < nrows; x++)
+                        buf[y * nrows + x] = val_[y * lld_ + x0 + x];
+                sendcount = nrows * nloc_;
+            }
+
+            MPI_Iallgatherv(sendbuf[ibuf].data(), sendcount, mpitype,
+                recvbuf[ibuf].data(), counts[ibuf].data(),
+                displs[ibuf].data(), mpitype, comm_global_, &request[ibuf]);
+        }
+
+        if (ib > 0)
+        {
+            const int jb     = ib - 1;
+            const short ibuf = jb % 2;
+            const int nrows  = std::min(mb_, m_ - jb * mb_);
+
+            MPI_Wait(&request[ibuf], MPI_STATUS_IGNORE);
+
+            // unpack contributions of each process column
+            for (int p = 0; p < npes; p++)
+            {
+                if (counts[ibuf][p] == 0) continue;
+
+                const int pc       = pos[2 * p + 1];
+                const T* const buf = recvbuf[ibuf].data() + displs[ibuf][p];
+                for (int y = 0; y < ncols[pc]; y++)
+                {
+                    const int j = ((y / nb_) * npcol_ + pc) * nb_ + y % nb_;
+                    memcpy(panel.data() + j * nrows, buf + y * nrows,
+                        nrows * sizeof(T));
+                }
+            }
+
+            // c <- alpha * a(:,rows of block jb) * panel + beta * c
+            // (beta used for first block only)
+            const double cbeta = (jb == 0) ? beta : 1.;
+            MPgemm('n', 'n', m, n_, nrows, alpha, a + jb * mb_ * lda, lda,
+                panel.data(), nrows, cbeta, c, ldc);
+        }
+    }
+    if (nbrows == 0) MPscal(ldc * n_, beta, c);
+
+#else
+    MPgemm('n', 'n', m, n_, m_, alpha, a, lda, val_.data(), lld_, beta, c,
+        ldc);
+#endif
+
+    multiplyFromLeft_tm_.stop();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor for a diagonal distributed matrix
 // from the diagonal elements
@@ -2219,6 +2342,8 @@ template <>
 void DistMatrix<double>::syev(
     char jobz, char uplo, std::vector<double>& w, DistMatrix<double>& z)
 {
+    syev_tm_.start();
+
     int info;
     if (active_)
     {
@@ -2255,12 +2380,15 @@ void DistMatrix<double>::syev(
 #ifdef SCALAPACK
     MPI_Bcast(&w[0], m_, MPI_DOUBLE, 0, comm_global_);
 #endif
+    syev_tm_.stop();
 }
 
 template <>
 void DistMatrix<float>::syev(
     char jobz, char uplo, std::vector<float>& w, DistMatrix<float>& z)
 {
+    syev_tm_.start();
+
     int info;
     if (active_)
     {
@@ -2297,6 +2425,238 @@ void DistMatrix<float>::syev(
 #ifdef SCALAPACK
     MPI_Bcast(&w[0], m_, MPI_FLOAT, 0, comm_global_);
 #endif
+    syev_tm_.stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <>
+void DistMatrix<double>::syevd(
+    char uplo, std::vector<double>& w, DistMatrix<double>& z)
+{
+    syevd_tm_.start();
+
+    if (active_)
+    {
+        assert(m_ == n_);
+
+#ifdef SCALAPACK
+        int info;
+        int ione  = 1;
+        char jobz = 'v';
+
+        // workspace query
+        int lwork    = -1;
+        int liwork   = -1;
+        double wsize = 0.;
+        int iwsize   = 0;
+        pdsyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, &wsize, &lwork, &iwsize, &liwork,
+            &info);
+
+        lwork  = (int)wsize;
+        liwork = std::max(iwsize, 1);
+        std::vector<double> work(lwork);
+        std::vector<int> iwork(liwork);
+        pdsyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, &work[0], &lwork, &iwork[0],
+            &liwork, &info);
+        if (info != 0)
+        {
+            std::cerr << " DistMatrix::syevd, info=" << info << std::endl;
+            MPI_Abort(comm_global_, 2);
+        }
+#else
+        syev('v', uplo, w, z);
+#endif
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], m_, MPI_DOUBLE, 0, comm_global_);
+#endif
+    syevd_tm_.stop();
+}
+
+template <>
+void DistMatrix<double>::syevr(char uplo, const int il, const int iu,
+    std::vector<double>& w, DistMatrix<double>& z)
+{
+    assert(il >= 0);
+    assert(il <= iu);
+    assert(iu < m_);
+
+    syevr_tm_.start();
+
+    const int nev = iu - il + 1;
+    if (active_)
+    {
+        assert(m_ == n_);
+
+#ifdef SCALAPACK
+        int info;
+        int ione   = 1;
+        char jobz  = 'v';
+        char range = 'i';
+        // C to fortran
+        int ilf    = il + 1;
+        int iuf    = iu + 1;
+        double vl  = 0.;
+        double vu  = 0.;
+        int nfound = 0;
+        int nz     = 0;
+
+        // workspace query
+        int lwork    = -1;
+        int liwork   = -1;
+        double wsize = 0.;
+        int iwsize   = 0;
+        pdsyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_,
+            &vl, &vu, &ilf, &iuf, &nfound, &nz, &w[0], &z.val_[0], &ione,
+            &ione, z.desc_, &wsize, &lwork, &iwsize, &liwork, &info);
+
+        lwork  = (int)wsize;
+        liwork = std::max(iwsize, 1);
+        std::vector<double> work(lwork);
+        std::vector<int> iwork(liwork);
+        pdsyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_,
+            &vl, &vu, &ilf, &iuf, &nfound, &nz, &w[0], &z.val_[0], &ione,
+            &ione, z.desc_, &work[0], &lwork, &iwork[0], &liwork, &info);
+        if (info != 0 || nfound != nev)
+        {
+            std::cerr << " DistMatrix::syevr, info=" << info
+                      << ", number of eigenvalues found=" << nfound
+                      << std::endl;
+            MPI_Abort(comm_global_, 2);
+        }
+#else
+        // compute full spectrum and keep eigenpairs il to iu
+        syev('v', uplo, w, z);
+        for (int i = 0; i < nev; i++)
+            w[i] = w[il + i];
+        if (il > 0)
+            memmove(&z.val_[0], &z.val_[il * z.mloc_],
+                nev * z.mloc_ * sizeof(double));
+#endif
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], nev, MPI_DOUBLE, 0, comm_global_);
+#endif
+    syevr_tm_.stop();
+}
+
+template <>
+void DistMatrix<float>::syevd(
+    char uplo, std::vector<float>& w, DistMatrix<float>& z)
+{
+    syevd_tm_.start();
+
+    if (active_)
+    {
+        assert(m_ == n_);
+
+#ifdef SCALAPACK
+        int info;
+        int ione  = 1;
+        char jobz = 'v';
+
+        // workspace query
+        int lwork   = -1;
+        int liwork  = -1;
+        float wsize = 0.;
+        int iwsize  = 0;
+        pssyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, &wsize, &lwork, &iwsize, &liwork,
+            &info);
+
+        lwork  = (int)wsize;
+        liwork = std::max(iwsize, 1);
+        std::vector<float> work(lwork);
+        std::vector<int> iwork(liwork);
+        pssyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, &work[0], &lwork, &iwork[0],
+            &liwork, &info);
+        if (info != 0)
+        {
+            std::cerr << " DistMatrix::syevd, info=" << info << std::endl;
+            MPI_Abort(comm_global_, 2);
+        }
+#else
+        syev('v', uplo, w, z);
+#endif
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], m_, MPI_FLOAT, 0, comm_global_);
+#endif
+    syevd_tm_.stop();
+}
+
+template <>
+void DistMatrix<float>::syevr(char uplo, const int il, const int iu,
+    std::vector<float>& w, DistMatrix<float>& z)
+{
+    assert(il >= 0);
+    assert(il <= iu);
+    assert(iu < m_);
+
+    syevr_tm_.start();
+
+    const int nev = iu - il + 1;
+    if (active_)
+    {
+        assert(m_ == n_);
+
+#ifdef SCALAPACK
+        int info;
+        int ione   = 1;
+        char jobz  = 'v';
+        char range = 'i';
+        // C to fortran
+        int ilf    = il + 1;
+        int iuf    = iu + 1;
+        float vl   = 0.;
+        float vu   = 0.;
+        int nfound = 0;
+        int nz     = 0;
+
+        // workspace query
+        int lwork   = -1;
+        int liwork  = -1;
+        float wsize = 0.;
+        int iwsize  = 0;
+        pssyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_,
+            &vl, &vu, &ilf, &iuf, &nfound, &nz, &w[0], &z.val_[0], &ione,
+            &ione, z.desc_, &wsize, &lwork, &iwsize, &liwork, &info);
+
+        lwork  = (int)wsize;
+        liwork = std::max(iwsize, 1);
+        std::vector<float> work(lwork);
+        std::vector<int> iwork(liwork);
+        pssyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_,
+            &vl, &vu, &ilf, &iuf, &nfound, &nz, &w[0], &z.val_[0], &ione,
+            &ione, z.desc_, &work[0], &lwork, &iwork[0], &liwork, &info);
+        if (info != 0 || nfound != nev)
+        {
+            std::cerr << " DistMatrix::syevr, info=" << info
+                      << ", number of eigenvalues found=" << nfound
+                      << std::endl;
+            MPI_Abort(comm_global_, 2);
+        }
+#else
+        // compute full spectrum and keep eigenpairs il to iu
+        syev('v', uplo, w, z);
+        for (int i = 0; i < nev; i++)
+            w[i] = w[il + i];
+        if (il > 0)
+            memmove(&z.val_[0], &z.val_[il * z.mloc_],
+                nev * z.mloc_ * sizeof(float));
+#endif
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], nev, MPI_FLOAT, 0, comm_global_);
+#endif
+    syevr_tm_.stop();
 }
 ////////////////////////////////////////////////////////////////////////////////
 template <>
@@ -2744,4 +3104,17 @@ template std::ostream& operator<<(std::ostream& os, const DistMatrix<float>&);
 template class DistMatrix<double>;
 template class DistMatrix<float>;
 
+template void DistMatrix<double>::multiplyFromLeft(const int m,
+    const double alpha, const double* const a, const int lda, const double beta,
+    double* const c, const int ldc) const;
+template void DistMatrix<double>::multiplyFromLeft(const int m,
+    const double alpha, const float* const a, const int lda, const double beta,
+    float* const c, const int ldc) const;
+template void DistMatrix<float>::multiplyFromLeft(const int m,
+    const double alpha, const double* const a, const int lda, const double beta,
+    double* const c, const int ldc) const;
+template void DistMatrix<float>::multiplyFromLeft(const int m,
+    const double alpha, const float* const a, const int lda, const double beta,
+    float* const c, const int ldc) const;
+
 } // namespace
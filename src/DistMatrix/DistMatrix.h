@@ -14,6 +14,7 @@
 #include "Timer.h"
 #include "mputils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <complex>
 #include <string.h>
@@ -43,6 +44,10 @@ private:
     static Timer potri_tm_;
     static Timer potrf_tm_;
     static Timer trtri_tm_;
+    static Timer multiplyFromLeft_tm_;
+    static Timer syev_tm_;
+    static Timer syevd_tm_;
+    static Timer syevr_tm_;
 
     static int distmatrix_def_block_size_;
     static BlacsContext* default_bc_;
@@ -92,6 +97,10 @@ public:
         potri_tm_.print(os);
         trtri_tm_.print(os);
         potrf_tm_.print(os);
+        multiplyFromLeft_tm_.print(os);
+        syev_tm_.print(os);
+        syevd_tm_.print(os);
+        syevr_tm_.print(os);
     }
 
     int nprow() const { return nprow_; }
@@ -123,6 +132,23 @@ public:
         val_[ib * mb_ + x + (jb * nb_ + y) * mloc_] += val;
     }
 
+    // input: global block indexes (ibg,jbg) of a block owned by this PE,
+    // and values of block stored with leading dimension mb_
+    void addBlock(const int ibg, const int jbg, const T* const blk)
+    {
+        assert(ibg % nprow_ == myrow_);
+        assert(jbg % npcol_ == mycol_);
+
+        const int nrows = std::min(mb_, m_ - ibg * mb_);
+        const int ncols = std::min(nb_, n_ - jbg * nb_);
+
+        T* const dst
+            = &val_[(ibg / nprow_) * mb_ + (jbg / npcol_) * nb_ * mloc_];
+        for (int y = 0; y < ncols; y++)
+            for (int x = 0; x < nrows; x++)
+                dst[x + y * mloc_] += blk[x + y * mb_];
+    }
+
     void setVal(const int i, const int j, const T val);
 
     int ictxt(void) const { return ictxt_; }
@@ -275,6 +301,15 @@ public:
     void identity(void);
     void matgather(T* const a, const int lda) const;
 
+    // c <- alpha * a * (*this) + beta * c,
+    // where a (m x m_) and c (m x n_) are local matrices on each PE.
+    // Block rows of this matrix are broadcast to all the PEs one after
+    // the other, overlapping communications with the local products,
+    // so that the whole matrix is never replicated.
+    template <typename T2>
+    void multiplyFromLeft(const int m, const double alpha, const T2* const a,
+        const int lda, const double beta, T2* const c, const int ldc) const;
+
     void resize(const int m, const int n, const int mb, const int nb);
     void init(const T* const a, const int lda);
     void initTest();
@@ -345,6 +380,13 @@ public:
     double pocon(char, T);
     void sygst(int, char, const DistMatrix<T>&);
     void syev(char, char, std::vector<T>&, DistMatrix<T>&);
+    // divide-and-conquer algorithm (eigenvectors always computed)
+    void syevd(char, std::vector<T>&, DistMatrix<T>&);
+    // MRRR algorithm, for eigenpairs il to iu (starting at 0) only.
+    // Eigenvalues returned in w[0:iu-il], eigenvectors in columns
+    // 0 to iu-il of z
+    void syevr(char, const int il, const int iu, std::vector<T>&,
+        DistMatrix<T>&);
     void sygv(char, char, const char, DistMatrix<T>&, std::vector<T>&,
         DistMatrix<T>&);
     void gesvd(char jobu, char jobvt, std::vector<T>& s, DistMatrix<T>& u,
@@ -446,6 +488,14 @@ template <class T>
 Timer DistMatrix<T>::potrf_tm_("DistMatrix::potrf");
 template <class T>
 Timer DistMatrix<T>::trtri_tm_("DistMatrix::trtri");
+template <class T>
+Timer DistMatrix<T>::multiplyFromLeft_tm_("DistMatrix::multiplyFromLeft");
+template <class T>
+Timer DistMatrix<T>::syev_tm_("DistMatrix::syev");
+template <class T>
+Timer DistMatrix<T>::syevd_tm_("DistMatrix::syevd");
+template <class T>
+Timer DistMatrix<T>::syevr_tm_("DistMatrix::syevr");
 
 } // namespace
 
@@ -27,8 +27,6 @@ private:
 
     RemoteTasksDistMatrix<T>* rtasks_distmatrix_;
 
-    int target_nb_tasks_per_partition_;
-
     DistMatrixWithSparseComponent& operator=(
         const DistMatrixWithSparseComponent& mat)
     {
@@ -38,28 +36,22 @@ private:
 public:
     DistMatrixWithSparseComponent(const std::string& name,
         const BlacsContext& bc, const int m, const int n, MPI_Comm comm,
-        RemoteTasksDistMatrix<T>* rtasks_distmatrix = NULL,
-        const int target_nb_tasks_per_partition     = 0)
+        RemoteTasksDistMatrix<T>* rtasks_distmatrix = NULL)
         : DistMatrix<T>(name, bc, m, n),
           comm_(comm),
-          rtasks_distmatrix_(rtasks_distmatrix),
-          target_nb_tasks_per_partition_(target_nb_tasks_per_partition)
+          rtasks_distmatrix_(rtasks_distmatrix)
     {
-        sparse_ = new SparseDistMatrix<T>(
-            comm, *this, rtasks_distmatrix, target_nb_tasks_per_partition);
+        sparse_ = new SparseDistMatrix<T>(comm, *this, rtasks_distmatrix);
     }
 
     DistMatrixWithSparseComponent(const std::string& name, const int m,
         const int n, MPI_Comm comm,
-        RemoteTasksDistMatrix<T>* rtasks_distmatrix = NULL,
-        const int target_nb_tasks_per_partition     = 0)
+        RemoteTasksDistMatrix<T>* rtasks_distmatrix = NULL)
         : DistMatrix<T>(name, m, n),
           comm_(comm),
-          rtasks_distmatrix_(rtasks_distmatrix),
-          target_nb_tasks_per_partition_(target_nb_tasks_per_partition)
+          rtasks_distmatrix_(rtasks_distmatrix)
     {
-        sparse_ = new SparseDistMatrix<T>(
-            comm, *this, rtasks_distmatrix, target_nb_tasks_per_partition);
+        sparse_ = new SparseDistMatrix<T>(comm, *this, rtasks_distmatrix);
     }
 
     DistMatrixWithSparseComponent(
@@ -69,8 +61,6 @@ public:
         sparse_ = new SparseDistMatrix<T>(comm, *this);
 
         rtasks_distmatrix_ = sparse_->remoteTasksDistMatrix();
-        target_nb_tasks_per_partition_
-            = SparseDistMatrix<T>::numTasksPerPartitioning();
     }
 
     ~DistMatrixWithSparseComponent() { delete sparse_; }
@@ -47,15 +47,11 @@ const unsigned short reserve_size = 8;
 
 template <class T>
 SparseDistMatrix<T>::SparseDistMatrix(MPI_Comm comm, DistMatrix<T>& mat,
-    RemoteTasksDistMatrix<T>* rtasks_distmatrix,
-    const int target_nb_tasks_per_partition)
+    RemoteTasksDistMatrix<T>* rtasks_distmatrix)
     : comm_global_(comm), rtasks_distmatrix_(rtasks_distmatrix), mat_(mat)
 {
     assert(&mat_ != NULL);
 
-    ntasks_per_partition_ = -1;
-    npartitions_          = -1;
-
 #if USE_MPI
     MPI_Comm_rank(comm_global_, &mype_);
     MPI_Comm_size(comm_global_, &npes_);
@@ -70,7 +66,9 @@ SparseDistMatrix<T>::SparseDistMatrix(MPI_Comm comm, DistMatrix<T>& mat,
     ntasks_mat_ = nprow_ * npcol;
 
     index_and_val_.resize(ntasks_mat_);
-    map_val_.resize(ntasks_mat_);
+    tiles_index_.resize(ntasks_mat_);
+    tiles_val_.resize(ntasks_mat_);
+    tile_size_ = mat_.mb() * mat_.nb();
 
     if (rtasks_distmatrix_ == NULL)
     {
@@ -81,11 +79,6 @@ SparseDistMatrix<T>::SparseDistMatrix(MPI_Comm comm, DistMatrix<T>& mat,
     {
         own_rtasks_distmatrix_ = false;
     }
-
-    int target_nb_tasks = target_nb_tasks_per_partition;
-    if (target_nb_tasks <= 0) target_nb_tasks = npes_; // default
-
-    setPartitioning(target_nb_tasks);
 };
 
 template <class T>
@@ -94,9 +87,6 @@ SparseDistMatrix<T>::SparseDistMatrix(MPI_Comm comm, DistMatrix<T>& mat)
 {
     assert(&mat_ != NULL);
 
-    ntasks_per_partition_ = -1;
-    npartitions_          = -1;
-
 #if USE_MPI
     MPI_Comm_rank(comm_global_, &mype_);
     MPI_Comm_size(comm_global_, &npes_);
@@ -111,7 +101,9 @@ SparseDistMatrix<T>::SparseDistMatrix(MPI_Comm comm, DistMatrix<T>& mat)
     ntasks_mat_ = nprow_ * npcol;
 
     index_and_val_.resize(ntasks_mat_);
-    map_val_.resize(ntasks_mat_);
+    tiles_index_.resize(ntasks_mat_);
+    tiles_val_.resize(ntasks_mat_);
+    tile_size_ = mat_.mb() * mat_.nb();
 
     rtasks_distmatrix_ = *def_rtasks_DistMatrix_ptr_;
     if (rtasks_distmatrix_ == NULL)
@@ -123,11 +115,6 @@ SparseDistMatrix<T>::SparseDistMatrix(MPI_Comm comm, DistMatrix<T>& mat)
     {
         own_rtasks_distmatrix_ = false;
     }
-
-    int target_nb_tasks = sparse_distmatrix_nb_partitions_;
-    if (target_nb_tasks <= 0) target_nb_tasks = npes_; // default
-
-    setPartitioning(target_nb_tasks);
 };
 
 template <class T>
@@ -142,13 +129,10 @@ SparseDistMatrix<T>::SparseDistMatrix(const SparseDistMatrix<T>& spdistmat)
     own_rtasks_distmatrix_ = false;
     rtasks_distmatrix_     = spdistmat.rtasks_distmatrix_;
 
-    partition_comm_ = spdistmat.partition_comm_;
-
-    ntasks_per_partition_ = spdistmat.ntasks_per_partition_;
-    npartitions_          = spdistmat.npartitions_;
-
     index_and_val_ = spdistmat.index_and_val_;
-    map_val_       = spdistmat.map_val_;
+    tiles_index_   = spdistmat.tiles_index_;
+    tiles_val_     = spdistmat.tiles_val_;
+    tile_size_     = spdistmat.tile_size_;
 }
 
 template <class T>
@@ -161,32 +145,17 @@ SparseDistMatrix<T>::~SparseDistMatrix<T>()
     }
 }
 
-TEMP_DECL
-void SparseDistMatrix<double>::scal(const double alpha)
-{
-    int n = (int)map_val_.size();
-    for (int i = 0; i < n; i++)
-    {
-        map<int, double>& ref_map_val(map_val_[i]);
-        for (map<int, double>::iterator p = ref_map_val.begin();
-             p != ref_map_val.end(); p++)
-        {
-            (p->second) *= alpha;
-        }
-    }
-}
-
-TEMP_DECL
-void SparseDistMatrix<float>::scal(const double alpha)
+template <class T>
+void SparseDistMatrix<T>::scal(const double alpha)
 {
-    int n = (int)map_val_.size();
+    const int n = (int)tiles_val_.size();
     for (int i = 0; i < n; i++)
     {
-        map<int, float>& ref_map_val(map_val_[i]);
-        for (map<int, float>::iterator p = ref_map_val.begin();
-             p != ref_map_val.end(); p++)
+        vector<T>& ref_tiles_val(tiles_val_[i]);
+        for (typename vector<T>::iterator p = ref_tiles_val.begin();
+             p != ref_tiles_val.end(); p++)
         {
-            (p->second) *= alpha;
+            (*p) *= alpha;
         }
     }
 }
@@ -209,10 +178,13 @@ void SparseDistMatrix<T>::print(ostream& os) const
 template <class T>
 size_t SparseDistMatrix<T>::size() const
 {
+    // count non-zero values
     size_t size_data = 0;
-    const int n      = (int)map_val_.size();
+    const int n      = (int)tiles_val_.size();
     for (int i = 0; i < n; i++)
-        size_data += map_val_[i].size();
+        for (typename vector<T>::const_iterator p = tiles_val_[i].begin();
+             p != tiles_val_[i].end(); p++)
+            if (*p != 0.) size_data++;
 
     return size_data;
 }
@@ -253,440 +225,84 @@ void myMPI_AlltoallDouble(
 #endif
 
 template <class T>
-void SparseDistMatrix<T>::push_back(
-    const int index1, const int index2, const T val)
+void SparseDistMatrix<T>::addToTile(
+    const int pe, const int index1, const int index2, const T val)
 {
-    const int pr = mat_.pr(index1);
-    const int pc = mat_.pc(index2);
-    const int pe = pr + pc * nprow_; // destination PE
-    assert(pe >= 0);
-    assert(pe < (int)map_val_.size());
-    assert(!std::isnan(val));
+    const int mb  = mat_.mb();
+    const int nb  = mat_.nb();
+    const int key = ((index1 / mb) << SHIFT) + index2 / nb;
 
-    map_val_[pe][(index1 << SHIFT) + index2] += val;
-}
+    map<int, int>& ref_tiles_index(tiles_index_[pe]);
+    vector<T>& ref_tiles_val(tiles_val_[pe]);
 
-TEMP_DECL
-void SparseDistMatrix<double>::maptoarray()
-{
-    maptoarray_tm_.start();
-    // cout<<"SparseDistMatrix<double>::maptoarray()"<<endl;
-    const int imax = map_val_.size();
-    for (int pe = 0; pe < imax; pe++)
+    int offset;
+    map<int, int>::const_iterator it = ref_tiles_index.find(key);
+    if (it == ref_tiles_index.end())
     {
-        vector<double>& index_and_val_pe(index_and_val_[pe]);
-        index_and_val_pe.clear();
-        const map<int, double>& ref_map_val(map_val_[pe]);
-        if (ref_map_val.size() > 1) index_and_val_pe.reserve(reserve_size);
-        for (map<int, double>::const_iterator p = ref_map_val.begin();
-             p != ref_map_val.end(); p++)
-        {
-            assert(p->first >= 0);
-            index_and_val_pe.push_back((double)p->first);
-            index_and_val_pe.push_back(p->second);
-        }
+        // new block
+        offset = (int)ref_tiles_val.size();
+        ref_tiles_index.insert(pair<int, int>(key, offset));
+        ref_tiles_val.resize(offset + tile_size_, 0.);
     }
-    maptoarray_tm_.stop();
-}
-
-TEMP_DECL
-void SparseDistMatrix<float>::maptoarray()
-{
-    maptoarray_tm_.start();
-    // cout<<"SparseDistMatrix<float>::maptoarray()"<<endl;
-    const int imax = map_val_.size();
-    for (int pe = 0; pe < imax; pe++)
+    else
     {
-        vector<float>& index_and_val_pe(index_and_val_[pe]);
-        index_and_val_pe.clear();
-        const map<int, float>& ref_map_val(map_val_[pe]);
-        if (ref_map_val.size() > 1) index_and_val_pe.reserve(reserve_size);
-        for (map<int, float>::const_iterator p = ref_map_val.begin();
-             p != ref_map_val.end(); p++)
-        {
-            assert(p->first >= 0);
-            index_and_val_pe.push_back((float)p->first);
-            index_and_val_pe.push_back(p->second);
-        }
+        offset = it->second;
     }
-    maptoarray_tm_.stop();
-}
 
-template <class T>
-void SparseDistMatrix<T>::array2map()
-{
-    map_val_.clear();
-    map_val_.resize(ntasks_mat_);
-    for (int pe = 0; pe < ntasks_mat_; pe++)
-    {
-        const int size_index_and_val_pe   = index_and_val_[pe].size();
-        map<int, T>& ref_map_val_pe       = map_val_[pe];
-        const vector<T>& index_and_val_pe = index_and_val_[pe];
-        for (int i = 0; i < size_index_and_val_pe; i = i + 2)
-        {
-            ref_map_val_pe[(int)index_and_val_pe[i]] += index_and_val_pe[i + 1];
-        }
-    }
+    ref_tiles_val[offset + index1 % mb + (index2 % nb) * mb] += val;
 }
 
-TEMP_DECL
-void SparseDistMatrix<double>::consolidateArray()
+template <class T>
+void SparseDistMatrix<T>::push_back(
+    const int index1, const int index2, const T val)
 {
-    consolidateArray_tm_.start();
-
-#if USE_MPI
-    // if( mype_==0 )
-    //   cout<<"Consolidate,
-    //   consolidation_number="<<consolidation_number_<<endl;
-
-    maptoarray();
-
-    map_val_.clear(); // to save memory
-
-    unsigned short num_neighbors = consolidation_number_;
-    if (num_neighbors > ntasks_mat_) num_neighbors = ntasks_mat_;
-
-    const int npes_color = num_neighbors;
-
-    // special case
-    const unsigned short nremaining_tasks = (npes_ % num_neighbors);
-    if (nremaining_tasks)
-    {
-        if (mype_ >= (npes_ - nremaining_tasks))
-        {
-            num_neighbors = nremaining_tasks;
-            // cout<<"mype="<<mype_<<", num_neighbors="<<num_neighbors<<endl;
-        }
-    }
-
-    MPI_Comm sub_comm;
-    const int color = mype_ / npes_color;
-    const int key   = mype_ % npes_color;
-    MPI_Comm_split(comm_global_, color, key, &sub_comm);
-
-    int fraction_tasks = (ntasks_mat_ / num_neighbors);
-    if (fraction_tasks * num_neighbors < ntasks_mat_) fraction_tasks++;
-
-    {
-        const int npes_mat = num_neighbors * fraction_tasks;
-        assert(npes_mat > 0);
-        assert(npes_mat >= ntasks_mat_);
-
-        // first send size of arrays to be sent later
-        int* ndata2send = new int[npes_mat];
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            const int pe_init = dst * fraction_tasks;
-            const int pe_end  = min(pe_init + fraction_tasks, ntasks_mat_);
-            for (int pe = pe_init; pe < pe_end; pe++)
-                ndata2send[pe] = (int)index_and_val_[pe].size();
-        }
-        for (int i = ntasks_mat_; i < npes_mat; i++)
-            ndata2send[i] = 0;
-
-        int* ndata2recv = new int[npes_mat];
-        int rc = MPI_Alltoall(ndata2send, fraction_tasks, MPI_INT, ndata2recv,
-            fraction_tasks, MPI_INT, sub_comm);
-        assert(rc == MPI_SUCCESS);
-
-        int* sendcounts = new int[num_neighbors];
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            sendcounts[dst]   = 0;
-            const int pe_init = dst * fraction_tasks;
-            const int pe_end  = pe_init + fraction_tasks;
-            for (int pe = pe_init; pe < pe_end; pe++)
-            {
-                sendcounts[dst] += ndata2send[pe];
-            }
-        }
-        delete[] ndata2send;
-
-        int total_ndata2send = 0;
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            total_ndata2send += sendcounts[dst];
-        }
-
-        int* recvcounts = new int[num_neighbors];
-        for (int src = 0; src < num_neighbors; src++)
-        {
-            recvcounts[src] = 0;
-            const int iinit = src * fraction_tasks;
-            const int iend  = iinit + fraction_tasks;
-            for (int i = iinit; i < iend; i++)
-            {
-                recvcounts[src] += ndata2recv[i];
-            }
-        }
-        int total_ndata2recv = 0;
-        for (int src = 0; src < num_neighbors; src++)
-        {
-            total_ndata2recv += recvcounts[src];
-        }
-
-        int* rdispls = new int[num_neighbors];
-        rdispls[0]   = 0;
-        for (int i = 1; i < num_neighbors; i++)
-        {
-            rdispls[i] = rdispls[i - 1] + recvcounts[i - 1];
-            assert(rdispls[i] >= 0);
-        }
-
-        int* sdispls = new int[num_neighbors];
-        sdispls[0]   = 0;
-        for (int i = 1; i < num_neighbors; i++)
-        {
-            sdispls[i] = sdispls[i - 1] + sendcounts[i - 1];
-            assert(sdispls[i] >= 0);
-        }
-
-        // pack and erase data to send
-        double* send_buffer = new double[max(1, total_ndata2send)];
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            const int pe_init = dst * fraction_tasks;
-            const int pe_end  = min(pe_init + fraction_tasks, ntasks_mat_);
-            assert(sdispls[dst] <= total_ndata2send);
-            double* psend_buffer = send_buffer + sdispls[dst];
-            int offset           = 0;
-            for (int pe = pe_init; pe < pe_end; pe++)
-            {
-                size_t ndata = index_and_val_[pe].size();
-                memcpy(psend_buffer + offset, &index_and_val_[pe][0],
-                    sizeof(double) * ndata);
-                index_and_val_[pe].clear(); // remove data we send out
-                offset += ndata;
-            }
-            assert(offset == sendcounts[dst]);
-        }
-
-        double* recv_buffer = new double[max(total_ndata2recv, 1)];
-        recv_buffer[0]      = -1.;
-
-        rc = MPI_Alltoallv(send_buffer, sendcounts, sdispls, MPI_DOUBLE,
-            recv_buffer, recvcounts, rdispls, MPI_DOUBLE, sub_comm);
-        assert(rc == MPI_SUCCESS);
-
-        delete[] send_buffer;
-        delete[] sdispls;
-        delete[] sendcounts;
-
-        // unpack data just received
-        for (int src = 0; src < num_neighbors; src++)
-        {
-            const int src_init               = src * fraction_tasks;
-            const int src_end                = src_init + fraction_tasks;
-            const double* const precv_buffer = recv_buffer + rdispls[src];
-            int offset                       = 0;
-            for (int i = src_init; i < src_end; i++)
-            {
-                const int ndata = ndata2recv[i];
-                for (int j = 0; j < ndata; j++)
-                {
-                    const int index = key * fraction_tasks + i - src_init;
-                    // const int index=i;
-                    assert(index < index_and_val_.size());
-                    index_and_val_[index].push_back(precv_buffer[offset + j]);
-                }
-                offset += ndata;
-            }
-            if (offset != recvcounts[src])
-                cout << "src=" << src << ", offset=" << offset
-                     << ", recvcounts=" << recvcounts[src] << endl;
-            assert(offset == recvcounts[src]);
-        }
-
-        delete[] recv_buffer;
-        delete[] recvcounts;
-        delete[] ndata2recv;
-        delete[] rdispls;
+    const int pr = mat_.pr(index1);
+    const int pc = mat_.pc(index2);
+    const int pe = pr + pc * nprow_; // destination PE
+    assert(pe >= 0);
+    assert(pe < (int)tiles_index_.size());
+    assert(!std::isnan(val));
 
-        array2map(); // to sum up elements with same index
-    }
-    MPI_Comm_free(&sub_comm);
-#endif
-    consolidateArray_tm_.stop();
+    addToTile(pe, index1, index2, val);
 }
 
-TEMP_DECL
-void SparseDistMatrix<float>::consolidateArray()
+// convert blocks into list of (index,value) pairs of non-zero values
+template <class T>
+void SparseDistMatrix<T>::tiles2array()
 {
-    consolidateArray_tm_.start();
-
-#if USE_MPI
-    // if( mype_==0 )
-    //   cout<<"Consolidate,
-    //   consolidation_number="<<consolidation_number_<<endl;
-
-    maptoarray();
-
-    map_val_.clear(); // to save memory
-
-    unsigned short num_neighbors = consolidation_number_;
-    if (num_neighbors > ntasks_mat_) num_neighbors = ntasks_mat_;
-
-    const int npes_color = num_neighbors;
-
-    // special case
-    const unsigned short nremaining_tasks = (npes_ % num_neighbors);
-    if (nremaining_tasks)
-    {
-        if (mype_ >= (npes_ - nremaining_tasks))
-        {
-            num_neighbors = nremaining_tasks;
-            // cout<<"mype="<<mype_<<", num_neighbors="<<num_neighbors<<endl;
-        }
-    }
+    tiles2array_tm_.start();
 
-    MPI_Comm sub_comm;
-    const int color = mype_ / npes_color;
-    const int key   = mype_ % npes_color;
-    MPI_Comm_split(comm_global_, color, key, &sub_comm);
-
-    int fraction_tasks = (ntasks_mat_ / num_neighbors);
-    if (fraction_tasks * num_neighbors < ntasks_mat_) fraction_tasks++;
+    const int mb = mat_.mb();
+    const int nb = mat_.nb();
 
+    const int imax = tiles_index_.size();
+    for (int pe = 0; pe < imax; pe++)
     {
-        const int npes_mat = num_neighbors * fraction_tasks;
-        assert(npes_mat > 0);
-        assert(npes_mat >= ntasks_mat_);
-
-        // first send size of arrays to be sent later
-        int* ndata2send = new int[npes_mat];
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            const int pe_init = dst * fraction_tasks;
-            const int pe_end  = min(pe_init + fraction_tasks, ntasks_mat_);
-            for (int pe = pe_init; pe < pe_end; pe++)
-                ndata2send[pe] = (int)index_and_val_[pe].size();
-        }
-        for (int i = ntasks_mat_; i < npes_mat; i++)
-            ndata2send[i] = 0;
-
-        int* ndata2recv = new int[npes_mat];
-        int rc = MPI_Alltoall(ndata2send, fraction_tasks, MPI_INT, ndata2recv,
-            fraction_tasks, MPI_INT, sub_comm);
-        assert(rc == MPI_SUCCESS);
-
-        int* sendcounts = new int[num_neighbors];
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            sendcounts[dst]   = 0;
-            const int pe_init = dst * fraction_tasks;
-            const int pe_end  = pe_init + fraction_tasks;
-            for (int pe = pe_init; pe < pe_end; pe++)
-            {
-                sendcounts[dst] += ndata2send[pe];
-            }
-        }
-        delete[] ndata2send;
-
-        int total_ndata2send = 0;
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            total_ndata2send += sendcounts[dst];
-        }
-
-        int* recvcounts = new int[num_neighbors];
-        for (int src = 0; src < num_neighbors; src++)
-        {
-            recvcounts[src] = 0;
-            const int iinit = src * fraction_tasks;
-            const int iend  = iinit + fraction_tasks;
-            for (int i = iinit; i < iend; i++)
-            {
-                recvcounts[src] += ndata2recv[i];
-            }
-        }
-        int total_ndata2recv = 0;
-        for (int src = 0; src < num_neighbors; src++)
-        {
-            total_ndata2recv += recvcounts[src];
-        }
-
-        int* rdispls = new int[num_neighbors];
-        rdispls[0]   = 0;
-        for (int i = 1; i < num_neighbors; i++)
-        {
-            rdispls[i] = rdispls[i - 1] + recvcounts[i - 1];
-            assert(rdispls[i] >= 0);
-        }
-
-        int* sdispls = new int[num_neighbors];
-        sdispls[0]   = 0;
-        for (int i = 1; i < num_neighbors; i++)
-        {
-            sdispls[i] = sdispls[i - 1] + sendcounts[i - 1];
-            assert(sdispls[i] >= 0);
-        }
-
-        // pack and erase data to send
-        float* send_buffer = new float[max(1, total_ndata2send)];
-        for (int dst = 0; dst < num_neighbors; dst++)
-        {
-            const int pe_init = dst * fraction_tasks;
-            const int pe_end  = min(pe_init + fraction_tasks, ntasks_mat_);
-            assert(sdispls[dst] <= total_ndata2send);
-            float* psend_buffer = send_buffer + sdispls[dst];
-            int offset          = 0;
-            for (int pe = pe_init; pe < pe_end; pe++)
-            {
-                size_t ndata = index_and_val_[pe].size();
-                memcpy(psend_buffer + offset, &index_and_val_[pe][0],
-                    sizeof(float) * ndata);
-                index_and_val_[pe].clear(); // remove data we send out
-                offset += ndata;
-            }
-            assert(offset == sendcounts[dst]);
-        }
-
-        float* recv_buffer = new float[max(total_ndata2recv, 1)];
-        recv_buffer[0]     = -1.;
-
-        rc = MPI_Alltoallv(send_buffer, sendcounts, sdispls, MPI_FLOAT,
-            recv_buffer, recvcounts, rdispls, MPI_FLOAT, sub_comm);
-        assert(rc == MPI_SUCCESS);
-
-        delete[] send_buffer;
-        delete[] sdispls;
-        delete[] sendcounts;
-
-        // unpack data just received
-        for (int src = 0; src < num_neighbors; src++)
-        {
-            const int src_init              = src * fraction_tasks;
-            const int src_end               = src_init + fraction_tasks;
-            const float* const precv_buffer = recv_buffer + rdispls[src];
-            int offset                      = 0;
-            for (int i = src_init; i < src_end; i++)
-            {
-                const int ndata = ndata2recv[i];
-                for (int j = 0; j < ndata; j++)
+        vector<T>& index_and_val_pe(index_and_val_[pe]);
+        index_and_val_pe.clear();
+        const map<int, int>& ref_tiles_index(tiles_index_[pe]);
+        if (ref_tiles_index.size() > 0) index_and_val_pe.reserve(reserve_size);
+        for (map<int, int>::const_iterator p = ref_tiles_index.begin();
+             p != ref_tiles_index.end(); p++)
+        {
+            const int ib      = (p->first >> SHIFT);
+            const int jb      = p->first - (ib << SHIFT);
+            const T* const pv = &tiles_val_[pe][p->second];
+            for (int y = 0; y < nb; y++)
+                for (int x = 0; x < mb; x++)
                 {
-                    const int index = key * fraction_tasks + i - src_init;
-                    // const int index=i;
-                    assert(index < index_and_val_.size());
-                    index_and_val_[index].push_back(precv_buffer[offset + j]);
+                    const T val = pv[x + y * mb];
+                    if (val != 0.)
+                    {
+                        const int i = ib * mb + x;
+                        const int j = jb * nb + y;
+                        index_and_val_pe.push_back((T)((i << SHIFT) + j));
+                        index_and_val_pe.push_back(val);
+                    }
                 }
-                offset += ndata;
-            }
-            if (offset != recvcounts[src])
-                cout << "src=" << src << ", offset=" << offset
-                     << ", recvcounts=" << recvcounts[src] << endl;
-            assert(offset == recvcounts[src]);
         }
-
-        delete[] recv_buffer;
-        delete[] recvcounts;
-        delete[] ndata2recv;
-        delete[] rdispls;
-
-        array2map(); // to sum up elements with same index
     }
-    MPI_Comm_free(&sub_comm);
-#endif
-    consolidateArray_tm_.stop();
+    tiles2array_tm_.stop();
 }
 
 template <class T>
@@ -752,40 +368,201 @@ void SparseDistMatrix<T>::assign(const int size, const T* const val)
     assign_tm_.stop();
 }
 
+// max. number of communication schedules kept in cache
+const unsigned short max_nb_schedules = 4;
+
+// signature of global pattern of non-zero blocks, identical on all PEs
+template <class T>
+typename SparseDistMatrix<T>::PatternKey
+SparseDistMatrix<T>::computePatternKey() const
+{
+    // FNV-1a like hashing of local pattern, with two different seeds
+    unsigned long long h[2] = { 14695981039346656037ULL, 1099511628211ULL };
+    const unsigned long long prime = 1099511628211ULL;
+
+    const int geometry[6]
+        = { mat_.m(), mat_.n(), mat_.mb(), mat_.nb(), ntasks_mat_, npes_ };
+    for (int k = 0; k < 6; k++)
+    {
+        h[0] = (h[0] ^ (unsigned long long)geometry[k]) * prime;
+        h[1] = (h[1] ^ (unsigned long long)geometry[k]) * prime + 1ULL;
+    }
+    for (int pe = 0; pe < ntasks_mat_; pe++)
+    {
+        h[0] = (h[0] ^ (unsigned long long)(pe + 1)) * prime;
+        h[1] = (h[1] ^ (unsigned long long)(pe + 1)) * prime + 1ULL;
+        const map<int, int>& ref_tiles_index(tiles_index_[pe]);
+        for (map<int, int>::const_iterator p = ref_tiles_index.begin();
+             p != ref_tiles_index.end(); p++)
+        {
+            h[0] = (h[0] ^ (unsigned long long)p->first) * prime;
+            h[1] = (h[1] ^ (unsigned long long)p->first) * prime + 1ULL;
+        }
+    }
+    // make signature depend on which PE holds which pattern
+    h[0] = (h[0] ^ (unsigned long long)mype_) * prime;
+    h[1] = (h[1] ^ (unsigned long long)mype_) * prime + 1ULL;
+
+    unsigned long long key[2] = { h[0], h[1] };
+#if USE_MPI
+    MPI_Allreduce(
+        h, key, 2, MPI_UNSIGNED_LONG_LONG, MPI_BXOR, comm_global_);
+#endif
+    return PatternKey(key[0], key[1]);
+}
+
+// get schedule to send blocks to their ScaLapack owners,
+// from cache if pattern of non-zero blocks has already been seen
+template <class T>
+const typename SparseDistMatrix<T>::TilesSchedule&
+SparseDistMatrix<T>::getTilesSchedule()
+{
+    tilesSchedule_tm_.start();
+
+    const PatternKey key = computePatternKey();
+    for (typename vector<pair<PatternKey, shared_ptr<TilesSchedule>>>::
+             const_iterator it
+         = schedules_.begin();
+         it != schedules_.end(); it++)
+    {
+        if (it->first == key)
+        {
+            tilesSchedule_tm_.stop();
+            return *(it->second);
+        }
+    }
+
+    shared_ptr<TilesSchedule> schedule(new TilesSchedule());
+    schedule->sendcounts.resize(npes_, 0);
+    schedule->recvcounts.resize(npes_, 0);
+
+    vector<int> send_keys;
+    for (int dst = 0; dst < npes_; dst++)
+    {
+        if (rtasks_distmatrix_->isRemoteTaskActive(dst))
+        {
+            const map<int, int>& ref_tiles_index(
+                tiles_index_[rtasks_distmatrix_->getRemoteTask(dst)]);
+            schedule->sendcounts[dst] = (int)ref_tiles_index.size();
+            for (map<int, int>::const_iterator p = ref_tiles_index.begin();
+                 p != ref_tiles_index.end(); p++)
+                send_keys.push_back(p->first);
+        }
+    }
+
+#if USE_MPI
+    MPI_Alltoall(&schedule->sendcounts[0], 1, MPI_INT,
+        &schedule->recvcounts[0], 1, MPI_INT, comm_global_);
+
+    vector<int> sdispls(npes_, 0);
+    vector<int> rdispls(npes_, 0);
+    for (int i = 1; i < npes_; i++)
+    {
+        sdispls[i] = sdispls[i - 1] + schedule->sendcounts[i - 1];
+        rdispls[i] = rdispls[i - 1] + schedule->recvcounts[i - 1];
+    }
+    const int nrecv = rdispls[npes_ - 1] + schedule->recvcounts[npes_ - 1];
+    // extra element to avoid empty buffers
+    send_keys.push_back(-1);
+    schedule->recv_keys.resize(nrecv + 1);
+
+    MPI_Alltoallv(&send_keys[0], &schedule->sendcounts[0], &sdispls[0],
+        MPI_INT, &schedule->recv_keys[0], &schedule->recvcounts[0],
+        &rdispls[0], MPI_INT, comm_global_);
+    schedule->recv_keys.resize(nrecv);
+#else
+    schedule->recvcounts = schedule->sendcounts;
+    schedule->recv_keys  = send_keys;
+#endif
+
+    if (schedules_.size() >= max_nb_schedules)
+        schedules_.erase(schedules_.begin());
+    schedules_.push_back(
+        pair<PatternKey, shared_ptr<TilesSchedule>>(key, schedule));
+
+    tilesSchedule_tm_.stop();
+
+    return *schedule;
+}
+
+// send blocks to their ScaLapack owners and sum them up into mat_
 template <class T>
-void SparseDistMatrix<T>::setPartitioning(
-    const int target_nb_tasks_per_partition)
+void SparseDistMatrix<T>::sumTilesToDistMatrix()
 {
-    partition_comm_.reset(new MPI_DistMatrixCommunicator());
+    pSumToDistMatrix_tm_.start();
+
+    const TilesSchedule& schedule = getTilesSchedule();
+
+    mat_.clear();
+
+    pSumSendRecv_tm_.start();
+
 #if USE_MPI
-    int maxnpartitions = max(npes_ / target_nb_tasks_per_partition, 1);
+    // pack blocks in same order as their indexes in schedule
+    vector<int> sendcounts(npes_);
+    vector<int> recvcounts(npes_);
+    vector<int> sdispls(npes_, 0);
+    vector<int> rdispls(npes_, 0);
+    for (int i = 0; i < npes_; i++)
+    {
+        sendcounts[i] = schedule.sendcounts[i] * tile_size_;
+        recvcounts[i] = schedule.recvcounts[i] * tile_size_;
+        if (i > 0)
+        {
+            sdispls[i] = sdispls[i - 1] + sendcounts[i - 1];
+            rdispls[i] = rdispls[i - 1] + recvcounts[i - 1];
+        }
+    }
 
-    npartitions_ = maxnpartitions;
-    while (npes_ % npartitions_ != 0)
+    vector<T> send_buffer(
+        max(sdispls[npes_ - 1] + sendcounts[npes_ - 1], 1));
+    for (int dst = 0; dst < npes_; dst++)
     {
-        npartitions_--;
+        if (schedule.sendcounts[dst] == 0) continue;
+
+        const int pe = rtasks_distmatrix_->getRemoteTask(dst);
+        const map<int, int>& ref_tiles_index(tiles_index_[pe]);
+        T* psend_buffer = &send_buffer[sdispls[dst]];
+        for (map<int, int>::const_iterator p = ref_tiles_index.begin();
+             p != ref_tiles_index.end(); p++)
+        {
+            memcpy(psend_buffer, &tiles_val_[pe][p->second],
+                tile_size_ * sizeof(T));
+            psend_buffer += tile_size_;
+        }
     }
 
-    // if( mype_==0 )
-    //    cout<<"npes_="<<npes_
-    //        <<", npartitions_="<<npartitions_<<endl;
-    ntasks_per_partition_ = npes_ / npartitions_;
+    vector<T> recv_buffer(
+        max(rdispls[npes_ - 1] + recvcounts[npes_ - 1], 1));
+
+    MPI_Datatype mpi_type
+        = (sizeof(T) == sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT;
+    MPI_Alltoallv(&send_buffer[0], &sendcounts[0], &sdispls[0], mpi_type,
+        &recv_buffer[0], &recvcounts[0], &rdispls[0], mpi_type,
+        comm_global_);
 
-    const int color      = mype_ / ntasks_per_partition_;
-    const int first_task = ntasks_per_partition_ * color;
-    int key              = mype_ - first_task;
-    int rc = MPI_Comm_split(comm_global_, color, key, &partition_comm_->comm());
-    if (rc != MPI_SUCCESS)
+    // sum up received blocks into mat_
+    const int nrecv = (int)schedule.recv_keys.size();
+    for (int k = 0; k < nrecv; k++)
     {
-        cerr << "Error calling MPI_Comm_split:"
-             << " color=" << color << ", key=" << key << endl;
-        exit(0);
+        const int key = schedule.recv_keys[k];
+        const int ib  = (key >> SHIFT);
+        mat_.addBlock(ib, key - (ib << SHIFT), &recv_buffer[k * tile_size_]);
     }
 #else
-    partition_comm_->comm() = comm_global_;
-    npartitions_            = 1;
-    ntasks_per_partition_   = npes_;
+    const map<int, int>& ref_tiles_index(tiles_index_[0]);
+    for (map<int, int>::const_iterator p = ref_tiles_index.begin();
+         p != ref_tiles_index.end(); p++)
+    {
+        const int ib = (p->first >> SHIFT);
+        mat_.addBlock(
+            ib, p->first - (ib << SHIFT), &tiles_val_[0][p->second]);
+    }
 #endif
+
+    pSumSendRecv_tm_.stop();
+
+    pSumToDistMatrix_tm_.stop();
 }
 
 #if MPIALLTOALL
@@ -798,7 +575,7 @@ void SparseDistMatrix<double>::parallelSumToDistMatrix()
 #endif
     pSumToDistMatrix_tm_.start();
 
-    maptoarray();
+    tiles2array();
 
     int max_val_size   = 0;
     const int val_size = (int)index_and_val_.size();
@@ -863,7 +640,7 @@ void SparseDistMatrix<float>::parallelSumToDistMatrix()
 #endif
     pSumToDistMatrix_tm_.start();
 
-    maptoarray();
+    tiles2array();
 
     int max_val_size   = 0;
     const int val_size = (int)index_and_val_.size();
@@ -933,7 +710,7 @@ void SparseDistMatrix<double>::parallelSumToDistMatrix()
 #endif
     pSumToDistMatrix_tm_.start();
 
-    maptoarray();
+    tiles2array();
 
     int max_index_and_val_size = 0;
     const int index_and_val_size = (int)index_and_val_.size();
@@ -1028,7 +805,7 @@ void SparseDistMatrix<float>::parallelSumToDistMatrix()
 #endif
     pSumToDistMatrix_tm_.start();
 
-    maptoarray();
+    tiles2array();
 
     int max_index_and_val_size = 0;
     const int index_and_val_size = (int)index_and_val_.size();
@@ -1113,690 +890,20 @@ void SparseDistMatrix<float>::parallelSumToDistMatrix()
 
 #else // !ZOLTAN
 
-TEMP_DECL
-void SparseDistMatrix<double>::sendRecvData()
+template <class T>
+void SparseDistMatrix<T>::parallelSumToDistMatrix()
 {
-    pSumSendRecv_tm_.start();
-
-    mat_.clear();
-
 #if MEMMON
     if (mype_ == 0)
     {
-        cout << "sendRecvData" << endl;
+        cout << "parallelSumToDistMatrix" << endl;
         memmon_print_usage();
     }
 #endif
-    const bool recv = rtasks_distmatrix_->isMyTaskActive();
-
-    int max_val_size   = 0;
-    const int val_size = (int)index_and_val_.size();
-    for (int i = 0; i < val_size; i++)
-        max_val_size = max(max_val_size, (int)index_and_val_[i].size());
-
-    int newsize          = max_val_size;
-
-#if USE_MPI
-    int color            = mype_ / ntasks_per_partition_;
-    const int first_task = ntasks_per_partition_ * color;
-    if (ntasks_per_partition_ > 1)
-    {
-        assert(partition_comm_->comm() != MPI_COMM_NULL);
-        MPI_Allreduce(&max_val_size, &newsize, 1, MPI_INT, MPI_MAX,
-            partition_comm_->comm());
-    }
-    MPI_Request rr   = MPI_REQUEST_NULL;
-    MPI_Request sr1  = MPI_REQUEST_NULL;
-    MPI_Request sr2  = MPI_REQUEST_NULL;
-    MPI_Request* psr = (&sr1);
-
-    // int dest=first_task+(mype_+1)%ntasks_per_partition_;
-    int key       = mype_ - first_task;
-    int dest_key  = (key + 1) % ntasks_per_partition_;
-    int dest_task = first_task + dest_key;
-    int src_key   = key - 1;
-    if (src_key < 0) src_key += ntasks_per_partition_;
-
-    const size_t newsized = newsize * sizeof(double);
-
-    if (newsize == 0) return;
-    double* tmp_val = recv ? new double[4 * newsize] : new double[2 * newsize];
-
-    double* sbuf1_val = tmp_val;
-    double* sbuf2_val = tmp_val + newsize;
-
-    double* tbuf_val = NULL;
-    ;
-    double* rbuf_val = NULL;
-    if (recv)
-    {
-        rbuf_val = tmp_val + 2 * newsize;
-        tbuf_val = tmp_val + 3 * newsize;
-    }
-    double* sbuf_val = sbuf1_val;
-
-    if (ntasks_per_partition_ > 1)
-    {
-        assert(partition_comm_->comm() != MPI_COMM_NULL);
-        if (recv)
-        {
-            MPI_Irecv(rbuf_val, newsize, MPI_DOUBLE, src_key, 0,
-                partition_comm_->comm(), &rr);
-        }
-        if (rtasks_distmatrix_->isRemoteTaskActive(dest_task))
-        {
-            const int dst = rtasks_distmatrix_->getRemoteTask(dest_task);
-
-            size_t size_index_and_val = index_and_val_[dst].size();
-            assert(!(size_index_and_val % 2));
-            assert(size_index_and_val <= newsize);
-            if (size_index_and_val > 0)
-                memcpy(sbuf_val, &index_and_val_[dst][0],
-                    size_index_and_val * sizeof(double));
-            if (size_index_and_val < newsize)
-            {
-                sbuf_val[size_index_and_val] = -1.;
-            }
-            MPI_Isend(sbuf_val, newsize, MPI_DOUBLE, dest_key, 0,
-                partition_comm_->comm(), psr);
-        }
-    }
-#endif
-
-    // local data
-    if (recv)
-    {
-        const int mytask_index = rtasks_distmatrix_->getMyTaskIndex();
-        if (index_and_val_[mytask_index].size() > 0)
-            assign((int)index_and_val_[mytask_index].size(),
-                &index_and_val_[mytask_index][0]);
-    }
-
-#if USE_MPI
-    for (int p = 0; p < ntasks_per_partition_ - 1; p++)
-    {
-
-        int tag = p + 1;
-        // compute next destination/source
-        dest_key  = (key + p + 2) % ntasks_per_partition_;
-        dest_task = first_task + dest_key;
-        src_key--;
-        if (src_key < 0) src_key += ntasks_per_partition_;
-
-        // copy received data into temporary arrays
-        if (recv)
-        {
-            MPI_Wait(&rr, MPI_STATUS_IGNORE);
-            // copy data only if size relevant data>0
-            if (rbuf_val[0] > -0.5)
-                memcpy(tbuf_val, rbuf_val, newsized);
-            else
-            {
-                tbuf_val[0] = -1.;
-            }
-        }
-
-        // do another send/recv if not last PE
-        if (p < ntasks_per_partition_ - 2)
-        {
-            assert(dest_key < ntasks_per_partition_);
-            assert(dest_key >= 0);
-            assert(src_key < ntasks_per_partition_);
-            assert(src_key >= 0);
-
-            // post next receive for next iteration
-            if (recv)
-            {
-                // receive
-                // cout<<"PE: "<<mype_<<", receive data from PE
-                // "<<src_key<<endl;
-                assert(partition_comm_->comm() != MPI_COMM_NULL);
-                MPI_Irecv(rbuf_val, newsize, MPI_DOUBLE, src_key, tag,
-                    partition_comm_->comm(), &rr);
-            }
-
-            // send data
-            if (rtasks_distmatrix_->isRemoteTaskActive(dest_task))
-            {
-                // cout<<"PE: "<<mype_<<", send data to PE "<<dest<<endl;
-                const int dst = rtasks_distmatrix_->getRemoteTask(dest_task);
-
-                size_t size_index_and_val = index_and_val_[dst].size();
-                assert(!(size_index_and_val % 2));
-                assert(!(newsize % 2));
-                assert(size_index_and_val <= newsize);
-
-                if (p % 2)
-                {
-                    sbuf_val = sbuf1_val;
-                    psr      = &sr1;
-                }
-                else
-                {
-                    sbuf_val = sbuf2_val;
-                    psr      = &sr2;
-                }
-                int rc = MPI_Wait(
-                    psr, MPI_STATUS_IGNORE); // wait for previous send to
-                                             // complete before reusing buffer
-                assert(rc == MPI_SUCCESS);
-
-                if (size_index_and_val > 0)
-                    memcpy(&sbuf_val[0], &index_and_val_[dst][0],
-                        size_index_and_val * sizeof(double));
-                if (size_index_and_val < newsize)
-                {
-                    sbuf_val[size_index_and_val] = -1.;
-                }
-
-                assert(partition_comm_->comm() != MPI_COMM_NULL);
-                rc = MPI_Isend(sbuf_val, newsize, MPI_DOUBLE, dest_key, tag,
-                    partition_comm_->comm(), psr);
-                assert(rc == MPI_SUCCESS);
-            }
-        }
-
-        if (recv)
-            assign(newsize, tbuf_val); // assign values received to DistMatrix
-    }
-
-#if MEMMON
-    if (mype_ == 0)
-    {
-        cout << "sendRecvData end" << endl;
-        memmon_print_usage();
-    }
-#endif
-
-    // make sure the last send is completed before deleting buffer!
-    MPI_Wait(&sr1, MPI_STATUS_IGNORE);
-    MPI_Wait(&sr2, MPI_STATUS_IGNORE);
-    delete[] tmp_val;
-
-    // MPI_Barrier(comm_global_);
-#endif
-    pSumSendRecv_tm_.stop();
-}
-
-TEMP_DECL
-void SparseDistMatrix<float>::sendRecvData()
-{
-    pSumSendRecv_tm_.start();
-
-    mat_.clear();
-
-#if MEMMON
-    if (mype_ == 0)
-    {
-        cout << "sendRecvData" << endl;
-        memmon_print_usage();
-    }
-#endif
-    const bool recv = rtasks_distmatrix_->isMyTaskActive();
-
-    int max_val_size   = 0;
-    const int val_size = (int)index_and_val_.size();
-    for (int i = 0; i < val_size; i++)
-        max_val_size = max(max_val_size, (int)index_and_val_[i].size());
-
-    int newsize          = max_val_size;
-
-#if USE_MPI
-    int color            = mype_ / ntasks_per_partition_;
-    const int first_task = ntasks_per_partition_ * color;
-    if (ntasks_per_partition_ > 1)
-    {
-        assert(partition_comm_->comm() != MPI_COMM_NULL);
-        MPI_Allreduce(&max_val_size, &newsize, 1, MPI_INT, MPI_MAX,
-            partition_comm_->comm());
-    }
-    MPI_Request rr   = MPI_REQUEST_NULL;
-    MPI_Request sr1  = MPI_REQUEST_NULL;
-    MPI_Request sr2  = MPI_REQUEST_NULL;
-    MPI_Request* psr = (&sr1);
-
-    // int dest=first_task+(mype_+1)%ntasks_per_partition_;
-    int key       = mype_ - first_task;
-    int dest_key  = (key + 1) % ntasks_per_partition_;
-    int dest_task = first_task + dest_key;
-    int src_key   = key - 1;
-    if (src_key < 0) src_key += ntasks_per_partition_;
-
-    const size_t newsized = newsize * sizeof(float);
-
-    if (newsize == 0) return;
-    float* tmp_val = recv ? new float[4 * newsize] : new float[2 * newsize];
-
-    float* sbuf1_val = tmp_val;
-    float* sbuf2_val = tmp_val + newsize;
-
-    float* tbuf_val = NULL;
-    ;
-    float* rbuf_val = NULL;
-    if (recv)
-    {
-        rbuf_val = tmp_val + 2 * newsize;
-        tbuf_val = tmp_val + 3 * newsize;
-    }
-    float* sbuf_val = sbuf1_val;
-
-    if (ntasks_per_partition_ > 1)
-    {
-        assert(partition_comm_->comm() != MPI_COMM_NULL);
-        if (recv)
-        {
-            MPI_Irecv(rbuf_val, newsize, MPI_FLOAT, src_key, 0,
-                partition_comm_->comm(), &rr);
-        }
-        if (rtasks_distmatrix_->isRemoteTaskActive(dest_task))
-        {
-            const int dst = rtasks_distmatrix_->getRemoteTask(dest_task);
-
-            size_t size_index_and_val = index_and_val_[dst].size();
-            assert(!(size_index_and_val % 2));
-            assert(size_index_and_val <= newsize);
-            if (size_index_and_val > 0)
-                memcpy(sbuf_val, &index_and_val_[dst][0],
-                    size_index_and_val * sizeof(float));
-            if (size_index_and_val < newsize)
-            {
-                sbuf_val[size_index_and_val] = -1.;
-            }
-            MPI_Isend(sbuf_val, newsize, MPI_FLOAT, dest_key, 0,
-                partition_comm_->comm(), psr);
-        }
-    }
-#endif
-
-    // local data
-    if (recv)
-    {
-        const int mytask_index = rtasks_distmatrix_->getMyTaskIndex();
-        if (index_and_val_[mytask_index].size() > 0)
-            assign((int)index_and_val_[mytask_index].size(),
-                &index_and_val_[mytask_index][0]);
-    }
-
-#if USE_MPI
-    for (int p = 0; p < ntasks_per_partition_ - 1; p++)
-    {
-
-        int tag = p + 1;
-        // compute next destination/source
-        dest_key  = (key + p + 2) % ntasks_per_partition_;
-        dest_task = first_task + dest_key;
-        src_key--;
-        if (src_key < 0) src_key += ntasks_per_partition_;
-
-        // copy received data into temporary arrays
-        if (recv)
-        {
-            MPI_Wait(&rr, MPI_STATUS_IGNORE);
-            // copy data only if size relevant data>0
-            if (rbuf_val[0] > -0.5)
-                memcpy(tbuf_val, rbuf_val, newsized);
-            else
-            {
-                tbuf_val[0] = -1.;
-            }
-        }
-
-        // do another send/recv if not last PE
-        if (p < ntasks_per_partition_ - 2)
-        {
-            assert(dest_key < ntasks_per_partition_);
-            assert(dest_key >= 0);
-            assert(src_key < ntasks_per_partition_);
-            assert(src_key >= 0);
-
-            // post next receive for next iteration
-            if (recv)
-            {
-                // receive
-                // cout<<"PE: "<<mype_<<", receive data from PE
-                // "<<src_key<<endl;
-                assert(partition_comm_->comm() != MPI_COMM_NULL);
-                MPI_Irecv(rbuf_val, newsize, MPI_FLOAT, src_key, tag,
-                    partition_comm_->comm(), &rr);
-            }
-
-            // send data
-            if (rtasks_distmatrix_->isRemoteTaskActive(dest_task))
-            {
-                // cout<<"PE: "<<mype_<<", send data to PE "<<dest<<endl;
-                const int dst = rtasks_distmatrix_->getRemoteTask(dest_task);
-
-                size_t size_index_and_val = index_and_val_[dst].size();
-                assert(!(size_index_and_val % 2));
-                assert(!(newsize % 2));
-                assert(size_index_and_val <= newsize);
-
-                if (p % 2)
-                {
-                    sbuf_val = sbuf1_val;
-                    psr      = &sr1;
-                }
-                else
-                {
-                    sbuf_val = sbuf2_val;
-                    psr      = &sr2;
-                }
-                int rc = MPI_Wait(
-                    psr, MPI_STATUS_IGNORE); // wait for previous send to
-                                             // complete before reusing buffer
-                assert(rc == MPI_SUCCESS);
-
-                if (size_index_and_val > 0)
-                    memcpy(&sbuf_val[0], &index_and_val_[dst][0],
-                        size_index_and_val * sizeof(float));
-                if (size_index_and_val < newsize)
-                {
-                    sbuf_val[size_index_and_val] = -1.;
-                }
-
-                assert(partition_comm_->comm() != MPI_COMM_NULL);
-                rc = MPI_Isend(sbuf_val, newsize, MPI_FLOAT, dest_key, tag,
-                    partition_comm_->comm(), psr);
-                assert(rc == MPI_SUCCESS);
-            }
-        }
-
-        if (recv)
-            assign(newsize, tbuf_val); // assign values received to DistMatrix
-    }
-
-#if MEMMON
-    if (mype_ == 0)
-    {
-        cout << "sendRecvData end" << endl;
-        memmon_print_usage();
-    }
-#endif
-
-    // make sure the last send is completed before deleting buffer!
-    MPI_Wait(&sr1, MPI_STATUS_IGNORE);
-    MPI_Wait(&sr2, MPI_STATUS_IGNORE);
-    delete[] tmp_val;
-
-    // MPI_Barrier(comm_global_);
-#endif
-    pSumSendRecv_tm_.stop();
-}
-
-template <class T>
-void SparseDistMatrix<T>::parallelSumToDistMatrix1()
-{
-    assert(&mat_ != NULL);
-#ifdef DEBUG
-    print(cout);
-#endif
-    pSumToDistMatrix_tm_.start();
-
-    maptoarray();
-
-    ntasks_per_partition_ = npes_;
-
-    sendRecvData();
-
-    pSumToDistMatrix_tm_.stop();
-}
-
-TEMP_DECL
-void SparseDistMatrix<double>::parallelSumToDistMatrix2()
-{
-    assert(&mat_ != NULL);
-    assert(npartitions_ >= 0);
-    assert(npartitions_ <= npes_);
-#ifdef DEBUG
-    print(cout);
-#endif
-    pSumToDistMatrix_tm_.start();
-
-    maptoarray();
-
-#if USE_MPI
-    MPI_Request rr1 = MPI_REQUEST_NULL;
-    MPI_Request rr2 = MPI_REQUEST_NULL;
-    MPI_Request sr1 = MPI_REQUEST_NULL;
-    MPI_Request sr2 = MPI_REQUEST_NULL;
-
-    // duplicate data among some processors
-    // so that subsequently communication is needed only inside a partition
-
-    if (npartitions_ > 1)
-    {
-        int* my_data_desc = new int[ntasks_mat_];
-
-        int my_data_size = 0;
-        for (int i = 0; i < ntasks_mat_; i++)
-        {
-            my_data_desc[i] = (int)index_and_val_[i].size();
-            my_data_size += my_data_desc[i];
-        }
-        // if( my_task_index_==0 )cout<<"my_data_size="<<my_data_size<<endl;
-
-        // pack local data for communication
-        double* my_data  = new double[my_data_size];
-        double* pmy_data = &my_data[0];
-        for (int i = 0; i < ntasks_mat_; i++)
-        {
-            memcpy(pmy_data, &index_and_val_[i][0],
-                my_data_desc[i] * sizeof(double));
-            pmy_data += my_data_desc[i];
-        }
-
-        // exchange data with task mype+i*ntasks_per_partition_
-        vector<int> remote_data_desc(ntasks_mat_);
-        vector<double> remote_data;
-        for (int i = 1; i < npartitions_; i++)
-        {
-            int dest = (mype_ + i * ntasks_per_partition_) % npes_;
-            int src  = mype_ - i * ntasks_per_partition_;
-            if (src < 0) src += npes_;
-
-            int tag = 2 * i;
-            MPI_Irecv(&remote_data_desc[0], ntasks_mat_, MPI_INT, src, tag,
-                comm_global_, &rr1);
-            MPI_Isend(&my_data_desc[0], ntasks_mat_, MPI_INT, dest, tag,
-                comm_global_, &sr1);
-
-            MPI_Wait(&rr1, MPI_STATUS_IGNORE);
-            int remote_data_size = 0;
-            for (int pe = 0; pe < ntasks_mat_; pe++)
-            {
-                remote_data_size += remote_data_desc[pe];
-                static bool first_time = true;
-                if (remote_data_size > 250000 && first_time) // 2MB
-                {
-                    cout << "WARNING: mype_=" << mype_ << ", pe=" << pe
-                         << ", remote_data_desc[pe]=" << remote_data_desc[pe]
-                         << ", remote_data_size=" << remote_data_size << endl;
-                    first_time = false;
-                }
-            }
-            if (remote_data_size > 0)
-            {
-                remote_data.resize(remote_data_size);
-                MPI_Irecv(&remote_data[0], remote_data_size, MPI_DOUBLE, src,
-                    tag + 1, comm_global_, &rr2);
-            }
-            if (my_data_size > 0)
-                MPI_Isend(&my_data[0], my_data_size, MPI_DOUBLE, dest, tag + 1,
-                    comm_global_, &sr2);
-
-            // append received data to index_and_val_
-            if (remote_data_size > 0)
-            {
-                double* premote_data = &remote_data[0];
-                MPI_Wait(&rr2, MPI_STATUS_IGNORE);
-                // if( my_task_index_==0 )cout<<"append received data to
-                // index_and_val_ ..."<<endl;
-                for (int pe = 0; pe < ntasks_mat_; pe++)
-                {
-#if 1
-                    std::copy(premote_data, premote_data + remote_data_desc[pe],
-                        back_inserter(index_and_val_[pe]));
-#else
-                    for (int i = 0; i < remote_data_desc[pe]; i++)
-                        index_and_val_[pe].push_back(premote_data[i]);
-#endif
-                    premote_data += remote_data_desc[pe];
-                }
-            }
-        }
-        remote_data.clear();
-
-        MPI_Barrier(comm_global_); // to make sure all the communications are
-                                   // completed and memory can be released
-        delete[] my_data;
-        delete[] my_data_desc;
-    }
-#endif
-
-    sendRecvData();
-
-    pSumToDistMatrix_tm_.stop();
-}
-
-TEMP_DECL
-void SparseDistMatrix<float>::parallelSumToDistMatrix2()
-{
-    assert(&mat_ != NULL);
-    assert(npartitions_ >= 0);
-    assert(npartitions_ <= npes_);
-#ifdef DEBUG
-    print(cout);
-#endif
-    pSumToDistMatrix_tm_.start();
-
-    maptoarray();
-
-#if USE_MPI
-    MPI_Request rr1 = MPI_REQUEST_NULL;
-    MPI_Request rr2 = MPI_REQUEST_NULL;
-    MPI_Request sr1 = MPI_REQUEST_NULL;
-    MPI_Request sr2 = MPI_REQUEST_NULL;
-
-    // duplicate data among some processors
-    // so that subsequently communication is needed only inside a partition
-
-    if (npartitions_ > 1)
-    {
-        int* my_data_desc = new int[ntasks_mat_];
-
-        int my_data_size = 0;
-        for (int i = 0; i < ntasks_mat_; i++)
-        {
-            my_data_desc[i] = (int)index_and_val_[i].size();
-            my_data_size += my_data_desc[i];
-        }
-        // if( my_task_index_==0 )cout<<"my_data_size="<<my_data_size<<endl;
-
-        // pack local data for communication
-        float* my_data  = new float[my_data_size];
-        float* pmy_data = &my_data[0];
-        for (int i = 0; i < ntasks_mat_; i++)
-        {
-            memcpy(pmy_data, &index_and_val_[i][0],
-                my_data_desc[i] * sizeof(float));
-            pmy_data += my_data_desc[i];
-        }
-
-        // exchange data with task mype+i*ntasks_per_partition_
-        vector<int> remote_data_desc(ntasks_mat_);
-        vector<float> remote_data;
-        for (int i = 1; i < npartitions_; i++)
-        {
-            int dest = (mype_ + i * ntasks_per_partition_) % npes_;
-            int src  = mype_ - i * ntasks_per_partition_;
-            if (src < 0) src += npes_;
-
-            int tag = 2 * i;
-            MPI_Irecv(&remote_data_desc[0], ntasks_mat_, MPI_INT, src, tag,
-                comm_global_, &rr1);
-            MPI_Isend(&my_data_desc[0], ntasks_mat_, MPI_INT, dest, tag,
-                comm_global_, &sr1);
-
-            MPI_Wait(&rr1, MPI_STATUS_IGNORE);
-            int remote_data_size = 0;
-            for (int pe = 0; pe < ntasks_mat_; pe++)
-            {
-                remote_data_size += remote_data_desc[pe];
-                if (remote_data_size > 250000) // 2MB
-                    cout << "mype_=" << mype_ << ", pe=" << pe
-                         << ", remote_data_desc[pe]=" << remote_data_desc[pe]
-                         << ", remote_data_size=" << remote_data_size << endl;
-            }
-            if (remote_data_size > 0)
-            {
-                remote_data.resize(remote_data_size);
-                MPI_Irecv(&remote_data[0], remote_data_size, MPI_FLOAT, src,
-                    tag + 1, comm_global_, &rr2);
-            }
-            if (my_data_size > 0)
-                MPI_Isend(&my_data[0], my_data_size, MPI_FLOAT, dest, tag + 1,
-                    comm_global_, &sr2);
-
-            // append received data to index_and_val_
-            if (remote_data_size > 0)
-            {
-                float* premote_data = &remote_data[0];
-                MPI_Wait(&rr2, MPI_STATUS_IGNORE);
-                // if( my_task_index_==0 )cout<<"append received data to
-                // index_and_val_ ..."<<endl;
-                for (int pe = 0; pe < ntasks_mat_; pe++)
-                {
-#if 1
-                    std::copy(premote_data, premote_data + remote_data_desc[pe],
-                        back_inserter(index_and_val_[pe]));
-#else
-                    for (int i = 0; i < remote_data_desc[pe]; i++)
-                        index_and_val_[pe].push_back(premote_data[i]);
-#endif
-                    premote_data += remote_data_desc[pe];
-                }
-            }
-        }
-        remote_data.clear();
-
-        MPI_Barrier(comm_global_); // to make sure all the communications are
-                                   // completed and memory can be released
-        delete[] my_data;
-        delete[] my_data_desc;
-    }
-#endif
-
-    sendRecvData();
-
-    pSumToDistMatrix_tm_.stop();
-}
-
-template <class T>
-void SparseDistMatrix<T>::parallelSumToDistMatrix()
-{
-#if MEMMON
-    if (mype_ == 0)
-    {
-        cout << "parallelSumToDistMatrix, npartitions_=" << npartitions_
-             << endl;
-        memmon_print_usage();
-    }
-#endif
-    // if( mype_==0 )cout<<"parallelSumToDistMatrix,
-    // npartitions_="<<npartitions_<<endl; cout<<"My task = "<<mype_<<",
-    // size(before)="<<size()<<endl;
-    consolidateArray();
-    // cout<<"My task = "<<mype_<<", size(after)="<<size()<<endl;
-
-#if MEMMON
-    if (mype_ == 0)
-    {
-        cout << "parallelSumToDistMatrix2" << endl;
-        memmon_print_usage();
-    }
-#endif
-
-    parallelSumToDistMatrix2();
+    // move whole mb x nb blocks instead of (index,value) pairs,
+    // with communication pattern reused as long as pattern of
+    // non-zero blocks does not change
+    sumTilesToDistMatrix();
 
 #if MEMMON
     if (mype_ == 0)
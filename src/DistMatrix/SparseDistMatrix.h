@@ -24,7 +24,6 @@ typedef int MPI_Comm;
 #endif
 
 #include "DistMatrix.h"
-#include "MPI_DistMatrixCommunicator.h"
 #include "RemoteTasksDistMatrix.h"
 #include "Timer.h"
 
@@ -40,16 +39,29 @@ template <class T>
 class SparseDistMatrix
 {
 private:
-    static int sparse_distmatrix_nb_partitions_;
     static RemoteTasksDistMatrix<T>** def_rtasks_DistMatrix_ptr_;
 
     static Timer pSumToDistMatrix_tm_;
     static Timer pSumSendRecv_tm_;
     static Timer assign_tm_;
-    static Timer maptoarray_tm_;
-    static Timer consolidateArray_tm_;
+    static Timer tiles2array_tm_;
+    static Timer tilesSchedule_tm_;
 
-    static unsigned short consolidation_number_;
+    // Communication pattern to sum blocks into a DistMatrix:
+    // number of blocks sent to and received from each PE,
+    // and global indexes of blocks received
+    struct TilesSchedule
+    {
+        std::vector<int> sendcounts;
+        std::vector<int> recvcounts;
+        std::vector<int> recv_keys;
+    };
+
+    // schedules computed for the last few patterns of non-zero blocks,
+    // each associated with a signature of the global pattern
+    typedef std::pair<unsigned long long, unsigned long long> PatternKey;
+    static std::vector<std::pair<PatternKey, std::shared_ptr<TilesSchedule>>>
+        schedules_;
 
     const MPI_Comm comm_global_;
     int mype_;
@@ -61,63 +73,45 @@ private:
     RemoteTasksDistMatrix<T>* rtasks_distmatrix_;
     // vector<short> other_tasks_indexes_;
 
-    std::shared_ptr<MPI_DistMatrixCommunicator> partition_comm_;
-    int ntasks_per_partition_;
-    int npartitions_;
-
     // holds "local" data in sparse format,
     // separated by ScaLapack destination process
     std::vector<std::vector<T>> index_and_val_;
-    std::vector<std::map<int, T>> map_val_;
+
+    // holds "local" data in block sparse format, with blocks of size
+    // mb x nb as in mat_, separated by ScaLapack destination process:
+    // map from global index of block to position of block in tiles_val_
+    std::vector<std::map<int, int>> tiles_index_;
+    std::vector<std::vector<T>> tiles_val_;
+    int tile_size_;
 
     // holds data for ScaLapack calculations
     DistMatrix<T>& mat_;
 
     void assign(const int, const T* const);
-    void maptoarray();
-    void array2map();
-    void sendRecvData();
-    void parallelSumToDistMatrix1();
-    void parallelSumToDistMatrix2();
+    void addToTile(const int pe, const int index1, const int index2,
+        const T val);
+    void tiles2array();
+    PatternKey computePatternKey() const;
+    const TilesSchedule& getTilesSchedule();
+    void sumTilesToDistMatrix();
 
 public:
-    static void setNumTasksPerPartitioning(const int nb)
-    {
-        sparse_distmatrix_nb_partitions_ = nb;
-    }
-
     static void setRemoteTasksDistMatrixPtr(
         RemoteTasksDistMatrix<T>** rtasksDistMat)
     {
         def_rtasks_DistMatrix_ptr_ = rtasksDistMat;
     }
-    static int numTasksPerPartitioning()
-    {
-        return sparse_distmatrix_nb_partitions_;
-    }
     static RemoteTasksDistMatrix<T>* defaultRemoteTasksDistMatrix()
     {
         return *def_rtasks_DistMatrix_ptr_;
     }
-    static void printConsolidationNumber(std::ostream& os)
-    {
-        os << "SparseDistMatrix: consolidation_number_="
-           << consolidation_number_ << std::endl;
-    }
-
-    static void setConsolidationNumber(unsigned short number)
-    {
-        consolidation_number_ = number;
-    }
     RemoteTasksDistMatrix<T>* remoteTasksDistMatrix()
     {
         return rtasks_distmatrix_;
     }
-    // set rtasks_distmatrix = NULL to create one by default. Also
-    // set target_nb_tasks_per_partition to <=0 to use npes by default
+    // set rtasks_distmatrix = NULL to create one by default
     SparseDistMatrix<T>(MPI_Comm comm, DistMatrix<T>& mat,
-        RemoteTasksDistMatrix<T>* rtasks_distmatrix,
-        const int target_nb_tasks_per_partition);
+        RemoteTasksDistMatrix<T>* rtasks_distmatrix);
     SparseDistMatrix<T>(MPI_Comm comm, DistMatrix<T>& mat);
     SparseDistMatrix<T>(const SparseDistMatrix<T>& spdistmat);
 
@@ -133,20 +127,13 @@ public:
     {
         pSumToDistMatrix_tm_.print(os);
         pSumSendRecv_tm_.print(os);
-        maptoarray_tm_.print(os);
+        tiles2array_tm_.print(os);
         assign_tm_.print(os);
-        consolidateArray_tm_.print(os);
+        tilesSchedule_tm_.print(os);
     }
     void scal(const double alpha);
-    void setPartitioning(const int target_nb_tasks_per_partition);
-    void consolidateArray();
     size_t size() const;
 
-    void printNpartitions(std::ostream& os)
-    {
-        os << "SparseDistMatrix: npartitions_=" << npartitions_ << std::endl;
-    }
-
     void clearIndexAndVal()
     {
         int n = (int)index_and_val_.size();
@@ -163,20 +150,15 @@ public:
         {
             index_and_val_[i].clear();
         }
-        n = (int)map_val_.size();
+        n = (int)tiles_index_.size();
         for (int i = 0; i < n; i++)
         {
-            map_val_[i].clear();
+            tiles_index_[i].clear();
+            tiles_val_[i].clear();
         }
     }
 };
 
-template <class T>
-int SparseDistMatrix<T>::sparse_distmatrix_nb_partitions_ = 128;
-
-template <class T>
-unsigned short SparseDistMatrix<T>::consolidation_number_ = 8;
-
 template <class T>
 RemoteTasksDistMatrix<T>** SparseDistMatrix<T>::def_rtasks_DistMatrix_ptr_ = 0;
 
@@ -188,10 +170,15 @@ Timer SparseDistMatrix<T>::pSumSendRecv_tm_("SparseDistMatrix::pSumSendRecv");
 template <class T>
 Timer SparseDistMatrix<T>::assign_tm_("SparseDistMatrix::assign");
 template <class T>
-Timer SparseDistMatrix<T>::maptoarray_tm_("SparseDistMatrix::maptoarray");
+Timer SparseDistMatrix<T>::tiles2array_tm_("SparseDistMatrix::tiles2array");
+template <class T>
+Timer SparseDistMatrix<T>::tilesSchedule_tm_(
+    "SparseDistMatrix::tilesSchedule");
+
 template <class T>
-Timer SparseDistMatrix<T>::consolidateArray_tm_(
-    "SparseDistMatrix::consolidateArray");
+std::vector<std::pair<typename SparseDistMatrix<T>::PatternKey,
+    std::shared_ptr<typename SparseDistMatrix<T>::TilesSchedule>>>
+    SparseDistMatrix<T>::schedules_;
 
 } // namespace
 
@@ -42,10 +42,11 @@ Electrostatic::Electrostatic(const short lap_type, const short bcPoisson[3],
     assert(bcPoisson[1] >= 0);
     assert(bcPoisson[2] >= 0);
 
-    laptype_ = lap_type;
-    bc_[0]   = bcPoisson[0];
-    bc_[1]   = bcPoisson[1];
-    bc_[2]   = bcPoisson[2];
+    laptype_    = lap_type;
+    max_sweeps_ = 0;
+    bc_[0]      = bcPoisson[0];
+    bc_[1]      = bcPoisson[1];
+    bc_[2]      = bcPoisson[2];
 
     Mesh* mymesh           = Mesh::instance();
     const pb::Grid& myGrid = mymesh->grid();
@@ -241,8 +242,11 @@ void Electrostatic::setupPB(
     double origin[3] = { myGrid.origin(0), myGrid.origin(1), myGrid.origin(2) };
     double cell[3]   = { myGrid.ll(0), myGrid.ll(1), myGrid.ll(2) };
 
-    pbGrid_
-        = GridFactory::createGrid(ngpts, origin, cell, laptype_, true, myPEenv);
+    const std::vector<unsigned> partition[3] = { myGrid.partition(0),
+        myGrid.partition(1), myGrid.partition(2) };
+
+    pbGrid_ = GridFactory::createGrid(
+        ngpts, origin, cell, laptype_, true, myPEenv, partition);
     if (poisson_solver_ != NULL) delete poisson_solver_;
 
     Control& ct = *(Control::instance());
@@ -435,6 +439,7 @@ void Electrostatic::setup(const short max_sweeps)
     const short nu2       = ct.poisson_pc_nu1;
     const short max_nlevs = ct.poisson_pc_nlev;
     poisson_solver_->setup(nu1, nu2, max_sweeps, 1.e-16, max_nlevs);
+    max_sweeps_ = max_sweeps;
 }
 
 template <class T>
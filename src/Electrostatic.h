@@ -38,6 +38,9 @@ class Electrostatic
 
     int iterative_index_;
 
+    // max. number of sweeps set in last call to setup()
+    short max_sweeps_;
+
     static Timer solve_tm_;
 
 public:
@@ -47,6 +50,7 @@ public:
     static Timer solve_tm() { return solve_tm_; }
 
     void setup(const short max_sweeps);
+    short maxSweeps() const { return max_sweeps_; }
     void setupPB(const double rho0, const double drho0, Potentials& pot);
 
     void setupRhoc(RHODTYPE* rhoc);
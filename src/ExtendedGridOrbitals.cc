@@ -25,7 +25,6 @@
 #include "MPIdata.h"
 #include "Mesh.h"
 #include "ProjectedMatrices.h"
-#include "ReplicatedWorkSpace.h"
 #include "SquareLocalMatrices.h"
 #include "SubMatrices.h"
 #include "hdf_tools.h"
@@ -422,13 +421,13 @@ void ExtendedGridOrbitals::multiply_by_matrix(
     (*MPIdata::sout)<<"self multiply_by_matrix"<<endl;
 #endif
 
-    ReplicatedWorkSpace<DISTMATDTYPE>& wspace(ReplicatedWorkSpace<DISTMATDTYPE>::instance());
-    DISTMATDTYPE* work_matrix = wspace.square_matrix();
+    prod_matrix_tm_.start();
 
-    // build a local complete matrix from a distributed matrix
-    dmatrix.matgather(work_matrix, numst_);
+    // subdomains are contiguous in memory, so all the local rows
+    // can be treated at once
+    dmatrix.multiplyFromLeft(numpt_, 1., getPsi(0, 0), lda_, 0., product, ldp);
 
-    multiply_by_matrix(work_matrix, product, ldp);
+    prod_matrix_tm_.stop();
 }
 
 void ExtendedGridOrbitals::multiply_by_matrix(
@@ -534,28 +533,17 @@ void ExtendedGridOrbitals::multiply_by_matrix(
     (*MPIdata::sout)<<"self multiply_by_matrix"<<endl;
 #endif
 
-    ORBDTYPE* product = new ORBDTYPE[loc_numpt_ * numst_];
-    memset(product, 0, loc_numpt_ * numst_ * sizeof(ORBDTYPE));
-
-    ReplicatedWorkSpace<DISTMATDTYPE>& wspace(ReplicatedWorkSpace<DISTMATDTYPE>::instance());
-    DISTMATDTYPE* work_matrix = wspace.square_matrix();
-
-    matrix.matgather(work_matrix, numst_);
-
-    const size_t slnumpt = loc_numpt_ * sizeof(ORBDTYPE);
-
-    // loop over subdomains
-    for (short iloc = 0; iloc < subdivx_; iloc++)
-    {
-        ORBDTYPE* phi = getPsi(0, iloc);
+    ORBDTYPE* product = new ORBDTYPE[numpt_ * numst_];
 
-        // Compute loc_numpt_ rows (for subdomain iloc)
-        MPgemmNN(loc_numpt_, numst_, numst_, 1., phi,
-            lda_, work_matrix, numst_, 0., product, loc_numpt_);
+    // product of orbitals with matrix streamed block row by block row,
+    // without replicating matrix on each PE
+    matrix.multiplyFromLeft(
+        numpt_, 1., getPsi(0, 0), lda_, 0., product, numpt_);
 
-        for (int color = 0; color < numst_; color++)
-            memcpy(phi + color * lda_, product + color * loc_numpt_, slnumpt);
-    }
+    const size_t slnumpt = numpt_ * sizeof(ORBDTYPE);
+    ORBDTYPE* phi        = getPsi(0, 0);
+    for (int color = 0; color < numst_; color++)
+        memcpy(phi + color * lda_, product + color * numpt_, slnumpt);
 
     delete[] product;
 
@@ -1434,6 +1422,8 @@ void ExtendedGridOrbitals::orthonormalize2states(const int st1, const int st2)
         (*MPIdata::sout) << "Gram matrix = " << overlap[0] << "," << overlap[1]
                          << "," << overlap[2] << endl;
 #endif
+
+    incrementIterativeIndex();
 }
 
 void ExtendedGridOrbitals::multiplyByMatrix2states(
@@ -1463,6 +1453,8 @@ void ExtendedGridOrbitals::multiplyByMatrix2states(
         product.block_vector_.axpy(
             mat[1], block_vector_, st2, st1, iloc);
     }
+
+    product.incrementIterativeIndex();
 }
 
 void ExtendedGridOrbitals::computeInvNorms2(vector<vector<double>>& inv_norms2) const
@@ -76,7 +76,7 @@ int FIRE_IonicStepper::init(HDFrestart& h5f_file)
 
         // read positions into tau0_
         string string_name("/Ionic_positions");
-        readPositions_hdf5(h5f_file, string_name);
+        if (readPositions_hdf5(h5f_file, string_name) < 0) return -1;
 
         // Read velocities equal to (taup-tau0)/dt
         hid_t dataset_id = H5Dopen2(file_id, "/Ionic_velocities", H5P_DEFAULT);
@@ -15,6 +15,7 @@
 #include "SymmetricMatrix.h"
 #include "coloring.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstring>
@@ -22,6 +23,23 @@
 #include <numeric>
 using namespace std;
 
+Timer FunctionsPacking::setup_tm_("FunctionsPacking::setup");
+Timer FunctionsPacking::jp_coloring_tm_("FunctionsPacking::JPcoloring");
+
+// Jones-Plassmann priority of a vertex: largest degree first,
+// ties broken by a pseudo-random hash of the gid, then by gid
+static bool higherPriority(
+    const int gid1, const int deg1, const int gid2, const int deg2)
+{
+    if (deg1 != deg2) return deg1 > deg2;
+
+    const unsigned int h1 = (unsigned int)gid1 * 2654435761u;
+    const unsigned int h2 = (unsigned int)gid2 * 2654435761u;
+    if (h1 != h2) return h1 > h2;
+
+    return gid1 > gid2;
+}
+
 FunctionsPacking::FunctionsPacking(
     LocalizationRegions* lrs, const bool global, const MPI_Comm comm)
     : comm_(comm)
@@ -41,6 +59,17 @@ FunctionsPacking::FunctionsPacking(const FunctionsPacking& p)
 void FunctionsPacking::setup(LocalizationRegions* lrs, const bool global)
 {
     Control& ct = *(Control::instance());
+
+    if (global && ct.JPColoring())
+    {
+        setup_tm_.start();
+        setupJonesPlassmann(lrs);
+        setup_tm_.stop();
+        return;
+    }
+
+    setup_tm_.start();
+
     list<list<int>> colored_gids;
 
     std::vector<int> gids;
@@ -73,6 +102,244 @@ void FunctionsPacking::setup(LocalizationRegions* lrs, const bool global)
     getColors(*orbi_overlap, colored_gids);
 
     delete orbi_overlap;
+
+    setup_tm_.stop();
+}
+
+// Build the overlap graph of all the functions, distributed among MPI tasks:
+// vertex gid is owned by task gid%npes, and adj[i] contains the sorted list
+// of neighbors of the i-th vertex owned by this task.
+// Two functions overlap if they both overlap with one subdomain.
+// Local lists of functions overlapping each subdomain are obtained from the
+// spatial index in LocalizationRegions, so no global N*N loop is needed.
+void FunctionsPacking::buildSparseOverlapGraph(LocalizationRegions* lrs,
+    const int nglobal, vector<vector<int>>& adj)
+{
+    int npes = 1;
+    int mype = 0;
+    MPI_Comm_size(comm_, &npes);
+    MPI_Comm_rank(comm_, &mype);
+
+    // local edges, sorted by owner of first vertex
+    vector<vector<int>> sendpairs(npes);
+    const vector<vector<int>>& subdiv_gids(lrs->getSubdivOverlapGids());
+    set<pair<int, int>> local_edges;
+    for (vector<vector<int>>::const_iterator isd = subdiv_gids.begin();
+         isd != subdiv_gids.end(); ++isd)
+    {
+        const vector<int>& gids(*isd);
+        for (vector<int>::const_iterator it1 = gids.begin(); it1 != gids.end();
+             ++it1)
+            for (vector<int>::const_iterator it2 = gids.begin(); it2 != it1;
+                 ++it2)
+            {
+                if (*it1 == *it2) continue;
+                local_edges.insert(pair<int, int>(*it1, *it2));
+                local_edges.insert(pair<int, int>(*it2, *it1));
+            }
+    }
+    for (set<pair<int, int>>::const_iterator it = local_edges.begin();
+         it != local_edges.end(); ++it)
+    {
+        vector<int>& buf(sendpairs[it->first % npes]);
+        buf.push_back(it->first);
+        buf.push_back(it->second);
+    }
+    local_edges.clear();
+
+    // send each edge to owner of its first vertex
+    vector<int> sendcounts(npes);
+    vector<int> sdispls(npes + 1, 0);
+    for (int p = 0; p < npes; p++)
+    {
+        sendcounts[p]  = (int)sendpairs[p].size();
+        sdispls[p + 1] = sdispls[p] + sendcounts[p];
+    }
+    vector<int> sendbuf(sdispls[npes] + 1);
+    for (int p = 0; p < npes; p++)
+        copy(sendpairs[p].begin(), sendpairs[p].end(), &sendbuf[sdispls[p]]);
+    sendpairs.clear();
+
+    vector<int> recvcounts(npes);
+    MPI_Alltoall(&sendcounts[0], 1, MPI_INT, &recvcounts[0], 1, MPI_INT, comm_);
+    vector<int> rdispls(npes + 1, 0);
+    for (int p = 0; p < npes; p++)
+        rdispls[p + 1] = rdispls[p] + recvcounts[p];
+    vector<int> recvbuf(rdispls[npes] + 1);
+    MPI_Alltoallv(&sendbuf[0], &sendcounts[0], &sdispls[0], MPI_INT,
+        &recvbuf[0], &recvcounts[0], &rdispls[0], MPI_INT, comm_);
+
+    // adjacency lists of owned vertices
+    const int nowned = (nglobal > mype) ? (nglobal - mype - 1) / npes + 1 : 0;
+    adj.clear();
+    adj.resize(nowned);
+    for (int i = 0; i < rdispls[npes]; i += 2)
+    {
+        const int v = recvbuf[i];
+        assert(v % npes == mype);
+        assert(v / npes < nowned);
+        adj[v / npes].push_back(recvbuf[i + 1]);
+    }
+    for (vector<vector<int>>::iterator it = adj.begin(); it != adj.end(); ++it)
+    {
+        sort(it->begin(), it->end());
+        it->erase(unique(it->begin(), it->end()), it->end());
+    }
+}
+
+// Distributed Jones-Plassmann coloring of the sparse overlap graph.
+// At each round, every uncolored vertex with a higher priority than all its
+// uncolored neighbors takes the smallest color not used by its neighbors.
+// Such vertices form an independent set, so they can all be colored
+// concurrently. New colors are then exchanged among all tasks.
+void FunctionsPacking::setupJonesPlassmann(LocalizationRegions* lrs)
+{
+    Control& ct = *(Control::instance());
+
+    if (onpe0 && ct.verbose > 1)
+        (*MPIdata::sout) << " PACK STATES: Global Jones-Plassmann coloring..."
+                         << endl;
+
+    std::vector<int> gids;
+    lrs->getGidsGlobal(gids);
+    global_size_ = (int)gids.size();
+
+    if (onpe0 && ct.verbose > 0)
+    {
+        (*MPIdata::sout) << "setup FunctionsPacking for size=" << global_size_
+                         << endl;
+    }
+
+    int npes = 1;
+    int mype = 0;
+    MPI_Comm_size(comm_, &npes);
+    MPI_Comm_rank(comm_, &mype);
+
+    const double t0 = MPI_Wtime();
+
+    vector<vector<int>> adj;
+    buildSparseOverlapGraph(lrs, global_size_, adj);
+    const int nowned = (int)adj.size();
+
+    jp_coloring_tm_.start();
+
+    // degrees of all the vertices
+    vector<int> degrees(global_size_, 0);
+    for (int i = 0; i < nowned; i++)
+        degrees[mype + i * npes] = (int)adj[i].size();
+    MPI_Allreduce(
+        MPI_IN_PLACE, &degrees[0], global_size_, MPI_INT, MPI_SUM, comm_);
+
+    // colors of all the vertices, -1 if not colored yet
+    vector<short> colors(global_size_, -1);
+
+    int ncolored = 0;
+    int nrounds  = 0;
+    vector<int> newcolors;
+    vector<int> counts(npes);
+    vector<int> displs(npes + 1);
+    vector<char> used;
+    while (ncolored < global_size_)
+    {
+        newcolors.clear();
+        for (int i = 0; i < nowned; i++)
+        {
+            const int v = mype + i * npes;
+            if (colors[v] >= 0) continue;
+
+            bool ismax = true;
+            for (vector<int>::const_iterator it = adj[i].begin();
+                 it != adj[i].end(); ++it)
+            {
+                if (colors[*it] < 0
+                    && higherPriority(*it, degrees[*it], v, degrees[v]))
+                {
+                    ismax = false;
+                    break;
+                }
+            }
+            if (!ismax) continue;
+
+            // smallest color not used by neighbors
+            used.assign(adj[i].size() + 1, 0);
+            for (vector<int>::const_iterator it = adj[i].begin();
+                 it != adj[i].end(); ++it)
+            {
+                const short c = colors[*it];
+                if (c >= 0 && c < (short)used.size()) used[c] = 1;
+            }
+            short c = 0;
+            while (used[c])
+                c++;
+
+            newcolors.push_back(v);
+            newcolors.push_back(c);
+        }
+
+        // neighbors colored during this round are not adjacent to each
+        // other, so colors can be set after the loop over vertices
+        const int nsend = (int)newcolors.size();
+        MPI_Allgather(&nsend, 1, MPI_INT, &counts[0], 1, MPI_INT, comm_);
+        displs[0] = 0;
+        for (int p = 0; p < npes; p++)
+            displs[p + 1] = displs[p] + counts[p];
+        vector<int> allnew(displs[npes] + 1);
+        newcolors.push_back(-1);
+        MPI_Allgatherv(&newcolors[0], nsend, MPI_INT, &allnew[0], &counts[0],
+            &displs[0], MPI_INT, comm_);
+
+        for (int i = 0; i < displs[npes]; i += 2)
+        {
+            assert(colors[allnew[i]] < 0);
+            colors[allnew[i]] = (short)allnew[i + 1];
+        }
+        ncolored += displs[npes] / 2;
+        nrounds++;
+
+        // at least the vertex of highest priority is colored at each round
+        assert(displs[npes] > 0);
+    }
+
+    jp_coloring_tm_.stop();
+
+    num_colors_ = 0;
+    for (int gid = 0; gid < global_size_; gid++)
+    {
+        gid2color_.insert(pair<int, short>(gid, colors[gid]));
+        if (colors[gid] + 1 > num_colors_) num_colors_ = colors[gid] + 1;
+    }
+
+    const double t1 = MPI_Wtime();
+
+    if (onpe0 && ct.verbose > 0)
+    {
+        (*MPIdata::sout) << "FunctionsPacking::num_colors_= " << num_colors_
+                         << " (Jones-Plassmann, " << nrounds << " rounds, "
+                         << t1 - t0 << " s)" << endl;
+    }
+
+    // compare with coloring based on dense overlap matrix
+    if (ct.verbose > 2)
+    {
+        SymmetricMatrix<char> orbi_overlap(global_size_, comm_);
+        initOrbiOverlapGlobal(lrs, 0, orbi_overlap);
+
+        list<list<int>> colored_gids;
+        greedyColor(orbi_overlap, colored_gids, false, (*MPIdata::sout));
+
+        const double t2 = MPI_Wtime();
+        if (onpe0)
+            (*MPIdata::sout)
+                << "FunctionsPacking: dense greedy coloring uses "
+                << colored_gids.size() << " colors (" << t2 - t1 << " s)"
+                << endl;
+    }
+}
+
+void FunctionsPacking::printTimers(ostream& os)
+{
+    setup_tm_.print(os);
+    jp_coloring_tm_.print(os);
 }
 
 // compute map "gid2color_" that maps gids to slots
@@ -13,6 +13,7 @@
 #define MGMOL_FUNCTIONSPACKING_H
 
 #include "SymmetricMatrix.h"
+#include "Timer.h"
 
 #include <list>
 #include <map>
@@ -30,7 +31,13 @@ private:
 
     MPI_Comm comm_;
 
+    static Timer setup_tm_;
+    static Timer jp_coloring_tm_;
+
     void setup(LocalizationRegions* lrs, const bool global);
+    void setupJonesPlassmann(LocalizationRegions* lrs);
+    void buildSparseOverlapGraph(LocalizationRegions* lrs, const int nglobal,
+        std::vector<std::vector<int>>& adj);
 
     void getColors(const SymmetricMatrix<char>& overlaps,
         std::list<std::list<int>>& colors);
@@ -59,6 +66,8 @@ public:
     }
 
     int chromatic_number() const { return num_colors_; }
+
+    static void printTimers(std::ostream& os);
 };
 
 #endif
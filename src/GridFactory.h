@@ -17,9 +17,8 @@
 class GridFactory
 {
 public:
-    static pb::Grid* createGrid(const unsigned ngpts[3], const double origin[3],
-        const double lattice[3], const int lap_type, const bool diel_flag,
-        const pb::PEenv& myPEenv)
+    // number of ghost points needed by Laplacian of type lap_type
+    static int nghosts(const int lap_type, const bool diel_flag)
     {
         int nghosts = 0;
         switch (lap_type)
@@ -49,7 +48,16 @@ public:
                     << std::endl;
                 exit(2);
         }
-        return (new pb::Grid(origin, lattice, ngpts, myPEenv, nghosts));
+        return nghosts;
+    }
+
+    static pb::Grid* createGrid(const unsigned ngpts[3], const double origin[3],
+        const double lattice[3], const int lap_type, const bool diel_flag,
+        const pb::PEenv& myPEenv,
+        const std::vector<unsigned>* partition = 0)
+    {
+        return (new pb::Grid(origin, lattice, ngpts, myPEenv,
+            nghosts(lap_type, diel_flag), 0, partition));
     }
 };
 
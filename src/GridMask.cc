@@ -301,9 +301,10 @@ void GridMask::plot(const unsigned short level, const int st)
         }
         else if (mask_not_zero_[level][iloc] == 2)
         {
-            lmasktype* pmask = &lmask_[level][iloc][0];
+            vector<lmasktype> mask;
+            lmask_[level][iloc].expand(mask);
             for (int i = 0; i < lnumpt; i++)
-                ofile << (int)pmask[i] << endl;
+                ofile << (int)mask[i] << endl;
         }
     }
     ofile.close();
@@ -329,7 +330,7 @@ void GridMask::assign(const unsigned short iloc, const unsigned short level,
     // Early return if all elements are 0 and stay 0
     if (num == 0 && xnum == 0)
     {
-        if (mask_not_zero_[level][iloc] == 2) lmask_[level][iloc].resize(0);
+        if (mask_not_zero_[level][iloc] == 2) lmask_[level][iloc].clear();
         mask_not_zero_[level][iloc] = -1;
         return;
     }
@@ -337,15 +338,17 @@ void GridMask::assign(const unsigned short iloc, const unsigned short level,
     // Early return if all elements are 0
     if (num == 0)
     {
-        if (mask_not_zero_[level][iloc] == 2) lmask_[level][iloc].resize(0);
+        if (mask_not_zero_[level][iloc] == 2) lmask_[level][iloc].clear();
         mask_not_zero_[level][iloc] = 0;
         return;
     }
-    mask_not_zero_[level][iloc] = 2;
+    assert((int)val.size() == loc_numpt_[level]);
+
+    const int dim1 = (grid_.dim(1) >> level);
+    const int dim2 = (grid_.dim(2) >> level);
+    lmask_[level][iloc].setup(&val[0], subdim0_[level], dim1, dim2);
 
-    lmask_[level][iloc].resize(val.size());
-    lmask_[level][iloc] = val;
-    assert(lmask_[level][iloc].size() == val.size());
+    mask_not_zero_[level][iloc] = 2;
 }
 
 void GridMask::assign1(const unsigned short iloc, const unsigned short level)
@@ -354,7 +357,7 @@ void GridMask::assign1(const unsigned short iloc, const unsigned short level)
     assert(level < (unsigned short)mask_not_zero_.size());
     assert((unsigned short)lmask_[level].size() > iloc);
 
-    if (mask_not_zero_[level][iloc] == 2) lmask_[level][iloc].resize(0);
+    if (mask_not_zero_[level][iloc] == 2) lmask_[level][iloc].clear();
     mask_not_zero_[level][iloc] = 1;
 
     return;
@@ -385,32 +388,41 @@ bool GridMask::overlap_on_pe(
     return overlap_12;
 }
 
+size_t GridMask::memory() const
+{
+    size_t mem = 0;
+    for (unsigned short l = 0; l < nlevels_; l++)
+        for (unsigned short iloc = 0; iloc < subdivx_; iloc++)
+            if (mask_not_zero_[l][iloc] == 2) mem += lmask_[l][iloc].memory();
+    return mem;
+}
+
+size_t GridMask::denseMemory() const
+{
+    size_t mem = 0;
+    for (unsigned short l = 0; l < nlevels_; l++)
+        for (unsigned short iloc = 0; iloc < subdivx_; iloc++)
+            if (mask_not_zero_[l][iloc] == 2)
+                mem += loc_numpt_[l] * sizeof(lmasktype);
+    return mem;
+}
+
 template <typename T>
 void GridMask::multiplyByMask(
     T* u, const unsigned short level, const unsigned short iloc) const
 {
-    const int lnumpt = loc_numpt_[level];
-    const vector<lmasktype>& maskptr(lmask_[level][iloc]);
-    T* const pu = u + offset(level, iloc);
-    for (int idx = 0; idx < lnumpt; idx++)
-    {
-        assert(maskptr[idx] >= 0 && maskptr[idx] <= 1);
-        pu[idx] *= (T)maskptr[idx];
-    }
+    const int dim1 = (grid_.dim(1) >> level);
+    const int dim2 = (grid_.dim(2) >> level);
+    lmask_[level][iloc].multiply(u + offset(level, iloc), dim1 * dim2, dim2);
 }
 
 template <typename T>
 void GridMask::cutWithMask(
     T* u, const unsigned short level, const unsigned short iloc) const
 {
-    const int lnumpt = loc_numpt_[level];
-    const vector<lmasktype>& maskptr(lmask_[level][iloc]);
-    T* const pu = u + offset(level, iloc);
-    for (int idx = 0; idx < lnumpt; idx++)
-    {
-        assert(maskptr[idx] >= 0 && maskptr[idx] <= 1);
-        pu[idx] = limitAbsValue(pu[idx], maskptr[idx]);
-    }
+    const int dim1 = (grid_.dim(1) >> level);
+    const int dim2 = (grid_.dim(2) >> level);
+    lmask_[level][iloc].cut(u + offset(level, iloc), dim1 * dim2, dim2);
 }
 
 // explicit instantiations
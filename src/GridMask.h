@@ -11,6 +11,7 @@
 #ifndef GRIDMASK_H
 #define GRIDMASK_H
 
+#include "CompressedMask.h"
 #include "GridFunc.h"
 #include "Timer.h"
 #include "Vector3D.h"
@@ -43,7 +44,8 @@ private:
     double radius_; // radius of mask
 
     // Localization mask for all the levels and subdomains
-    std::vector<std::vector<std::vector<lmasktype>>> lmask_;
+    // (compressed format)
+    std::vector<std::vector<CompressedMask>> lmask_;
 
     // Values of mask_not_zero_:
     // -1 -> mask not needed (always 0 everywhere)
@@ -53,9 +55,10 @@ private:
     std::vector<std::vector<short>> mask_not_zero_; // levels, subdivx
 
 protected:
-    lmasktype* lmask(const unsigned short level, const unsigned short iloc)
+    const CompressedMask& lmask(
+        const unsigned short level, const unsigned short iloc) const
     {
-        return &lmask_[level][iloc][0];
+        return lmask_[level][iloc];
     }
 
 public:
@@ -96,7 +99,7 @@ public:
         {
             if (mask_not_zero_[level][i] == 2)
             {
-                lmask_[level][i].resize(0);
+                lmask_[level][i].clear();
             }
             mask_not_zero_[level][i] = 1;
         }
@@ -136,6 +139,11 @@ public:
         = 0;
 
     void plot(const unsigned short, const int);
+
+    // memory (in bytes) used by mask data, in compressed format
+    // and as it would be in dense format
+    size_t memory() const;
+    size_t denseMemory() const;
     bool overlap_on_pe(const GridMask& gm, const unsigned short level) const;
 
     bool maskIs0(const unsigned short level, const unsigned short iloc) const
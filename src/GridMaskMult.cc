@@ -55,35 +55,8 @@ void GridMaskMult::applyPrivate(
 
         const int incy1 = gu.grid().inc(1);
 
-        const int dim1  = gu.grid().dim(1);
-        const int dim2  = gu.grid().dim(2);
-        const int incx2 = dim2 * dim1;
-        const int incy2 = dim2;
-
-        const lmasktype* const maskptr = GridMask::lmask(level, iloc);
-
-        int ix1 = shift + shift * incy1;
-        int ix2 = 0;
-        for (int ix = 0; ix < subdimx; ix++)
-        {
-            int iy1 = ix1;
-            int iy2 = ix2;
-            for (int iy = 0; iy < dim1; iy++)
-            {
-                T* const ppu                 = pu + iy1;
-                const lmasktype* const pmask = maskptr + iy2;
-                for (int iz = 0; iz < dim2; iz++)
-                {
-                    // assert( iy2+iz< gu.grid().size()/subdivx_ );
-                    assert(offset + iy1 + iz < gu.grid().sizeg());
-                    ppu[iz] *= (T)pmask[iz];
-                }
-                iy1 += incy1;
-                iy2 += incy2;
-            }
-            ix1 += incx1;
-            ix2 += incx2;
-        }
+        GridMask::lmask(level, iloc)
+            .multiply(pu + shift + shift * incy1, incx1, incy1);
     }
 }
 
@@ -16,7 +16,10 @@
 #include "hdf_tools.h"
 #include "tools.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
+#include <set>
 #include <sstream>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -109,7 +112,16 @@ int HDFrestart::close()
     if (onpe0)
         (*MPIdata::sout) << "~HDFrestart() --- H5Fclose " << filename_ << endl;
     herr_t err = 0;
-    if (active_)
+    if (redistributed_)
+    {
+        for (unsigned i = 0; i < overlapping_files_.size(); i++)
+        {
+            herr_t ierr = H5Fclose(overlapping_files_[i]);
+            if (ierr < 0) err = ierr;
+        }
+        overlapping_files_.clear();
+    }
+    else if (active_)
     {
         assert(file_id_ >= 0);
         err = H5Fclose(file_id_);
@@ -195,48 +207,55 @@ void HDFrestart::setActivity()
         active_ = true;
 }
 
-void HDFrestart::appendTaskNumberToFilename()
+// append number of task mytask out of npes tasks to filename
+static void appendTaskNumber(
+    std::string& filename, const int mytask, const int npes)
 {
-    int mytask = 0;
-    int npes   = 1;
-#ifdef USE_MPI
-    MPI_Comm_rank(comm_data_, &mytask);
-    MPI_Comm_size(comm_data_, &npes);
-#endif
-    filename_.append(".");
+    filename.append(".");
     if (mytask < 1000000 && npes > 999999)
     {
-        filename_.append("0");
+        filename.append("0");
     }
     if (mytask < 100000 && npes > 99999)
     {
-        filename_.append("0");
+        filename.append("0");
     }
     if (mytask < 10000 && npes > 9999)
     {
-        filename_.append("0");
+        filename.append("0");
     }
     if (mytask < 1000)
     {
-        filename_.append("0");
+        filename.append("0");
     }
     if (mytask < 100)
     {
-        filename_.append("0");
+        filename.append("0");
     }
     if (mytask < 10)
     {
-        filename_.append("0");
+        filename.append("0");
     }
 
     std::stringstream oss("");
     oss << mytask;
 
-    filename_.append(oss.str());
+    filename.append(oss.str());
 
     return;
 }
 
+void HDFrestart::appendTaskNumberToFilename()
+{
+    int mytask = 0;
+    int npes   = 1;
+#ifdef USE_MPI
+    MPI_Comm_rank(comm_data_, &mytask);
+    MPI_Comm_size(comm_data_, &npes);
+#endif
+    appendTaskNumber(filename_, mytask, npes);
+}
+
 void HDFrestart::setupBlocks()
 {
     block_[0] = dimsf_[0] / pes_.n_mpi_task(0);
@@ -504,8 +523,9 @@ HDFrestart::HDFrestart(const std::string filename, const pb::PEenv& pes,
     create_file_tm_.start();
 
     setOptions(option_number);
-    verbosity_ = 0;
-    closed_    = false;
+    verbosity_     = 0;
+    closed_        = false;
+    redistributed_ = false;
 
     //(*MPIdata::sout)<<"HDFrestart::HDFrestart(), filename="<<filename<<endl;
     setActivity();
@@ -532,8 +552,13 @@ HDFrestart::HDFrestart(const std::string filename, const pb::PEenv& pes,
 
     if (!use_hdf5p_) // mkdir with filename and create files with task numbers
     {
-        // check if dir exists
-        if (onpe0)
+        // check if dir exists (first task of communicator, which is not
+        // global task 0 for all images of an ensemble)
+        int mype = 0;
+#ifdef USE_MPI
+        MPI_Comm_rank(comm_data_, &mype);
+#endif
+        if (mype == 0)
         {
             struct stat buf;
             int exists  = stat(filename_.c_str(), &buf);
@@ -610,6 +635,11 @@ HDFrestart::HDFrestart(const std::string filename, const pb::PEenv& pes,
     {
         file_id_ = -1;
     }
+
+    // record subdomains of all tasks to allow restarting with
+    // a different decomposition
+    if (!use_hdf5p_ && !gather_data_x_) writeDecomposition();
+
     setupWorkSpace();
 
     verbosity_ = 0;
@@ -639,17 +669,48 @@ HDFrestart::HDFrestart(
     Control& ct = *(Control::instance());
 
     setOptions(option_number);
-    filename_ = filename;
+    filename_      = filename;
+    verbosity_     = 0;
+    closed_        = false;
+    redistributed_ = false;
+
+    // check if files were written with a different decomposition
+    vector<int> boxes;
+    if (!use_hdf5p_ && !gather_data_x_)
+        redistributed_ = readDecomposition(filename, boxes);
+
     if (!use_hdf5p_)
     {
         filename_.append("/Task");
         appendTaskNumberToFilename();
     }
-    verbosity_ = 0;
-    closed_    = false;
 
     setActivity();
 
+    count_[0] = count_[1] = count_[2] = 1;
+    stride_[0] = stride_[1] = stride_[2] = 1;
+
+    if (redistributed_)
+    {
+        setCommActive();
+        setupBlocks();
+
+        // open the files overlapping local subdomain only
+        openOverlappingFiles(filename, boxes);
+
+        setupWorkSpace();
+        setupAtomsSelection();
+
+        if (onpe0 && ct.verbose > 0)
+            (*MPIdata::sout)
+                << "HDFrestart() --- Read data written by " << boxes.size() / 6
+                << " tasks, Data blocks: " << block_[0] << " x " << block_[1]
+                << " x " << block_[2] << endl;
+
+        open_existing_tm_.stop();
+        return;
+    }
+
     if (active_)
     {
         if (!fileExists(filename_.c_str()))
@@ -670,9 +731,6 @@ HDFrestart::HDFrestart(
 
     mmpi.barrier();
 
-    count_[0] = count_[1] = count_[2] = 1;
-    stride_[0] = stride_[1] = stride_[2] = 1;
-
     setCommActive();
 
     if (active_)
@@ -782,6 +840,376 @@ HDFrestart::HDFrestart(
     open_existing_tm_.stop();
 };
 
+// Task 0 writes the subdomains (global start index and extents) of all
+// the tasks writing files
+void HDFrestart::writeDecomposition()
+{
+    vector<int> box(6);
+    for (short d = 0; d < 3; d++)
+    {
+        box[d]     = pes_.my_mpi(d) * (int)block_[d];
+        box[3 + d] = (int)block_[d];
+    }
+
+    int mytask = 0;
+    int npes   = 1;
+    vector<int> boxes(box);
+#ifdef USE_MPI
+    MPI_Comm_rank(comm_data_, &mytask);
+    MPI_Comm_size(comm_data_, &npes);
+    boxes.resize(6 * npes);
+    MPI_Gather(&box[0], 6, MPI_INT, &boxes[0], 6, MPI_INT, 0, comm_data_);
+#endif
+
+    if (mytask == 0)
+    {
+        size_t dims[2] = { (size_t)npes, 6 };
+        mgmol_tools::write2d(file_id_, "/Decomposition", boxes, dims);
+    }
+}
+
+// Read subdomains of the tasks that wrote files in directory dirname.
+// Return true if they differ from the current decomposition
+// (files written without subdomains are assumed to match it)
+bool HDFrestart::readDecomposition(
+    const std::string& dirname, std::vector<int>& boxes)
+{
+    Control& ct = *(Control::instance());
+
+    int mytask = 0;
+    int npes   = 1;
+#ifdef USE_MPI
+    MPI_Comm_rank(comm_data_, &mytask);
+    MPI_Comm_size(comm_data_, &npes);
+#endif
+
+    int nfiles = 0;
+    if (mytask == 0)
+    {
+        // name of file written by task 0 depends on number of tasks
+        const int ntasks[4] = { 1, 10000, 100000, 1000000 };
+        for (short i = 0; i < 4; i++)
+        {
+            string name(dirname);
+            name.append("/Task");
+            appendTaskNumber(name, 0, ntasks[i]);
+            if (!fileExists(name.c_str())) continue;
+
+            hid_t file_id = H5Fopen(name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            if (file_id < 0)
+            {
+                (*MPIdata::serr) << "HDFrestart::readDecomposition() --- open "
+                                 << name << " failed!!!" << endl;
+                break;
+            }
+            if (H5Lexists(file_id, "/Decomposition", H5P_DEFAULT) > 0)
+            {
+                hid_t dset_id
+                    = H5Dopen2(file_id, "/Decomposition", H5P_DEFAULT);
+                hid_t dspace_id = H5Dget_space(dset_id);
+                hsize_t dims[2] = { 0, 0 };
+                H5Sget_simple_extent_dims(dspace_id, dims, NULL);
+                H5Sclose(dspace_id);
+
+                boxes.resize(6 * dims[0]);
+                herr_t status = H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL,
+                    H5S_ALL, H5P_DEFAULT, &boxes[0]);
+                if (status < 0)
+                    (*MPIdata::serr) << "HDFrestart::readDecomposition() --- "
+                                        "H5Dread failed!!!"
+                                     << endl;
+                else
+                    nfiles = (int)dims[0];
+                H5Dclose(dset_id);
+            }
+            H5Fclose(file_id);
+            break;
+        }
+    }
+#ifdef USE_MPI
+    MPI_Bcast(&nfiles, 1, MPI_INT, 0, comm_data_);
+#endif
+    if (nfiles == 0) return false;
+
+    boxes.resize(6 * nfiles);
+#ifdef USE_MPI
+    MPI_Bcast(&boxes[0], 6 * nfiles, MPI_INT, 0, comm_data_);
+#endif
+
+    // global mesh size
+    for (short d = 0; d < 3; d++)
+    {
+        dimsf_[d] = 0;
+        for (int i = 0; i < nfiles; i++)
+            dimsf_[d] = max(
+                dimsf_[d], (hsize_t)(boxes[6 * i + d] + boxes[6 * i + 3 + d]));
+    }
+
+    // compare subdomain of file with same task number with local subdomain
+    int differ = (nfiles != npes);
+    if (!differ)
+        for (short d = 0; d < 3; d++)
+        {
+            const int bsize = (int)dimsf_[d] / pes_.n_mpi_task(d);
+            if (boxes[6 * mytask + d] != pes_.my_mpi(d) * bsize
+                || boxes[6 * mytask + 3 + d] != bsize)
+                differ = 1;
+        }
+#ifdef USE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &differ, 1, MPI_INT, MPI_MAX, comm_data_);
+#endif
+    if (!differ) return false;
+
+    if (onpe0 && ct.verbose > 0)
+        (*MPIdata::sout) << "HDFrestart: files in " << dirname
+                         << " written with a different decomposition by "
+                         << nfiles << " tasks" << endl;
+
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    for (short d = 0; d < 3; d++)
+        if (dimsf_[d] != mygrid.gdim(d))
+        {
+            if (onpe0)
+                (*MPIdata::serr) << "ERROR HDFrestart: mesh in restart files "
+                                 << dimsf_[0] << " x " << dimsf_[1] << " x "
+                                 << dimsf_[2] << " different from current mesh"
+                                 << endl;
+            ct.global_exit(2);
+        }
+
+    return true;
+}
+
+// Open files written by tasks whose subdomains overlap local subdomain,
+// in increasing order of task number
+void HDFrestart::openOverlappingFiles(
+    const std::string& dirname, const std::vector<int>& boxes)
+{
+    Control& ct = *(Control::instance());
+
+    int mystart[3];
+    int myend[3];
+    for (short d = 0; d < 3; d++)
+    {
+        mystart[d] = pes_.my_mpi(d) * (int)block_[d];
+        myend[d]   = mystart[d] + (int)block_[d];
+    }
+
+    overlapping_files_.clear();
+    overlapping_boxes_.clear();
+
+    const int nfiles = (int)boxes.size() / 6;
+    for (int i = 0; i < nfiles; i++)
+    {
+        const int* const box = &boxes[6 * i];
+
+        bool overlap = true;
+        for (short d = 0; d < 3; d++)
+            if (box[d] >= myend[d] || box[d] + box[3 + d] <= mystart[d])
+                overlap = false;
+        if (!overlap) continue;
+
+        string name(dirname);
+        name.append("/Task");
+        appendTaskNumber(name, i, nfiles);
+
+        // several files may be open at once, and only a hyperslab is
+        // read from each: read from disk instead of loading whole files
+        // in memory with the core driver
+        hid_t access_plist = H5Pcreate(H5P_FILE_ACCESS);
+        herr_t err_id      = H5Pset_fapl_sec2(access_plist);
+        if (err_id < 0)
+            (*MPIdata::serr)
+                << "HDFrestart(): H5Pset_fapl_sec2 failed!!!" << endl;
+        hid_t file_id = H5Fopen(name.c_str(), H5F_ACC_RDONLY, access_plist);
+        H5Pclose(access_plist);
+        if (file_id < 0)
+        {
+            (*MPIdata::serr)
+                << "HDFrestart(): open " << name << " failed!!!" << endl;
+            ct.global_exit(2);
+        }
+
+        if (overlapping_files_.empty()) filename_ = name;
+        overlapping_files_.push_back(file_id);
+        overlapping_boxes_.insert(overlapping_boxes_.end(), box, box + 6);
+    }
+    assert(!overlapping_files_.empty());
+
+    file_id_ = overlapping_files_[0];
+
+    if (onpe0 && ct.verbose > 0)
+        (*MPIdata::sout) << "HDFrestart(): read local data from "
+                         << overlapping_files_.size() << " files" << endl;
+}
+
+// An atom found in a file is read by the task which subdomain contains
+// its mesh location clamped to the subdomain of that file, so that each
+// atom is read exactly once. Atoms which moved slightly outside the
+// subdomain of the task that wrote them are then handed to their owner by
+// Ions::updateListIons().
+bool HDFrestart::isAtomSelected(
+    const double tau[3], const int* const box) const
+{
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+
+    for (short d = 0; d < 3; d++)
+    {
+        const double ll = mygrid.ll(d);
+        double t        = tau[d] - mygrid.origin(d);
+        t -= ll * floor(t / ll);
+
+        int i = (int)floor(t / mygrid.hgrid(d));
+        i     = max(box[d], min(i, box[d] + box[3 + d] - 1));
+
+        const int mystart = pes_.my_mpi(d) * (int)block_[d];
+        if (i < mystart || i >= mystart + (int)block_[d]) return false;
+    }
+
+    return true;
+}
+
+void HDFrestart::setupAtomsSelection()
+{
+    assert(redistributed_);
+
+    // read each file as a file of the current decomposition
+    redistributed_ = false;
+
+    atoms_selection_.resize(overlapping_files_.size());
+    for (unsigned i = 0; i < overlapping_files_.size(); i++)
+    {
+        file_id_ = overlapping_files_[i];
+
+        vector<double> tau;
+        readAtomicPositions(tau);
+
+        const int natoms = (int)tau.size() / 3;
+        atoms_selection_[i].resize(natoms);
+        for (int ia = 0; ia < natoms; ia++)
+            atoms_selection_[i][ia]
+                = isAtomSelected(&tau[3 * ia], &overlapping_boxes_[6 * i]);
+    }
+
+    file_id_       = overlapping_files_[0];
+    redistributed_ = true;
+}
+
+// Concatenate data read by function "read" from all the files overlapping
+// local subdomain. For atomic data, keep only data of selected atoms.
+template <typename T>
+int HDFrestart::readFromOverlappingFiles(
+    int (HDFrestart::*read)(std::vector<T>&), std::vector<T>& data,
+    const bool atomic_data)
+{
+    assert(redistributed_);
+
+    data.clear();
+
+    // read each file as a file of the current decomposition
+    redistributed_ = false;
+
+    int ret = 0;
+    for (unsigned i = 0; i < overlapping_files_.size(); i++)
+    {
+        const vector<bool>& selected(atoms_selection_[i]);
+        const int natoms = (int)selected.size();
+        if (atomic_data && natoms == 0) continue;
+
+        file_id_ = overlapping_files_[i];
+
+        vector<T> fdata;
+        const int status = (this->*read)(fdata);
+        ret              = min(ret, status);
+
+        if (!atomic_data)
+        {
+            data.insert(data.end(), fdata.begin(), fdata.end());
+            continue;
+        }
+
+        // number of values per atom
+        const int n = (int)fdata.size() / natoms;
+        if (n * natoms != (int)fdata.size()) continue;
+        for (int ia = 0; ia < natoms; ia++)
+            if (selected[ia])
+                data.insert(data.end(), fdata.begin() + ia * n,
+                    fdata.begin() + (ia + 1) * n);
+    }
+
+    file_id_       = overlapping_files_[0];
+    redistributed_ = true;
+
+    return ret;
+}
+
+// Read dataset datasetname from all the files overlapping local subdomain,
+// and assemble local block into data
+int HDFrestart::readOverlappingBlocks(
+    const std::string& datasetname, hid_t memtype, void* data)
+{
+    assert(redistributed_);
+
+    hid_t memspace = H5Screate_simple(3, block_, NULL);
+
+    for (unsigned i = 0; i < overlapping_files_.size(); i++)
+    {
+        const int* const box = &overlapping_boxes_[6 * i];
+
+        // intersection of subdomain of file with local subdomain
+        hsize_t file_offset[3];
+        hsize_t mem_offset[3];
+        hsize_t count[3];
+        for (short d = 0; d < 3; d++)
+        {
+            const int mystart = pes_.my_mpi(d) * (int)block_[d];
+            const int lo      = max(mystart, box[d]);
+            const int hi = min(mystart + (int)block_[d], box[d] + box[3 + d]);
+            assert(hi > lo);
+            file_offset[d] = lo - box[d];
+            mem_offset[d]  = lo - mystart;
+            count[d]       = hi - lo;
+        }
+
+        hid_t dset_id = H5Dopen2(
+            overlapping_files_[i], datasetname.c_str(), H5P_DEFAULT);
+        if (dset_id < 0)
+        {
+            (*MPIdata::serr) << "HDFrestart::readOverlappingBlocks() --- "
+                                "cannot open dataset "
+                             << datasetname << endl;
+            H5Sclose(memspace);
+            return -1;
+        }
+
+        hid_t filespace = H5Dget_space(dset_id);
+        herr_t status   = H5Sselect_hyperslab(
+            filespace, H5S_SELECT_SET, file_offset, NULL, count, NULL);
+        if (status >= 0)
+            status = H5Sselect_hyperslab(
+                memspace, H5S_SELECT_SET, mem_offset, NULL, count, NULL);
+        if (status >= 0)
+            status = H5Dread(
+                dset_id, memtype, memspace, filespace, H5P_DEFAULT, data);
+        H5Sclose(filespace);
+        H5Dclose(dset_id);
+        if (status < 0)
+        {
+            (*MPIdata::serr) << "HDFrestart::readOverlappingBlocks() --- "
+                                "reading "
+                             << datasetname << " failed!!!" << endl;
+            H5Sclose(memspace);
+            return -1;
+        }
+    }
+
+    H5Sclose(memspace);
+
+    return 0;
+}
+
 int writeListCentersAndRadii(
     hid_t dset_id, const unsigned natt, const vector<double>& attr_data)
 {
@@ -848,6 +1276,21 @@ int writeGids(hid_t dset_id, const vector<int>& gids)
     return natt;
 }
 
+int writeSparseBoxes(hid_t dset_id, const vector<int>& boxes)
+{
+    assert(dset_id >= -1);
+    assert(boxes.size() % 7 == 0);
+
+    const int nboxes = boxes.size() / 7;
+    if (nboxes <= 0) return 0;
+
+    std::string attname("List of sparse boxes");
+
+    mgmol_tools::addAttribute2Dataset(dset_id, attname.c_str(), boxes);
+
+    return nboxes;
+}
+
 int readListCentersAndRadii(hid_t dset_id, vector<double>& attr_data)
 {
     std::string attname("List of centers and radii");
@@ -981,6 +1424,59 @@ int readGids(hid_t dset_id, vector<int>& gids)
     return dims;
 }
 
+// returns number of boxes, 0 if dataset is not in sparse format
+int readSparseBoxes(hid_t dset_id, vector<int>& boxes)
+{
+    boxes.clear();
+
+    std::string attname("List of sparse boxes");
+    htri_t exists = H5Aexists(dset_id, attname.c_str());
+    if (exists < 0)
+    {
+        (*MPIdata::serr) << "H5Aexists() failed!!!" << endl;
+        return exists;
+    }
+    if (exists == 0) return 0;
+
+    hid_t attribute_id = H5Aopen_name(dset_id, attname.c_str());
+    if (attribute_id < 0)
+    {
+        (*MPIdata::serr) << "H5Aopen failed for " << attname << "!!!" << endl;
+        return -1;
+    }
+
+    hid_t attdataspace = H5Aget_space(attribute_id);
+    hsize_t dims;
+    hsize_t maxdims;
+    H5Sget_simple_extent_dims(attdataspace, &dims, &maxdims);
+    if (dims % 7 != 0)
+    {
+        (*MPIdata::serr) << "readSparseBoxes() --- wrong data size" << endl;
+        return -1;
+    }
+    boxes.resize(dims);
+    herr_t status = H5Aread(attribute_id, H5T_NATIVE_INT, &boxes[0]);
+    if (status < 0)
+    {
+        (*MPIdata::serr) << "H5Aread failed!!!" << endl;
+        return -1;
+    }
+    status = H5Sclose(attdataspace);
+    if (status < 0)
+    {
+        (*MPIdata::serr) << "H5Sclose failed!!!" << endl;
+        return -1;
+    }
+    status = H5Aclose(attribute_id);
+    if (status < 0)
+    {
+        (*MPIdata::serr) << "H5Aclose failed!!!" << endl;
+        return -1;
+    }
+
+    return dims / 7;
+}
+
 int HDFrestart::getLRCenters(std::multimap<std::string, Vector3D>& centers,
     const int n_max_centers, const std::string& name)
 {
@@ -1110,8 +1606,14 @@ int HDFrestart::getLRs(LocalizationRegions& lrs, const int max_nb_lrs,
 
     int nlrs               = 0;
     int color              = 0;
+    int ifile              = 0;
     int done               = 0;
     short attribute_length = 0;
+
+    // functions may be stored in several files
+    set<int> read_gids;
+
+    selectOverlappingFile(ifile);
     while (!done)
     {
         int dim = 0;
@@ -1133,7 +1635,16 @@ int HDFrestart::getLRs(LocalizationRegions& lrs, const int max_nb_lrs,
                 (*MPIdata::sout)
                     << "HDFrestart::getLRs(), Dataset " << datasetname
                     << " does not exists..." << endl;
-            done = 1;
+
+            // continue with next file overlapping local subdomain, if any
+            ifile++;
+            if (ifile < nOverlappingFiles())
+            {
+                selectOverlappingFile(ifile);
+                color = -1;
+            }
+            else
+                done = 1;
         }
         else
         {
@@ -1146,8 +1657,6 @@ int HDFrestart::getLRs(LocalizationRegions& lrs, const int max_nb_lrs,
 
             dim = natt * attribute_length;
 
-            nlrs += natt;
-
             readGids(dset_id, gids);
             assert(gids.size() == natt);
 
@@ -1175,7 +1684,8 @@ int HDFrestart::getLRs(LocalizationRegions& lrs, const int max_nb_lrs,
 
                 assert(!gids.empty());
                 assert(gids.size() > i);
-                lrs.push_back_local(center, rl, gids[i]);
+                if (read_gids.insert(gids[i]).second)
+                    lrs.push_back_local(center, rl, gids[i]);
 
 #ifdef DEBUG
                 (*MPIdata::sout) << setprecision(16);
@@ -1196,6 +1706,9 @@ int HDFrestart::getLRs(LocalizationRegions& lrs, const int max_nb_lrs,
 
     } // while !done
 
+    selectOverlappingFile(0);
+    nlrs = (int)read_gids.size();
+
     if (onpe0 && ct.verbose > 0)
         (*MPIdata::sout) << "HDFrestart::getLRs() --- Read " << nlrs
                          << " LRs from restart file on PE0" << endl;
@@ -1220,6 +1733,9 @@ int HDFrestart::read_1func_hdf5(double* vv, std::string datasetname)
 
     assert(block_[0] * block_[1] * block_[2] > 0);
 
+    if (redistributed_)
+        return readOverlappingBlocks(datasetname, H5T_NATIVE_DOUBLE, vv);
+
     if (active_)
     {
         hid_t plist_id = H5P_DEFAULT;
@@ -1366,6 +1882,9 @@ int HDFrestart::read_1func_hdf5(float* vv, std::string datasetname)
 
     assert(block_[0] * block_[1] * block_[2] > 0);
 
+    if (redistributed_)
+        return readOverlappingBlocks(datasetname, H5T_NATIVE_FLOAT, vv);
+
     if (active_)
     {
         hid_t plist_id = H5P_DEFAULT;
@@ -1702,7 +2221,20 @@ int HDFrestart::write_1func_hdf5(
 int HDFrestart::readData(
     double* data, hid_t memspace, hid_t dset_id, const short precision)
 {
-    if (active_)
+    if (redistributed_)
+    {
+        char name[1024];
+        H5Iget_name(dset_id, name, 1024);
+        int status;
+        if (precision == 1)
+            status = readOverlappingBlocks(
+                name, H5T_NATIVE_FLOAT, work_space_float_);
+        else
+            status = readOverlappingBlocks(
+                name, H5T_NATIVE_DOUBLE, work_space_double_);
+        if (status < 0) return status;
+    }
+    else if (active_)
     {
         hid_t plist_id = H5P_DEFAULT;
         herr_t status;
@@ -1819,7 +2351,15 @@ int HDFrestart::readData(
 {
     (void)precision;
 
-    if (active_)
+    if (redistributed_)
+    {
+        char name[1024];
+        H5Iget_name(dset_id, name, 1024);
+        const int status
+            = readOverlappingBlocks(name, H5T_NATIVE_FLOAT, work_space_float_);
+        if (status < 0) return status;
+    }
+    else if (active_)
     {
         hid_t plist_id = H5P_DEFAULT;
         herr_t status;
@@ -2311,6 +2851,10 @@ failed!!!"<<endl; return -1;
 */
 int HDFrestart::readAtomicNumbers(vector<int>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(
+            &HDFrestart::readAtomicNumbers, data, true);
+
     Control& ct = *(Control::instance());
     if (onpe0 && ct.verbose > 0)
     {
@@ -2377,6 +2921,9 @@ int HDFrestart::readAtomicNumbers(vector<int>& data)
 // version
 int HDFrestart::readAtomicIDs(vector<int>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(&HDFrestart::readAtomicIDs, data, true);
+
     Control& ct = *(Control::instance());
     if (onpe0 && ct.verbose > 0)
         (*MPIdata::sout) << "HDFrestart::readAtomicIDs()..." << endl;
@@ -2436,6 +2983,10 @@ int HDFrestart::readAtomicIDs(vector<int>& data)
 // version
 int HDFrestart::readAtomicNLprojIDs(vector<int>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(
+            &HDFrestart::readAtomicNLprojIDs, data, true);
+
     Control& ct = *(Control::instance());
     if (onpe0 && ct.verbose > 0)
         (*MPIdata::sout) << "HDFrestart::readAtomicNLprojIDs()..." << endl;
@@ -2495,6 +3046,10 @@ int HDFrestart::readAtomicNLprojIDs(vector<int>& data)
 
 int HDFrestart::readAtomicPositions(vector<double>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(
+            &HDFrestart::readAtomicPositions, data, true);
+
     if (onpe0)
         (*MPIdata::sout) << "Read ionic positions from hdf5 file" << endl;
 
@@ -2612,6 +3167,26 @@ int HDFrestart::readOldCenterOnMesh(vector<double>& data, int i)
 
 int HDFrestart::readOldCenter(vector<double>& data, int i)
 {
+    if (redistributed_)
+    {
+        // concatenate data of all the files overlapping local subdomain,
+        // in the same order as readGidsList()
+        data.clear();
+        redistributed_ = false;
+        int ret        = 0;
+        for (unsigned j = 0; j < overlapping_files_.size(); j++)
+        {
+            file_id_ = overlapping_files_[j];
+            vector<double> fdata;
+            ret = min(ret, readOldCenter(fdata, i));
+            data.insert(data.end(), fdata.begin(), fdata.end());
+        }
+        file_id_       = overlapping_files_[0];
+        redistributed_ = true;
+
+        return ret;
+    }
+
     if (onpe0)
         (*MPIdata::sout) << "Read old localization centers from hdf5 file"
                          << endl;
@@ -2671,6 +3246,9 @@ int HDFrestart::readOldCenter(vector<double>& data, int i)
 
 int HDFrestart::readGidsList(vector<int>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(&HDFrestart::readGidsList, data, false);
+
     if (onpe0) (*MPIdata::sout) << "Read list of gids from hdf5 file" << endl;
 
     if (active_)
@@ -2724,6 +3302,10 @@ int HDFrestart::readGidsList(vector<int>& data)
 
 int HDFrestart::readAtomicVelocities(vector<double>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(
+            &HDFrestart::readAtomicVelocities, data, true);
+
     if (onpe0)
         (*MPIdata::sout) << "Read atomic velocities from hdf5 file" << endl;
 
@@ -2775,6 +3357,10 @@ int HDFrestart::readAtomicVelocities(vector<double>& data)
 
 int HDFrestart::readLockedAtomNames(std::vector<std::string>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(
+            &HDFrestart::readLockedAtomNames, data, false);
+
     if (onpe0)
         (*MPIdata::sout) << "HDFrestart::readLockedAtomNames()..." << endl;
 
@@ -2864,6 +3450,10 @@ int HDFrestart::readLockedAtomNames(std::vector<std::string>& data)
 
 int HDFrestart::readAtomicNames(std::vector<std::string>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(
+            &HDFrestart::readAtomicNames, data, true);
+
     Control& ct = *(Control::instance());
     if (onpe0 && ct.verbose > 0)
         (*MPIdata::sout) << "HDFrestart::readAtomicNames()..." << endl;
@@ -2968,6 +3558,10 @@ int HDFrestart::readAtomicNames(std::vector<std::string>& data)
 
 int HDFrestart::readRestartRandomStates(vector<unsigned short>& data)
 {
+    if (redistributed_)
+        return readFromOverlappingFiles(
+            &HDFrestart::readRestartRandomStates, data, true);
+
     if (onpe0)
         (*MPIdata::sout) << "Read atomic RandomStates from hdf5 file" << endl;
     data.clear();
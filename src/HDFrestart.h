@@ -45,6 +45,10 @@ int readGids(hid_t dset_id, std::vector<int>& gids);
 int writeListCentersAndRadii(
     hid_t dset_id, const unsigned natt, const std::vector<double>& attr_data);
 int writeGids(hid_t dset_id, const std::vector<int>& gids);
+// sparse orbitals layout: for each function stored in a dataset,
+// gid, global start index (3) and extents (3) of its box
+int readSparseBoxes(hid_t dset_id, std::vector<int>& boxes);
+int writeSparseBoxes(hid_t dset_id, const std::vector<int>& boxes);
 
 class HDFrestart
 {
@@ -86,7 +90,30 @@ class HDFrestart
     // MPI communicator for all tasks having data to write
     MPI_Comm comm_data_;
 
+    // true when reading files (1 file/task) written with a different
+    // decomposition than the current one
+    bool redistributed_;
+
+    // files written by other decomposition overlapping local subdomain,
+    // and their subdomains (global start index (3) and extents (3))
+    std::vector<hid_t> overlapping_files_;
+    std::vector<int> overlapping_boxes_;
+
+    // for each overlapping file, atoms read by this task
+    std::vector<std::vector<bool>> atoms_selection_;
+
     void appendTaskNumberToFilename();
+    void writeDecomposition();
+    bool readDecomposition(const std::string& dirname, std::vector<int>& boxes);
+    void openOverlappingFiles(
+        const std::string& dirname, const std::vector<int>& boxes);
+    void setupAtomsSelection();
+    bool isAtomSelected(const double tau[3], const int* const box) const;
+    template <typename T>
+    int readFromOverlappingFiles(int (HDFrestart::*read)(std::vector<T>&),
+        std::vector<T>& data, const bool atomic_data);
+    int readOverlappingBlocks(
+        const std::string& datasetname, hid_t memtype, void* data);
     void setActivity();
     void setupBlocks();
     void setOptions(const short option_number);
@@ -108,6 +135,18 @@ public:
 
     bool gatherDataX() const { return gather_data_x_; }
     bool useHdf5p() const { return use_hdf5p_; }
+    bool redistributed() const { return redistributed_; }
+
+    // number of files to read data of local subdomain from
+    int nOverlappingFiles() const
+    {
+        return redistributed_ ? (int)overlapping_files_.size() : 1;
+    }
+    // make file i the one accessed by file_id() and datasets functions
+    void selectOverlappingFile(const int i)
+    {
+        if (redistributed_) file_id_ = overlapping_files_[i];
+    }
 
     hid_t open_dset(const std::string datasetname) const
     {
@@ -109,39 +109,24 @@ void Hamiltonian<T>::applyLocal(const int first_state, const int ncolors,
     {
         pb::GridFunc<POTDTYPE> gfpot(mygrid, ct.bc[0], ct.bc[1], ct.bc[2]);
         gfpot.assign(vtot);
-        if (ct.Mehrstellen()) gfpot.trade_boundaries();
-        const vector<vector<int>>& gid(phi.getOverlappingGids());
-        pb::GridFuncVector<ORBDTYPE> gfvw1(
-            false, mygrid, ct.bc[0], ct.bc[1], ct.bc[2], gid);
-        pb::GridFuncVector<ORBDTYPE> gfvw2(
-            false, mygrid, ct.bc[0], ct.bc[1], ct.bc[2], gid);
-        // if( onpe0 )(*MPIdata::sout)<<"Hamiltonian<T>::applyLocal,
-        // index="<<phi.getIterativeIndex()<<endl;
-        for (int i = 0; i < ncolors; i++)
-        {
-            pb::GridFunc<ORBDTYPE>* gfw = new pb::GridFunc<ORBDTYPE>(
-                mygrid, ct.bc[0], ct.bc[1], ct.bc[2]);
-            gfvw1.push_back(gfw);
-            gfvw2.push_back(&phi.getFuncWithGhosts(first_state + i));
-        }
-        gfvw1.prod(gfvw2, gfpot);
-
-        pb::GridFunc<ORBDTYPE> gf_work1(mygrid, ct.bc[0], ct.bc[1], ct.bc[2]);
-        pb::GridFunc<ORBDTYPE> gf_work2(mygrid, ct.bc[0], ct.bc[1], ct.bc[2]);
-        for (int i = 0; i < ncolors; i++)
-        {
-            // work1 = B*V*psi
-            lapOper_->rhs(gfvw1.func(i), gf_work1);
-
-            // work2 = -Lap*phi
-            lapOper_->apply(phi.getFuncWithGhosts(first_state + i), gf_work2);
+        gfpot.trade_boundaries();
 
-            gf_work1 += gf_work2;
-            hphi.setPsi(gf_work1, i + first_state);
-        }
-        for (int i = 0; i < ncolors; i++)
+        // hphi = -Lap*phi + B*V*phi in one pass per function,
+        // V*phi being computed on the fly in thread private work array
+        const int wsize = lapOper_->sizeMehrWithPotWork();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
         {
-            delete &gfvw1.func(i);
+            vector<ORBDTYPE> work(wsize);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for (int i = 0; i < ncolors; i++)
+            {
+                lapOper_->applyWithPot(phi.getFuncWithGhosts(first_state + i),
+                    gfpot, hphi.getPsi(i + first_state), &work[0]);
+            }
         }
     }
     else
@@ -0,0 +1,365 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "ImagesEnsemble.h"
+#include "Control.h"
+#include "ExtendedGridOrbitals.h"
+#include "LocGridOrbitals.h"
+#include "MGmol_MPI.h"
+#include "MPIdata.h"
+#include "Mesh.h"
+
+#include <cmath>
+#include <iomanip>
+
+using namespace std;
+
+template <class T>
+ImagesEnsemble<T>::ImagesEnsemble(
+    MGmol<T>& strategy, Ions& ions, std::ostream& os)
+    : mgmol_strategy_(strategy), ions_(ions), os_(os)
+{
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+    Control& ct = *(Control::instance());
+
+    nimages_ = mmpi.nimages();
+    myimage_ = mmpi.myimage();
+    assert(nimages_ > 1);
+
+    const pb::Grid& mygrid = Mesh::instance()->grid();
+    for (short d = 0; d < 3; d++)
+    {
+        ll_[d] = mygrid.ll(d);
+        bc_[d] = ct.bcPoisson[d];
+    }
+
+    energies_.resize(nimages_, 0.);
+    times_.resize(nimages_, 0.);
+
+    // number of MPI tasks of each image
+    vector<int> ntasks(1, mmpi.size());
+    ntasks_.resize(nimages_);
+    if (mmpi.instancePE0()) mmpi.allGatherImages(ntasks, ntasks_);
+    mmpi.bcast(&ntasks_[0], nimages_);
+}
+
+// NEB end points do not move
+template <class T>
+bool ImagesEnsemble<T>::fixedImage() const
+{
+    Control& ct = *(Control::instance());
+    return (ct.images_method == 1
+            && (myimage_ == 0 || myimage_ == nimages_ - 1));
+}
+
+// minimum image convention in periodic directions
+template <class T>
+double ImagesEnsemble<T>::displacement(const double d, const short dir) const
+{
+    if (bc_[dir] != 1) return d;
+    return d - ll_[dir] * floor(d / ll_[dir] + 0.5);
+}
+
+template <class T>
+void ImagesEnsemble<T>::exchangeEnergies(const double energy, const double time)
+{
+    exchange_tm_.start();
+
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+
+    vector<double> data(2);
+    data[0] = energy;
+    data[1] = time;
+    vector<double> gdata(2 * nimages_);
+    if (mmpi.instancePE0()) mmpi.allGatherImages(data, gdata);
+    mmpi.bcast(&gdata[0], 2 * nimages_);
+
+    for (int i = 0; i < nimages_; i++)
+    {
+        energies_[i] = gdata[2 * i];
+        times_[i] += gdata[2 * i + 1];
+    }
+
+    exchange_tm_.stop();
+}
+
+// Henkelman and Jonsson, J. Chem. Phys. 113, 9978 (2000)
+template <class T>
+void ImagesEnsemble<T>::computeNEBforces(const vector<double>& gtau,
+    const vector<double>& forces, vector<double>& neb_forces)
+{
+    Control& ct = *(Control::instance());
+
+    const int n = (int)forces.size();
+    assert((int)gtau.size() == n * nimages_);
+    assert(!fixedImage());
+
+    const double* const tau  = &gtau[myimage_ * n];
+    const double* const taum = tau - n;
+    const double* const taup = tau + n;
+
+    // displacements to next and from previous images
+    vector<double> dp(n);
+    vector<double> dm(n);
+    double normp = 0.;
+    double normm = 0.;
+    for (int j = 0; j < n; j++)
+    {
+        dp[j] = displacement(taup[j] - tau[j], j % 3);
+        dm[j] = displacement(tau[j] - taum[j], j % 3);
+        normp += dp[j] * dp[j];
+        normm += dm[j] * dm[j];
+    }
+    normp = sqrt(normp);
+    normm = sqrt(normm);
+
+    // tangent along the path
+    const double e  = energies_[myimage_];
+    const double ep = energies_[myimage_ + 1];
+    const double em = energies_[myimage_ - 1];
+    double wp       = 0.;
+    double wm       = 0.;
+    if (ep > e && e > em)
+    {
+        wp = 1.;
+    }
+    else if (ep < e && e < em)
+    {
+        wm = 1.;
+    }
+    else
+    {
+        const double demax = max(fabs(ep - e), fabs(em - e));
+        const double demin = min(fabs(ep - e), fabs(em - e));
+        wp                 = (ep > em) ? demax : demin;
+        wm                 = (ep > em) ? demin : demax;
+    }
+    vector<double> tangent(n);
+    double norm = 0.;
+    for (int j = 0; j < n; j++)
+    {
+        tangent[j] = wp * dp[j] + wm * dm[j];
+        norm += tangent[j] * tangent[j];
+    }
+    norm = sqrt(norm);
+    if (norm > 0.)
+        for (int j = 0; j < n; j++)
+            tangent[j] /= norm;
+
+    double fdott = 0.;
+    for (int j = 0; j < n; j++)
+        fdott += forces[j] * tangent[j];
+
+    // climbing image: highest energy interior image
+    bool climbing = (ct.images_climbing > 0);
+    for (int i = 1; i < nimages_ - 1; i++)
+        if (energies_[i] > e) climbing = false;
+
+    neb_forces.resize(n);
+    if (climbing)
+    {
+        // invert force component along the path
+        for (int j = 0; j < n; j++)
+            neb_forces[j] = forces[j] - 2. * fdott * tangent[j];
+    }
+    else
+    {
+        // perpendicular component of force + spring force along the path
+        const double fspring = ct.images_spring_constant * (normp - normm);
+        for (int j = 0; j < n; j++)
+            neb_forces[j] = forces[j] + (fspring - fdott) * tangent[j];
+    }
+}
+
+template <class T>
+void ImagesEnsemble<T>::setNEBforces()
+{
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+
+    const int n = 3 * ions_.getNumIons();
+
+    // positions and (unmodified) forces of all atoms on root of each image
+    vector<double> tau;
+    vector<double> forces;
+    ions_.gatherPositions(tau, 0);
+    ions_.gatherForces(forces, 0);
+
+    exchange_tm_.start();
+    vector<double> gtau(n * nimages_);
+    if (mmpi.instancePE0()) mmpi.allGatherImages(tau, gtau);
+    exchange_tm_.stop();
+
+    if (fixedImage()) return;
+
+    vector<double> neb_forces(n, 0.);
+    if (mmpi.instancePE0()) computeNEBforces(gtau, forces, neb_forces);
+    mmpi.bcast(&neb_forces[0], n);
+
+    // set forces of local ions
+    const vector<Ion*>& local_ions(ions_.local_ions());
+    vector<vector<double>> f(local_ions.size(), vector<double>(3));
+    for (unsigned i = 0; i < local_ions.size(); i++)
+    {
+        const int index = local_ions[i]->index();
+        for (short d = 0; d < 3; d++)
+            f[i][d] = neb_forces[3 * index + d];
+    }
+    mgmol_strategy_.geomOptimSetForces(f);
+}
+
+template <class T>
+bool ImagesEnsemble<T>::allConverged(const bool conv)
+{
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+
+    double flag = conv ? 1. : 0.;
+    if (mmpi.instancePE0()) mmpi.allreduceImages(&flag, 1, MPI_MIN);
+    mmpi.bcast(&flag, 1);
+
+    return (flag > 0.5);
+}
+
+template <class T>
+void ImagesEnsemble<T>::printEnergies(const int step) const
+{
+    if (!onpe0) return;
+
+    os_ << "%%  " << step << "  IMAGES ENERGIES:" << endl;
+    for (int i = 0; i < nimages_; i++)
+        os_ << "    image " << setw(3) << i << setprecision(8) << fixed
+            << setw(20) << energies_[i] << setw(16)
+            << energies_[i] - energies_[0] << endl;
+}
+
+// number of MPI tasks per image proportional to measured work
+template <class T>
+void ImagesEnsemble<T>::printRecommendedTasks() const
+{
+    if (!onpe0) return;
+
+    int ntotal    = 0;
+    double wtotal = 0.;
+    double tmax   = 0.;
+    double tsum   = 0.;
+    vector<double> work(nimages_);
+    for (int i = 0; i < nimages_; i++)
+    {
+        work[i] = times_[i] * (double)ntasks_[i];
+        wtotal += work[i];
+        ntotal += ntasks_[i];
+        tmax = max(tmax, times_[i]);
+        tsum += times_[i];
+    }
+    if (wtotal <= 0.) return;
+
+    vector<int> ntasks(nimages_);
+    int nassigned = 0;
+    int imax      = 0;
+    for (int i = 0; i < nimages_; i++)
+    {
+        ntasks[i] = max(1, (int)floor(ntotal * work[i] / wtotal + 0.5));
+        nassigned += ntasks[i];
+        if (work[i] > work[imax]) imax = i;
+    }
+    // adjust most expensive image so that all tasks are used
+    ntasks[imax] += ntotal - nassigned;
+    if (ntasks[imax] < 1) return;
+
+    os_ << "Images load imbalance (max/average time) = " << setprecision(3)
+        << fixed << tmax * nimages_ / tsum << endl;
+    os_ << "Recommended Images.tasks =";
+    for (int i = 0; i < nimages_; i++)
+        os_ << " " << ntasks[i];
+    os_ << endl;
+}
+
+template <class T>
+void ImagesEnsemble<T>::run()
+{
+    Control& ct = *(Control::instance());
+
+    // NEB forces are not derived from an energy
+    if (ct.images_method == 1 && ct.AtomsDynamic() != AtomsDynamicType::FIRE)
+    {
+        (*MPIdata::serr) << "ImagesEnsemble: NEB requires FIRE for atoms "
+                            "dynamics"
+                         << endl;
+        ct.global_exit(2);
+    }
+
+    if (onpe0)
+        os_ << "Run " << nimages_ << " images concurrently, method "
+            << (ct.images_method == 1 ? "NEB" : "independent") << endl;
+
+    double t0 = MPI_Wtime();
+    mgmol_strategy_.geomOptimSetup();
+    double time = MPI_Wtime() - t0;
+
+    bool moved = true;
+    for (int steps = 1; steps <= ct.num_MD_steps; steps++)
+    {
+        // no new electronic structure for images that have not moved
+        if (moved)
+        {
+            t0 = MPI_Wtime();
+            mgmol_strategy_.geomOptimQuench();
+            mgmol_strategy_.geomOptimComputeForces();
+            time += MPI_Wtime() - t0;
+        }
+
+        exchangeEnergies(mgmol_strategy_.getTotalEnergy(), time);
+        time = 0.;
+
+        if (ct.images_method == 1) setNEBforces();
+
+        const bool conv = fixedImage()
+                          || mgmol_strategy_.geomOptimCheckTolForces(
+                                 ct.tol_forces);
+
+        printEnergies(steps);
+
+        if (allConverged(conv))
+        {
+            if (onpe0)
+                os_ << "ImagesEnsemble: convergence in forces has been "
+                       "achieved for all images"
+                    << endl;
+            break;
+        }
+
+        moved = !conv;
+        if (moved) mgmol_strategy_.geomOptimRun1Step();
+
+        // each image writes its own restart file (see suffix in main.cc)
+        if (ct.checkpoint && ct.out_restart_file != "0")
+            if (ct.out_restart_info > 0)
+                if ((steps % ct.checkpoint) == 0 && steps < ct.num_MD_steps)
+                {
+                    mgmol_strategy_.geomOptimDumpRestart();
+                }
+    }
+
+    // final dump (not done by MGmol::cleanup() when atoms move)
+    if (ct.out_restart_info > 0)
+    {
+        mgmol_strategy_.geomOptimDumpRestart();
+    }
+
+    printRecommendedTasks();
+}
+
+template <class T>
+void ImagesEnsemble<T>::printTimers(ostream& os)
+{
+    exchange_tm_.print(os);
+}
+
+template class ImagesEnsemble<LocGridOrbitals>;
+template class ImagesEnsemble<ExtendedGridOrbitals>;
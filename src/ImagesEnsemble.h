@@ -0,0 +1,75 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_IMAGESENSEMBLE_H
+#define MGMOL_IMAGESENSEMBLE_H
+
+#include "Ions.h"
+#include "MGmol.h"
+#include "Timer.h"
+
+#include <iostream>
+#include <vector>
+
+// Concurrent geometry optimization of an ensemble of images
+// (configurations of the same atomic system), each image being computed
+// by its own group of MPI tasks (see MGmol_MPI::setupComm).
+// Images exchange only energies, positions and forces, in memory.
+// With the NEB method, forces on interior images are replaced by nudged
+// elastic band forces (improved tangent estimate), and the two end points
+// are kept fixed. Otherwise images are relaxed independently.
+template <class T>
+class ImagesEnsemble
+{
+private:
+    MGmol<T>& mgmol_strategy_;
+    Ions& ions_;
+    std::ostream& os_;
+
+    int nimages_;
+    int myimage_;
+
+    // cell dimensions, for minimum image displacements
+    double ll_[3];
+    short bc_[3];
+
+    // energy of each image
+    std::vector<double> energies_;
+
+    // accumulated time spent by each image in quench and forces
+    std::vector<double> times_;
+
+    // number of MPI tasks of each image
+    std::vector<int> ntasks_;
+
+    static Timer exchange_tm_;
+
+    bool fixedImage() const;
+    double displacement(const double d, const short dir) const;
+    void exchangeEnergies(const double energy, const double time);
+    void computeNEBforces(const std::vector<double>& gtau,
+        const std::vector<double>& forces, std::vector<double>& neb_forces);
+    void setNEBforces();
+    bool allConverged(const bool conv);
+    void printEnergies(const int step) const;
+    void printRecommendedTasks() const;
+
+public:
+    ImagesEnsemble(MGmol<T>& strategy, Ions& ions, std::ostream& os);
+
+    void run();
+
+    static void printTimers(std::ostream& os);
+};
+
+template <class T>
+Timer ImagesEnsemble<T>::exchange_tm_("ImagesEnsemble::exchange");
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "IncrementalGram.h"
+#include "mputils.h"
+
+#include <cassert>
+#include <cstring>
+
+using namespace std;
+
+Timer IncrementalGram::update_tm_("IncrementalGram::update");
+
+void IncrementalGram::reset()
+{
+    valid_ = false;
+    modified_.clear();
+}
+
+void IncrementalGram::compute(const int n, const int nfunc,
+    const ORBDTYPE* const psi, const int ld, MATDTYPE* const gram)
+{
+    assert(n <= ld);
+
+    if (n != n_ || nfunc != nfunc_) valid_ = false;
+    n_        = n;
+    nfunc_    = nfunc;
+    nupdated_ = 0;
+    if (nfunc == 0)
+    {
+        modified_.clear();
+        return;
+    }
+
+    // list of functions modified since last call
+    vector<int> modified;
+    for (set<int>::const_iterator it = modified_.begin();
+         it != modified_.end(); ++it)
+    {
+        assert(*it >= 0);
+        if (*it < nfunc) modified.push_back(*it);
+    }
+    modified_.clear();
+
+    const int nmod = valid_ ? (int)modified.size() : nfunc;
+
+    // recompute full matrix if more than half of the functions changed
+    if (2 * nmod > nfunc)
+    {
+        gram_.resize(nfunc * nfunc);
+
+        MPsyrk('l', 't', nfunc, n, 1., psi, ld, 0., &gram_[0], nfunc);
+
+        // fill upper triangular part
+        for (int j = 0; j < nfunc; j++)
+            for (int i = j + 1; i < nfunc; i++)
+                gram_[i * nfunc + j] = gram_[j * nfunc + i];
+    }
+    else if (nmod > 0)
+    {
+        update_tm_.start();
+
+        // pack modified functions into contiguous array
+        vector<ORBDTYPE> work((size_t)n * nmod);
+        for (int k = 0; k < nmod; k++)
+            memcpy(&work[(size_t)k * n], psi + (size_t)modified[k] * ld,
+                n * sizeof(ORBDTYPE));
+
+        // rows of Gram matrix associated with modified functions
+        vector<MATDTYPE> rows(nmod * nfunc);
+        MPgemm('t', 'n', nmod, nfunc, n, 1., &work[0], n, psi, ld, 0.,
+            &rows[0], nmod);
+
+        // update rows and columns by symmetry
+        for (int k = 0; k < nmod; k++)
+        {
+            const int i = modified[k];
+            for (int j = 0; j < nfunc; j++)
+            {
+                const MATDTYPE val   = rows[j * nmod + k];
+                gram_[j * nfunc + i] = val;
+                gram_[i * nfunc + j] = val;
+            }
+        }
+
+        update_tm_.stop();
+    }
+
+    valid_    = true;
+    nupdated_ = nmod;
+
+    memcpy(gram, &gram_[0], nfunc * nfunc * sizeof(MATDTYPE));
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_INCREMENTALGRAM_H
+#define MGMOL_INCREMENTALGRAM_H
+
+#include "Timer.h"
+#include "global.h"
+
+#include <set>
+#include <vector>
+
+// Computes the Gram matrix of a set of functions, reusing the results of
+// the previous call for the functions that have not been modified since.
+// Modified functions have to be declared explicitly with setModified().
+// Only the rows/columns of the Gram matrix associated with modified
+// functions are recomputed, with one product with all the functions.
+class IncrementalGram
+{
+private:
+    static Timer update_tm_;
+
+    // size of functions and number of functions
+    int n_;
+    int nfunc_;
+
+    // true if gram_ holds the Gram matrix of the functions at last call
+    bool valid_;
+
+    // Gram matrix (full storage) computed at last call
+    std::vector<MATDTYPE> gram_;
+
+    // indexes of functions modified since last call
+    std::set<int> modified_;
+
+    // number of functions recomputed at last call
+    int nupdated_;
+
+public:
+    IncrementalGram() : n_(0), nfunc_(0), valid_(false), nupdated_(0) {}
+
+    // gram <- psi^T*psi for nfunc functions of size n
+    // stored in psi with leading dimension ld
+    void compute(const int n, const int nfunc, const ORBDTYPE* const psi,
+        const int ld, MATDTYPE* const gram);
+
+    // declare function i modified since last call
+    void setModified(const int i) { modified_.insert(i); }
+
+    // force complete recomputation at next call
+    void reset();
+
+    int nupdated() const { return nupdated_; }
+
+    static void printTimers(std::ostream& os) { update_tm_.print(os); }
+};
+
+#endif
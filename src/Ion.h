@@ -98,6 +98,12 @@ public:
     void setup();
 
     std::shared_ptr<KBprojector> kbproj() { return kbproj_; }
+    // reuse projector of a previous instance of the same ion
+    // (updated incrementally in setup())
+    void setKBprojector(std::shared_ptr<KBprojector> kbproj)
+    {
+        kbproj_ = kbproj;
+    }
     const std::shared_ptr<KBprojector> kbproj() const { return kbproj_; }
 
     double radiusNLproj() const { return kbproj_->maxRadius(); }
@@ -190,15 +196,11 @@ public:
         position_[0] = x;
         position_[1] = y;
         position_[2] = z;
-
-        kbproj_->clear();
     }
     void shiftPositionXLBOMDTest(Vector3D shift)
     {
         for (short dir = 0; dir < 3; dir++)
             shift_position(dir, shift[dir]);
-
-        kbproj_->clear();
     }
     void shiftPosition(const double shift[3])
     {
@@ -207,6 +207,17 @@ int IonicStepper::writeVelocities(HDFrestart& h5f_file) const
 int IonicStepper::readAtomicFields(
     HDFrestart& h5f_file, vector<double>& data, const string name)
 {
+    // fields for all the atoms are written by one task only, in its
+    // own file: they cannot be recovered from the overlapping files
+    // of a different decomposition
+    if (h5f_file.redistributed())
+    {
+        (*MPIdata::serr) << "IonicStepper: cannot read " << name
+                         << " from restart files written with a different"
+                         << " decomposition" << endl;
+        return -1;
+    }
+
     hid_t file_id = h5f_file.file_id();
 
     // Open the dataset
@@ -8,6 +8,7 @@
 // This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
 // Please also read this link https://github.com/llnl/mgmol/LICENSE
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <iterator>
@@ -93,16 +94,11 @@ Ions::Ions(const double lat[3], const vector<Species>& sp) : species_(sp)
     Mesh* mymesh             = Mesh::instance();
     const pb::PEenv& myPEenv = mymesh->peenv();
 
-    for (short i = 0; i < 3; i++)
-        div_lattice_[i] = lattice_[i] / (double)(myPEenv.n_mpi_task(i));
-
-    double offset[3] = { (double)myPEenv.my_mpi(0) * div_lattice_[0],
-        (double)myPEenv.my_mpi(1) * div_lattice_[1],
-        (double)myPEenv.my_mpi(2) * div_lattice_[2] };
+    const pb::Grid& mygrid   = mymesh->grid();
 
+    // local subdomain size (possibly different on each task)
     for (short i = 0; i < 3; i++)
-        if (myPEenv.n_mpi_task(i) == (myPEenv.my_mpi(i) + 1))
-            div_lattice_[i] = lattice_[i] - offset[i];
+        div_lattice_[i] = (double)mygrid.dim(i) * mygrid.hgrid(i);
 
     // save cartesian communicator info
     cart_comm_     = myPEenv.cart_comm();
@@ -3176,7 +3172,7 @@ void Ions::setupListIonsBoundaries(const double rmax)
 
     double offset[3];
     for (short i = 0; i < 3; i++)
-        offset[i] = (double)myPEenv.my_mpi(i) * div_lattice_[i];
+        offset[i] = (double)mygrid.istart(i) * mygrid.hgrid(i);
 
     const double origin[3]
         = { mygrid.origin(0), mygrid.origin(1), mygrid.origin(2) };
@@ -3218,11 +3214,17 @@ void Ions::setupListIonsBoundaries(const double rmax)
     domain[1] = mygrid.ll(1);
     domain[2] = mygrid.ll(2);
 
-    /* compute processor width info */
+    /* compute processor width info (smallest subdomain) */
     double proc_width[3];
-    proc_width[0] = domain[0] / nproc_xyz[0];
-    proc_width[1] = domain[1] / nproc_xyz[1];
-    proc_width[2] = domain[2] / nproc_xyz[2];
+    for (short i = 0; i < 3; i++)
+    {
+        const std::vector<unsigned>& partition(mygrid.partition(i));
+        proc_width[i]
+            = (partition.empty())
+                  ? domain[i] / nproc_xyz[i]
+                  : (double)(*min_element(partition.begin(), partition.end()))
+                        * mygrid.hgrid(i);
+    }
 
     /* compute left and right steps in xyz directions */
     /* x-direction */
@@ -3286,13 +3288,12 @@ bool Ions::inListIons(const double x, const double y, const double z)
 bool Ions::inLocalIons(const double x, const double y, const double z)
 {
     //cout<<"inLocalIons..."<<endl;
-    Mesh* mymesh             = Mesh::instance();
-    const pb::PEenv& myPEenv = mymesh->peenv();
-    const pb::Grid& mygrid   = mymesh->grid();
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
 
     double offset[3];
     for (short i = 0; i < 3; i++)
-        offset[i] = (double)myPEenv.my_mpi(i) * div_lattice_[i];
+        offset[i] = (double)mygrid.istart(i) * mygrid.hgrid(i);
 
     const double origin[3]
         = { mygrid.origin(0), mygrid.origin(1), mygrid.origin(2) };
@@ -3352,6 +3353,83 @@ void Ions::computeNumIons(void)
     mmpi.allreduce(&num_ions_, 1, MPI_SUM);
 }
 
+void Ions::printRecommendedMeshPartition(
+    std::ostream& os, const unsigned granularity) const
+{
+    Mesh* mymesh             = Mesh::instance();
+    const pb::Grid& mygrid   = mymesh->grid();
+    const pb::PEenv& myPEenv = mymesh->peenv();
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+
+    const char* const keys[3]
+        = { "Mesh.partition_x", "Mesh.partition_y", "Mesh.partition_z" };
+
+    for (short d = 0; d < 3; d++)
+    {
+        const int ntasks = myPEenv.n_mpi_task(d);
+        const int n      = mygrid.gdim(d);
+        if (ntasks == 1 || n % granularity != 0
+            || n < ntasks * (int)granularity)
+            continue;
+
+        // number of ions in each plane of mesh points
+        std::vector<double> weights(n, 0.);
+        for (vector<Ion*>::const_iterator iion = local_ions_.begin();
+             iion != local_ions_.end(); ++iion)
+        {
+            double x = (*iion)->position(d) - mygrid.origin(d);
+            x -= floor(x / lattice_[d]) * lattice_[d];
+            int i = (int)(x / mygrid.hgrid(d));
+            if (i >= n) i = n - 1;
+            weights[i] += 1.;
+        }
+        mmpi.allreduce(&weights[0], n, MPI_SUM);
+
+        // half of the cost is assumed proportional to the number of
+        // mesh points, the other half to the number of ions
+        double nions = 0.;
+        for (int i = 0; i < n; i++)
+            nions += weights[i];
+        const double background = (nions > 0.) ? nions / (double)n : 1.;
+        for (int i = 0; i < n; i++)
+            weights[i] += background;
+
+        std::vector<unsigned> sizes;
+        pb::Grid::bisectWeights(weights, ntasks, granularity, sizes);
+
+        // ratio max/average of weights for uniform and recommended
+        // partitions
+        const double average = (nions + n * background) / (double)ntasks;
+        double wmax_uniform  = 0.;
+        double wmax          = 0.;
+        int offset           = 0;
+        for (int j = 0; j < ntasks; j++)
+        {
+            double wuniform = 0.;
+            for (int i = j * n / ntasks; i < (j + 1) * n / ntasks; i++)
+                wuniform += weights[i];
+            wmax_uniform = max(wmax_uniform, wuniform);
+
+            double w = 0.;
+            for (unsigned i = 0; i < sizes[j]; i++)
+                w += weights[offset + i];
+            wmax = max(wmax, w);
+            offset += sizes[j];
+        }
+
+        if (onpe0)
+        {
+            os << "Recommended " << keys[d] << "=";
+            for (int j = 0; j < ntasks; j++)
+                os << " " << sizes[j];
+            os << endl;
+            os << "   load imbalance (max/average): uniform "
+               << wmax_uniform / average << ", recommended " << wmax / average
+               << endl;
+        }
+    }
+}
+
 double Ions::getMaxListRadius() const
 {
     // get radius of projectors
@@ -3585,10 +3663,12 @@ void Ions::updateListIons()
 
     // First cleanup list_ions_
     local_ions_.clear();
-    // delete current ions from list
+    // delete current ions from list, keeping their projectors
+    kbproj_cache_.clear();
     vector<Ion*>::iterator ion = list_ions_.begin();
     while (ion != list_ions_.end())
     {
+        kbproj_cache_[(*ion)->index()] = (*ion)->kbproj();
         delete *ion;
         ion++;
     }
@@ -3633,6 +3713,9 @@ void Ions::updateListIons()
 
     // clear ions_data_
     ions_data_.clear();
+
+    // release projectors of ions no longer in list
+    kbproj_cache_.clear();
 }
 
 void Ions::addIon2Lists(const IonData& data)
@@ -3642,6 +3725,15 @@ void Ions::addIon2Lists(const IonData& data)
     {
         Ion* newion = new Ion(getSpecies(data.atomic_num), data);
 
+        // reuse projector data of previous instance of this ion
+        std::map<int, std::shared_ptr<KBprojector>>::iterator kbp
+            = kbproj_cache_.find(data.index);
+        if (kbp != kbproj_cache_.end())
+        {
+            newion->setKBprojector(kbp->second);
+            kbproj_cache_.erase(kbp);
+        }
+
         // update list_ions_
         list_ions_.push_back(newion);
 
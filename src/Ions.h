@@ -45,6 +45,10 @@ class Ions
     std::vector<Ion*> overlappingVL_ions_; // with local potential overlapping
                                            // local sub-domain
 
+    // KB projectors of ions in list before update, by ion index,
+    // handed over to new instances of the same ions in updateListIons()
+    std::map<int, std::shared_ptr<KBprojector>> kbproj_cache_;
+
     double lattice_[3];
     double div_lattice_[3];
 
@@ -136,10 +140,6 @@ class Ions
 
     void gatherNames(std::map<int, std::string>& names, const int root,
         const MPI_Comm comm) const;
-    void gatherPositions(
-        std::vector<double>& positions, const int root = 0) const;
-    void gatherForces(std::vector<double>& forces, const int root = 0) const;
-
     void gatherNames(
         std::vector<std::string>& names, const int root, const MPI_Comm comm) const;
     void gatherPositions(
@@ -206,6 +206,11 @@ public:
     void printForcesLocal(std::ostream& os, const int root = 0) const;
     void printForcesGlobal(std::ostream& os, const int root = 0) const;
     int getNumIons(void);
+
+    // print a partition of the mesh balancing the number of ions and
+    // mesh points per task, with sizes multiple of granularity
+    void printRecommendedMeshPartition(
+        std::ostream& os, const unsigned granularity) const;
     int getNumLocIons(void) const { return local_ions_.size(); }
     int getNumListIons(void) const { return list_ions_.size(); }
     std::vector<Ion*>& local_ions() { return local_ions_; }
@@ -270,6 +275,11 @@ public:
     void setPositionsToTau0();
 
     void getPositions(std::vector<double>& tau) const;
+
+    // positions and forces of all ions, ordered by index, on task root
+    void gatherPositions(
+        std::vector<double>& positions, const int root = 0) const;
+    void gatherForces(std::vector<double>& forces, const int root = 0) const;
     void getVelocities(std::vector<double>& tau) const;
     void getForces(std::vector<double>& tau) const;
     void syncData(const std::vector<Species>& sp);
@@ -65,12 +65,36 @@ void KBPsiMatrixSparse::clearData()
 
 template <class T>
 void KBPsiMatrixSparse::setup(const Ions& ions, const T& orbitals)
+{
+    setup(ions, orbitals.numst());
+}
+
+void KBPsiMatrixSparse::setup(const Ions& ions, const int numst)
 {
     setup_tm_.start();
 
     setOutdated();
 
-    numst_ = orbitals.numst();
+    numst_ = numst;
+
+    double spread_radius = ions.getMaxVnlRadius();
+
+    // we need to know locally all the info corresponding to projectors
+    // overlapping with local subdomain
+    if (need2radius_) spread_radius *= 2.0;
+
+    //    if( onpe0 )
+    //        (*MPIdata::sout)<<"KBPsiMatrixSparse using radius
+    //        "<<spread_radius<<endl;
+
+    // data distribution object depends only on radius: keep it
+    // if radius did not change (ions moved by a small amount)
+    DataDistribution* distributor = 0;
+    if (isDataSetup_ && spread_radius == spread_radius_)
+    {
+        distributor  = distributor_;
+        distributor_ = 0;
+    }
 
     // clear old data
     clearData();
@@ -88,23 +112,20 @@ void KBPsiMatrixSparse::setup(const Ions& ions, const T& orbitals)
     else
         kbBpsimat_ = kbpsimat_;
 
-    spread_radius_ = ions.getMaxVnlRadius();
-
-    // we need to know locally all the info corresponding to projectors
-    // overlapping with local subdomain
-    if (need2radius_) spread_radius_ *= 2.0;
-
-    //    if( onpe0 )
-    //        (*MPIdata::sout)<<"KBPsiMatrixSparse using radius
-    //        "<<spread_radius_<<endl;
+    spread_radius_ = spread_radius;
 
     /* construct data distribution object */
     assert(distributor_ == 0);
-    Mesh* mymesh             = Mesh::instance();
-    const pb::Grid& mygrid   = mymesh->grid();
-    const pb::PEenv& myPEenv = mymesh->peenv();
-    double domain[3]         = { mygrid.ll(0), mygrid.ll(1), mygrid.ll(2) };
-    distributor_ = new DataDistribution("KB", spread_radius_, myPEenv, domain);
+    if (distributor == 0)
+    {
+        Mesh* mymesh             = Mesh::instance();
+        const pb::Grid& mygrid   = mymesh->grid();
+        const pb::PEenv& myPEenv = mymesh->peenv();
+        double domain[3] = { mygrid.ll(0), mygrid.ll(1), mygrid.ll(2) };
+        distributor
+            = new DataDistribution("KB", spread_radius_, myPEenv, domain);
+    }
+    distributor_ = distributor;
 
     isDataSetup_ = true;
 
@@ -172,33 +193,59 @@ void KBPsiMatrixSparse::computeKBpsi(Ions& ions, T& orbitals,
         ppsi = orbitals.getPsi(first_color);
     }
 
-    // Loop over functions, subdomains and ions
-    const vector<Ion*>::const_iterator iend = ions.overlappingNL_ions().end();
-    Mesh* mymesh                            = Mesh::instance();
-    const int subdivx                       = mymesh->subdivx();
+    // Loop over subdomains and ions
+    const vector<Ion*>& nl_ions(ions.overlappingNL_ions());
+    const int nions        = (int)nl_ions.size();
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    const double vel       = mygrid.vel();
+    const int subdivx      = mymesh->subdivx();
     for (int iloc = 0; iloc < subdivx; iloc++)
     {
-// Threading here leads to results slightly dependent on number of threads (jlf,
-// 07/15/2016)
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
+        // functions non-zero on subdomain iloc
+        vector<int> colors;
+        vector<int> states;
         for (int color = 0; color < nb_colors; color++)
         {
             const int gid = orbitals.getGlobalIndex(iloc, first_color + color);
-
-            // Loop over the ions
             if (gid != -1)
             {
-                vector<Ion*>::const_iterator ion
-                    = ions.overlappingNL_ions().begin();
-                while (ion != iend)
+                colors.push_back(color);
+                states.push_back(gid);
+            }
+        }
+        if (colors.empty()) continue;
+
+        // <KB|psi> for all projectors of one ion and all functions
+        // with one GEMM, one ion per thread
+        vector<vector<double>> kbpsi(nions);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < nions; i++)
+        {
+            const std::shared_ptr<KBprojector> kbproj(nl_ions[i]->kbproj());
+            if (kbproj->overlaps(iloc))
+                kbproj->dotPsiBlock(iloc, colors, ppsi, ldsize, vel, kbpsi[i]);
+        }
+
+        // insert values in matrix in fixed order
+        for (int i = 0; i < nions; i++)
+        {
+            if (kbpsi[i].empty()) continue;
+
+            vector<int> gids;
+            nl_ions[i]->getGidsNLprojs(gids);
+            const short nprojs = (short)gids.size();
+            for (unsigned j = 0; j < states.size(); j++)
+                for (short p = 0; p < nprojs; p++)
                 {
-                    computeLocalElement(
-                        **ion, gid, iloc, ppsi + color * ldsize, flag);
-                    ion++;
+                    const double val = kbpsi[i][p + j * nprojs];
+                    if (flag)
+                        addKBBPsi(gids[p], states[j], val);
+                    else
+                        addKBPsi(gids[p], states[j], val);
                 }
-            }
         }
     }
 
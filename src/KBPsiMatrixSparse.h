@@ -139,6 +139,7 @@ public:
     void computeAll(Ions& ions, T& orbitals);
     template <class T>
     void setup(const Ions& ions, const T& orbitals);
+    void setup(const Ions& ions, const int numst);
 
     double getTraceDM(
         const int gid, const DISTMATDTYPE* const mat_X, const int numst) const;
@@ -113,6 +113,16 @@ public:
         virtual void axpyKet(
         const short iloc, const std::vector<double>& alpha, float* const dst) const=0;
 
+    // blocked versions for functions psi+colors[j]*ld, j=0..ncols-1:
+    // kbpsi[i+j*nprojs] = alpha*<KB_i|psi_j>
+    virtual void dotPsiBlock(const short iloc, const std::vector<int>& colors,
+        const ORBDTYPE* const psi, const int ld, const double alpha,
+        std::vector<double>& kbpsi) const=0;
+    // dst_j += sum_i alpha[i+j*nprojs]*KB_i
+    virtual void axpyKetBlock(const short iloc, const std::vector<int>& colors,
+        const std::vector<double>& alpha, ORBDTYPE* const dst,
+        const int ld) const=0;
+
     bool onlyOneProjector() const
     {
         return ((maxl_ == 1) && (llocal_ == 1) && (multiplicity_[0] == 1));
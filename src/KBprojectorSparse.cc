@@ -18,6 +18,7 @@ const double rthreshold = 1.e-5;
 
 std::vector<std::vector<ORBDTYPE>> KBprojectorSparse::work_nlindex_;
 std::vector<std::vector<KBPROJDTYPE>> KBprojectorSparse::work_proj_;
+std::vector<std::vector<ORBDTYPE>> KBprojectorSparse::work_block_;
 
 KBprojectorSparse::KBprojectorSparse(const Species& sp) : KBprojector(sp)
 {
@@ -25,6 +26,7 @@ KBprojectorSparse::KBprojectorSparse(const Species& sp) : KBprojector(sp)
 
     if (work_nlindex_.size() == 0) work_nlindex_.resize(omp_get_max_threads());
     if (work_proj_.size() == 0) work_proj_.resize(omp_get_max_threads());
+    if (work_block_.size() == 0) work_block_.resize(omp_get_max_threads());
     // cout<<"constructor: work_nlindex_.size()="<<work_nlindex_.size()<<endl;
 
     is_in_domain_ = nullptr;
@@ -61,21 +63,44 @@ void KBprojectorSparse::setup(const double center[3])
 
     //if(onpe0)cout<<"KBprojectorSparse::setup()..."<<endl;
 
+    // projectors already set up for this position
+    if (is_in_domain_ != nullptr && sameCenter(center)) return;
+
     KBprojector::setup(center);
 
-    for (short i = 0; i < 3; i++)
+    // if projector is still mapped onto the same grid points (small
+    // displacement), index arrays are still valid: update values only
+    bool same_support = false;
+    if (is_in_domain_ != nullptr)
     {
-        kb_proj_start_[i] = center_[i];
+        short start_index[3];
+        computeKBProjStartIndex(start_index);
+        same_support = (start_index[0] == kb_proj_start_index_[0]
+                        && start_index[1] == kb_proj_start_index_[1]
+                        && start_index[2] == kb_proj_start_index_[2]);
     }
 
-    nlindex_.resize(subdivx_);
-    size_nl_.assign(subdivx_, 0);
-
-    if (maxl_ > 0)
+    if (same_support)
     {
-        setPtrProjectors();
+        for (short iloc = 0; iloc < subdivx_; iloc++)
+            if (size_nl_[iloc] > 0) evaluateProjectors(iloc, size_nl_[iloc]);
+    }
+    else
+    {
+        for (short i = 0; i < 3; i++)
+        {
+            kb_proj_start_[i] = center_[i];
+        }
 
-        setIndexesAndProjectors();
+        nlindex_.resize(subdivx_);
+        size_nl_.assign(subdivx_, 0);
+
+        if (maxl_ > 0)
+        {
+            setPtrProjectors();
+
+            setIndexesAndProjectors();
+        }
     }
 
     Mesh* mymesh     = Mesh::instance();
@@ -84,6 +109,12 @@ void KBprojectorSparse::setup(const double center[3])
         work_proj_[it].resize(numloc);
 }
 
+bool KBprojectorSparse::sameCenter(const double center[3]) const
+{
+    return (center[0] == center_[0] && center[1] == center_[1]
+            && center[2] == center_[2]);
+}
+
 void KBprojectorSparse::setNLindex(
     const short iloc, const int size_nl, const std::vector<int>& pvec)
 {
@@ -161,13 +192,11 @@ void KBprojectorSparse::allocateProjectors(const short iloc, const int icount)
 {
     const int nprojs = nProjectors();
 
-    //projector may not overlap with all local patches, so add empty
-    //vector in slots associated with smaller iloc if they have not been
-    //filled
-    while(projectors_storage_.size()<iloc)
-        projectors_storage_.push_back( std::vector<KBPROJDTYPE>(0) );
-    projectors_storage_.push_back( std::vector<KBPROJDTYPE>(nprojs*icount) );
-    assert(projectors_storage_.size()==(iloc+1));
+    //projector may not overlap with all local patches, so storage
+    //may stay empty for some iloc
+    if (projectors_storage_.size() < (size_t)subdivx_)
+        projectors_storage_.resize(subdivx_);
+    projectors_storage_[iloc].resize(nprojs * icount);
 
     KBPROJDTYPE* pstorage( &projectors_storage_[iloc][0] );
 
@@ -196,6 +225,16 @@ void KBprojectorSparse::setProjectors(const short iloc, const int icount)
 
     allocateProjectors(iloc, icount);
 
+    evaluateProjectors(iloc, icount);
+}
+
+// compute values of projectors at points of subdomain iloc
+// (index arrays and storage already set)
+void KBprojectorSparse::evaluateProjectors(const short iloc, const int icount)
+{
+    assert(is_in_domain_ != nullptr);
+    assert(is_in_domain_[iloc] != nullptr);
+
     // Loop over radial projectors
     for (short l = 0; l <= maxl_; l++)
     {
@@ -615,7 +654,8 @@ void KBprojectorSparse::setFProjector(const short iloc, const int icount)
     } // loop over multiplicity
 }
 
-void KBprojectorSparse::setKBProjStart()
+// index of first grid point of projector support, for current center
+void KBprojectorSparse::computeKBProjStartIndex(short start_index[3]) const
 {
     assert(range_kbproj_ >= 0);
     assert(range_kbproj_ < 256);
@@ -641,13 +681,26 @@ void KBprojectorSparse::setKBProjStart()
         if (f1 > 0.5) ic++;
         if (f1 < -0.5) ic--;
 
-        kb_proj_start_index_[dir] = ic - (range_kbproj_ >> 1);
-        kb_proj_start_[dir] = cell_origin + h_[dir] * kb_proj_start_index_[dir];
+        start_index[dir] = ic - (range_kbproj_ >> 1);
+
+        assert(start_index[dir] > -10000);
+        assert(start_index[dir] < 10000);
+    }
+}
+
+void KBprojectorSparse::setKBProjStart()
+{
+    computeKBProjStartIndex(kb_proj_start_index_);
+
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+
+    for (short dir = 0; dir < 3; dir++)
+    {
+        kb_proj_start_[dir]
+            = mygrid.origin(dir) + h_[dir] * kb_proj_start_index_[dir];
         //(*MPIdata::sout)<<"nlproj_start_[i]="<<nlproj_start_[i]<<endl;
         //(*MPIdata::sout)<<"nlstart_[i]     ="<<nlstart_[i]<<endl;
-
-        assert(kb_proj_start_index_[dir] > -10000);
-        assert(kb_proj_start_index_[dir] < 10000);
     }
 }
 
@@ -843,10 +896,76 @@ void KBprojectorSparse::axpyKetT(
     }
 }
 
+// Projectors of subdomain iloc are stored contiguously, so that
+// <KB|psi> for several functions is a GEMM between the projectors and
+// a tile of functions values gathered on the projector support
+void KBprojectorSparse::dotPsiBlock(const short iloc,
+    const std::vector<int>& colors, const ORBDTYPE* const psi, const int ld,
+    const double alpha, std::vector<double>& kbpsi) const
+{
+    assert(iloc < subdivx_);
+
+    const int size_nl  = size_nl_[iloc];
+    const int ncols    = (int)colors.size();
+    const short nprojs = nProjectors();
+
+    kbpsi.assign(nprojs * ncols, 0.);
+    if (size_nl == 0 || ncols == 0) return;
+
+    std::vector<ORBDTYPE>& work(work_block_[omp_get_thread_num()]);
+    if ((int)work.size() < size_nl * ncols) work.resize(size_nl * ncols);
+
+    const int* const pidx = &nlindex_[iloc][0];
+    for (int j = 0; j < ncols; j++)
+    {
+        const ORBDTYPE* const psij = psi + colors[j] * ld;
+        ORBDTYPE* const wj         = &work[j * size_nl];
+        for (int idx = 0; idx < size_nl; idx++)
+            wj[idx] = psij[pidx[idx]];
+    }
+
+    assert((int)projectors_storage_[iloc].size() == nprojs * size_nl);
+    MPgemm('t', 'n', nprojs, ncols, size_nl, alpha,
+        &projectors_storage_[iloc][0], size_nl, &work[0], size_nl, 0.,
+        &kbpsi[0], nprojs);
+}
+
+void KBprojectorSparse::axpyKetBlock(const short iloc,
+    const std::vector<int>& colors, const std::vector<double>& alpha,
+    ORBDTYPE* const dst, const int ld) const
+{
+    assert(iloc < subdivx_);
+
+    const int size_nl  = size_nl_[iloc];
+    const int ncols    = (int)colors.size();
+    const short nprojs = nProjectors();
+    assert((int)alpha.size() == nprojs * ncols);
+
+    if (size_nl == 0 || ncols == 0) return;
+
+    std::vector<ORBDTYPE>& work(work_block_[omp_get_thread_num()]);
+    if ((int)work.size() < size_nl * ncols) work.resize(size_nl * ncols);
+
+    assert((int)projectors_storage_[iloc].size() == nprojs * size_nl);
+    MPgemm('n', 'n', size_nl, ncols, nprojs, 1.,
+        &projectors_storage_[iloc][0], size_nl, &alpha[0], nprojs, 0.,
+        &work[0], size_nl);
+
+    const int* const pidx = &nlindex_[iloc][0];
+    for (int j = 0; j < ncols; j++)
+    {
+        ORBDTYPE* const dstj     = dst + colors[j] * ld;
+        const ORBDTYPE* const wj = &work[j * size_nl];
+        for (int idx = 0; idx < size_nl; idx++)
+            dstj[pidx[idx]] += wj[idx];
+    }
+}
+
 bool KBprojectorSparse::setIndexesAndProjectors()
 {
     // if(onpe0)cout<<"KBprojectorSparse::setIndexesAndProjectors()..."<<endl;
     clear();
+    projectors_storage_.clear();
 
     Mesh* mymesh           = Mesh::instance();
     const pb::Grid& mygrid = mymesh->grid();
@@ -35,6 +35,9 @@ class KBprojectorSparse : public KBprojector
 
     static std::vector<std::vector<KBPROJDTYPE>> work_proj_;
 
+    // tiles of functions values on projector support (1 for each thread)
+    static std::vector<std::vector<ORBDTYPE>> work_block_;
+
     // pointers to projectors for each iloc, l, p, m
     std::vector<std::vector<std::vector<std::vector<KBPROJDTYPE*>>>>
         ptr_projector_;
@@ -66,6 +69,7 @@ class KBprojectorSparse : public KBprojector
     void allocateProjectors(const short iloc, const int icount);
 
     void setProjectors(const short iloc, const int icount);
+    void evaluateProjectors(const short iloc, const int icount);
 
     void setSProjector(const short iloc, const int icount);
     void setPProjector(const short iloc, const int icount);
@@ -75,7 +79,9 @@ class KBprojectorSparse : public KBprojector
     void setNLindex(const short iloc, const int size,
         const std::vector<int>& pvec);
 
+    void computeKBProjStartIndex(short start_index[3]) const;
     void setKBProjStart();
+    bool sameCenter(const double center[3]) const;
     void setProjIndices(const short dir);
     int get_index_array(std::vector<int>& pvec, const short iloc,
         const short index_low[3],
@@ -140,7 +146,9 @@ public:
             proj_indices_[dir].clear();
     }
 
-    //setup data that depends on atomic position
+    // setup data that depends on atomic position.
+    // Data from a previous setup is reused if the center has not moved,
+    // or if the projector is still mapped onto the same grid points
     void setup(const double center[3]);
 
     double maxRadius() const;
@@ -164,6 +172,13 @@ public:
         const short iloc, const std::vector<double>& alpha, float* const dst) const
     { axpyKetT(iloc, alpha, dst); }
 
+    void dotPsiBlock(const short iloc, const std::vector<int>& colors,
+        const ORBDTYPE* const psi, const int ld, const double alpha,
+        std::vector<double>& kbpsi) const;
+    void axpyKetBlock(const short iloc, const std::vector<int>& colors,
+        const std::vector<double>& alpha, ORBDTYPE* const dst,
+        const int ld) const;
+
 
     void getKBsigns(std::vector<short>& kbsigns) const;
     void getKBcoeffs(std::vector<double>& coeffs) const;
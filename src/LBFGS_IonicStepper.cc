@@ -581,7 +581,8 @@ int LBFGS_IonicStepper::init(HDFrestart& h5f_file)
 
     if (file_id >= 0)
     {
-        readPositions_hdf5(h5f_file, string("/Ionic_positions"));
+        if (readPositions_hdf5(h5f_file, string("/Ionic_positions")) < 0)
+            return -1;
 
         // Open dataset
         hid_t dataset_id = H5Dopen2(file_id, "/Ionic_velocities", H5P_DEFAULT);
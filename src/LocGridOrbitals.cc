@@ -41,14 +41,33 @@
 #include "hdf_tools.h"
 #include "lapack_c.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <map>
+#include <set>
 #include <vector>
 using namespace std;
 
 #define ORBITAL_OCCUPATION 2.
 string getDatasetName(const string& name, const int color);
 
+// datasets of sparse orbitals layout are one-dimensional
+static bool isSparseDataset(HDFrestart& h5f_file, const string& datasetname)
+{
+    if (h5f_file.dset_exists(datasetname) <= 0) return false;
+
+    hid_t dset_id = h5f_file.open_dset(datasetname);
+    if (dset_id < 0) return false;
+
+    hid_t filespace = H5Dget_space(dset_id);
+    const int ndims = H5Sget_simple_extent_ndims(filespace);
+    H5Sclose(filespace);
+    h5f_file.close_dset(dset_id);
+
+    return (ndims == 1);
+}
+
 short LocGridOrbitals::subdivx_          = 0;
 int LocGridOrbitals::lda_                = 0;
 int LocGridOrbitals::numpt_              = 0;
@@ -79,6 +98,8 @@ LocGridOrbitals::LocGridOrbitals(std::string name,
       grid_(my_grid),
       proj_matrices_(proj_matrices),
       block_vector_(my_grid, subdivx, bc),
+      incremental_gram_index_(-1),
+      modified_colors_set_(false),
       lrs_(lrs),
       local_cluster_(local_cluster)
 {
@@ -131,6 +152,8 @@ LocGridOrbitals::LocGridOrbitals(const std::string name,
       grid_(A.grid_),
       proj_matrices_(A.proj_matrices_),
       block_vector_(A.block_vector_, copy_data),
+      incremental_gram_index_(-1),
+      modified_colors_set_(false),
       masks4orbitals_(A.masks4orbitals_),
       lrs_(A.lrs_),
       local_cluster_(A.local_cluster_)
@@ -158,6 +181,8 @@ LocGridOrbitals::LocGridOrbitals(const std::string name,
       grid_(A.grid_),
       proj_matrices_(proj_matrices),
       block_vector_(A.block_vector_, copy_data),
+      incremental_gram_index_(-1),
+      modified_colors_set_(false),
       lrs_(A.lrs_),
       local_cluster_(A.local_cluster_)
 {
@@ -296,6 +321,10 @@ void LocGridOrbitals::setup(LocalizationRegions* lrs)
 
     overlapping_gids_.clear();
 
+    // colors are about to be reassigned
+    incremental_gram_.reset();
+    modified_colors_set_ = false;
+
     chromatic_number_ = packStates(lrs);
 
     computeGlobalIndexes(*lrs);
@@ -996,6 +1025,18 @@ int LocGridOrbitals::write_func_hdf5(HDFrestart& h5f_file, string name)
     hid_t file_id = h5f_file.file_id();
     bool iwrite   = h5f_file.active();
 
+    if (ct.out_restart_sparse > 0)
+    {
+        if (!h5f_file.useHdf5p() && !h5f_file.gatherDataX())
+            return write_func_sparse_hdf5(h5f_file, name);
+
+        if (onpe0 && ct.verbose > 0)
+            (*MPIdata::sout) << "Sparse orbitals restart only available "
+                                "for distributed files: write full grid "
+                                "functions"
+                             << endl;
+    }
+
     const bool global = ct.globalColoring();
     ColoredRegions colored_regions(*pack_, *lrs_, global);
 
@@ -1164,6 +1205,21 @@ int LocGridOrbitals::read_func_hdf5(HDFrestart& h5f_file, string name)
     Control& ct     = *(Control::instance());
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
 
+    if (!h5f_file.useHdf5p() && !h5f_file.gatherDataX()
+        && isSparseDataset(h5f_file, getDatasetName(name, 0)))
+        return read_func_sparse_hdf5(h5f_file, name);
+
+    // functions of same color in files of another decomposition may have
+    // different gids: only sparse layout can be redistributed
+    if (h5f_file.redistributed())
+    {
+        (*MPIdata::serr) << "LocGridOrbitals::read_func_hdf5(): functions "
+                            "written with a different decomposition need "
+                            "the sparse restart layout (Restart.output_sparse)"
+                         << endl;
+        return -1;
+    }
+
     const bool global = ct.globalColoring();
     ColoredRegions colored_regions(*pack_, *lrs_, global);
 
@@ -1371,6 +1427,324 @@ int LocGridOrbitals::read_func_hdf5(HDFrestart& h5f_file, string name)
     return centers_in_dataset.size();
 }
 
+// Write each function only over the bounding box of its non-zero values
+// on this task. All the functions of one color are packed in a 1D dataset,
+// with their gid, global start index and extents in attribute
+// "List of sparse boxes". Datasets keep the attributes of the full grid
+// layout, so that localization regions can be read as usual.
+int LocGridOrbitals::write_func_sparse_hdf5(HDFrestart& h5f_file, string name)
+{
+    assert(h5f_file.active());
+    assert(!h5f_file.useHdf5p());
+
+    Control& ct   = *(Control::instance());
+    hid_t file_id = h5f_file.file_id();
+
+    const bool global = ct.globalColoring();
+    ColoredRegions colored_regions(*pack_, *lrs_, global);
+
+    const int dim[3] = { (int)grid_.dim(0), (int)grid_.dim(1),
+        (int)grid_.dim(2) };
+    const int nslab  = dim[0] / subdivx_;
+    const int incx   = dim[1] * dim[2];
+
+    if (onpe0 && ct.verbose > 2)
+        (*MPIdata::sout) << "Write LocGridOrbitals " << name
+                         << " in sparse format, compression level "
+                         << ct.out_restart_compression << endl;
+
+    vector<ORBDTYPE> data;
+    vector<int> boxes;
+    for (int color = 0; color < chromatic_number_; color++)
+    {
+        const ORBDTYPE* const pc = psi(color);
+
+        // distinct functions of this color on this task
+        vector<int> color_gids;
+        for (short iloc = 0; iloc < subdivx_; iloc++)
+        {
+            const int gid = overlapping_gids_[iloc][color];
+            if (gid != -1
+                && find(color_gids.begin(), color_gids.end(), gid)
+                       == color_gids.end())
+                color_gids.push_back(gid);
+        }
+
+        data.clear();
+        boxes.clear();
+        for (vector<int>::const_iterator it = color_gids.begin();
+             it != color_gids.end(); ++it)
+        {
+            const int gid = *it;
+
+            // bounding box of non-zero values
+            int lo[3] = { dim[0], dim[1], dim[2] };
+            int hi[3] = { -1, -1, -1 };
+            for (short iloc = 0; iloc < subdivx_; iloc++)
+            {
+                if (overlapping_gids_[iloc][color] != gid) continue;
+                for (int ix = iloc * nslab; ix < (iloc + 1) * nslab; ix++)
+                    for (int iy = 0; iy < dim[1]; iy++)
+                        for (int iz = 0; iz < dim[2]; iz++)
+                            if (pc[ix * incx + iy * dim[2] + iz] != 0.)
+                            {
+                                lo[0] = min(lo[0], ix);
+                                lo[1] = min(lo[1], iy);
+                                lo[2] = min(lo[2], iz);
+                                hi[0] = max(hi[0], ix);
+                                hi[1] = max(hi[1], iy);
+                                hi[2] = max(hi[2], iz);
+                            }
+            }
+            if (hi[0] < 0) continue;
+
+            boxes.push_back(gid);
+            for (short d = 0; d < 3; d++)
+                boxes.push_back(grid_.istart(d) + lo[d]);
+            for (short d = 0; d < 3; d++)
+                boxes.push_back(hi[d] - lo[d] + 1);
+
+            for (int ix = lo[0]; ix <= hi[0]; ix++)
+            {
+                const bool mine = (overlapping_gids_[ix / nslab][color] == gid);
+                for (int iy = lo[1]; iy <= hi[1]; iy++)
+                    for (int iz = lo[2]; iz <= hi[2]; iz++)
+                        data.push_back(
+                            mine ? pc[ix * incx + iy * dim[2] + iz] : 0.);
+            }
+        }
+
+        string datasetname(getDatasetName(name, color));
+        if (onpe0 && ct.verbose > 2)
+            (*MPIdata::sout) << "Write " << datasetname << endl;
+
+        hsize_t size    = (hsize_t)data.size();
+        hid_t filespace = H5Screate_simple(1, &size, NULL);
+
+        hid_t plist_id = H5P_DEFAULT;
+        if (ct.out_restart_compression > 0 && size > 0)
+        {
+            plist_id = H5Pcreate(H5P_DATASET_CREATE);
+            H5Pset_chunk(plist_id, 1, &size);
+            H5Pset_deflate(plist_id, ct.out_restart_compression);
+        }
+
+        hid_t dtype_id = outHdfDataType(ct.out_restart_info);
+        hid_t dset_id  = H5Dcreate2(file_id, datasetname.c_str(), dtype_id,
+            filespace, H5P_DEFAULT, plist_id, H5P_DEFAULT);
+        if (plist_id != H5P_DEFAULT) H5Pclose(plist_id);
+        if (dset_id < 0)
+        {
+            (*MPIdata::serr) << "LocGridOrbitals::write_func_sparse_hdf5(), "
+                                "H5Dcreate2 failed!!!"
+                             << endl;
+            return -1;
+        }
+
+        vector<double> centers_and_radii;
+        const int nrec = colored_regions.getLocCentersAndRadii4color(
+            color, centers_and_radii);
+        writeListCentersAndRadii(dset_id, nrec, centers_and_radii);
+
+        vector<int> gids;
+        colored_regions.getLocGids4color(color, gids);
+        writeGids(dset_id, gids);
+
+        writeSparseBoxes(dset_id, boxes);
+
+        vector<double> attr_data(3);
+        attr_data[0] = grid_.ll(0);
+        attr_data[1] = grid_.ll(1);
+        attr_data[2] = grid_.ll(2);
+        mgmol_tools::addAttribute2Dataset(
+            dset_id, "Lattice parameters", attr_data);
+
+        attr_data[0] = grid_.origin(0);
+        attr_data[1] = grid_.origin(1);
+        attr_data[2] = grid_.origin(2);
+        mgmol_tools::addAttribute2Dataset(dset_id, "Cell origin", attr_data);
+
+        if (size > 0)
+        {
+            herr_t status = H5Dwrite(dset_id, memHdfDataType(), H5S_ALL,
+                H5S_ALL, H5P_DEFAULT, &data[0]);
+            if (status < 0)
+            {
+                (*MPIdata::serr) << "LocGridOrbitals::write_func_sparse_hdf5(),"
+                                    " H5Dwrite failed!!!"
+                                 << endl;
+                return -1;
+            }
+        }
+
+        H5Sclose(filespace);
+        herr_t status = H5Dclose(dset_id);
+        if (status < 0)
+        {
+            (*MPIdata::serr)
+                << "LocGridOrbitals::write_func_sparse_hdf5:H5Dclose failed!!!"
+                << endl;
+            return -1;
+        }
+    } // loop over color
+
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+    mmpi.barrier();
+
+    return 0;
+}
+
+// Read functions written by write_func_sparse_hdf5() and copy the parts
+// of their boxes inside this task subdomain into colored storage
+int LocGridOrbitals::read_func_sparse_hdf5(HDFrestart& h5f_file, string name)
+{
+    assert(h5f_file.active());
+
+    Control& ct = *(Control::instance());
+
+    const int dim[3] = { (int)grid_.dim(0), (int)grid_.dim(1),
+        (int)grid_.dim(2) };
+    const int nslab  = dim[0] / subdivx_;
+    const int incx   = dim[1] * dim[2];
+
+    if (onpe0 && ct.verbose > 2)
+        (*MPIdata::sout) << "LocGridOrbitals::read_func_sparse_hdf5(): Read "
+                            "wave functions "
+                         << name << endl;
+
+    // color of each function in storage
+    map<int, int> gid2color;
+    for (short iloc = 0; iloc < subdivx_; iloc++)
+        for (int color = 0; color < chromatic_number_; color++)
+        {
+            const int gid = overlapping_gids_[iloc][color];
+            if (gid != -1) gid2color[gid] = color;
+        }
+
+    block_vector_.set_zero();
+
+    set<int> read_gids;
+    vector<ORBDTYPE> data;
+    vector<int> boxes;
+    const short precision = ct.restart_info > 3 ? 2 : 1;
+
+    int ifile = 0;
+    h5f_file.selectOverlappingFile(ifile);
+    for (int color = 0;; color++)
+    {
+        const string key(getDatasetName(name, color));
+        if (h5f_file.dset_exists(key) <= 0)
+        {
+            // boxes of a function may be spread over several files
+            // (files written with a different decomposition)
+            ifile++;
+            if (ifile == h5f_file.nOverlappingFiles()) break;
+            h5f_file.selectOverlappingFile(ifile);
+            color = -1;
+            continue;
+        }
+
+        if (onpe0 && ct.verbose > 2)
+            (*MPIdata::sout) << "Read Dataset " << key << " with precision "
+                             << precision << endl;
+
+        hid_t dset_id = h5f_file.open_dset(key);
+        if (dset_id < 0)
+        {
+            (*MPIdata::serr)
+                << "LocGridOrbitals::read_func_sparse_hdf5() --- cannot open "
+                << key << endl;
+            return dset_id;
+        }
+
+        const int nboxes = readSparseBoxes(dset_id, boxes);
+        if (nboxes < 0) return nboxes;
+
+        // centers of functions in dataset
+        vector<double> attr_data;
+        vector<int> gids;
+        const int natt = readListCentersAndRadii(dset_id, attr_data);
+        if (natt < 0) return natt;
+        readGids(dset_id, gids);
+        map<int, Vector3D> centers;
+        for (int i = 0; i < (int)gids.size(); i++)
+            centers[gids[i]] = Vector3D(
+                attr_data[4 * i], attr_data[4 * i + 1], attr_data[4 * i + 2]);
+
+        hid_t filespace = H5Dget_space(dset_id);
+        data.resize(H5Sget_simple_extent_npoints(filespace));
+        H5Sclose(filespace);
+        if (!data.empty())
+        {
+            herr_t status = H5Dread(dset_id, memHdfDataType(), H5S_ALL,
+                H5S_ALL, H5P_DEFAULT, &data[0]);
+            if (status < 0)
+            {
+                (*MPIdata::serr) << "LocGridOrbitals::read_func_sparse_hdf5() "
+                                    "--- H5Dread failed!!!"
+                                 << endl;
+                return -1;
+            }
+        }
+
+        herr_t status = h5f_file.close_dset(dset_id);
+        if (status < 0) return status;
+
+        int offset = 0;
+        for (int ib = 0; ib < nboxes; ib++)
+        {
+            const int* const box = &boxes[7 * ib];
+            const int gid        = box[0];
+            const int* const ext = box + 4;
+            const int size       = ext[0] * ext[1] * ext[2];
+
+            // local start index of box
+            int start[3];
+            for (short d = 0; d < 3; d++)
+                start[d] = box[1 + d] - grid_.istart(d);
+
+            map<int, int>::const_iterator itc = gid2color.find(gid);
+            if (itc != gid2color.end()
+                && (centers.find(gid) == centers.end()
+                       || masks4orbitals_->center(gid) == centers[gid]))
+            {
+                const int mycolor  = itc->second;
+                ORBDTYPE* const pc = psi(mycolor);
+
+                // part of box inside this task subdomain
+                int lo[3];
+                int hi[3];
+                for (short d = 0; d < 3; d++)
+                {
+                    lo[d] = max(start[d], 0);
+                    hi[d] = min(start[d] + ext[d], dim[d]);
+                }
+                for (int ix = lo[0]; ix < hi[0]; ix++)
+                {
+                    if (overlapping_gids_[ix / nslab][mycolor] != gid)
+                        continue;
+                    for (int iy = lo[1]; iy < hi[1]; iy++)
+                        for (int iz = lo[2]; iz < hi[2]; iz++)
+                            pc[ix * incx + iy * dim[2] + iz]
+                                = data[offset
+                                       + ((ix - start[0]) * ext[1]
+                                             + iy - start[1])
+                                             * ext[2]
+                                       + iz - start[2]];
+                }
+                read_gids.insert(gid);
+            }
+            offset += size;
+        }
+        assert(offset == (int)data.size());
+    }
+    h5f_file.selectOverlappingFile(0);
+
+    resetIterativeIndex();
+
+    return (int)read_gids.size();
+}
+
 // initialize matrix chromatic_number_ by ncolor (for columns first_color to
 // first_color+ncolor)
 void LocGridOrbitals::matrixToLocalMatrix(const short iloc,
@@ -1495,17 +1869,64 @@ void LocGridOrbitals::getLocalOverlap(SquareLocalMatrices<MATDTYPE>& ss)
 #else
         const ORBDTYPE* const psi = block_vector_.vect(0);
 
-        for (short iloc = 0; iloc < subdivx_; iloc++)
+        // keep local Gram matrices only if some functions get modified
+        // individually
+        if (modified_colors_set_ && !incremental_gram_)
+            incremental_gram_.reset(new vector<IncrementalGram>(subdivx_));
+
+        if (incremental_gram_)
         {
-            ss.syrk(iloc, loc_numpt_, psi + iloc * loc_numpt_, lda_);
+            // false if data modified without call to setModifiedColors()
+            const bool uptodate
+                = (incremental_gram_index_ == getIterativeIndex());
+
+            // only the parts of the overlap matrices associated with
+            // functions declared modified since last call are recomputed
+            for (short iloc = 0; iloc < subdivx_; iloc++)
+            {
+                IncrementalGram& igram((*incremental_gram_)[iloc]);
+                if (!uptodate) igram.reset();
+                igram.compute(loc_numpt_, chromatic_number_,
+                    psi + iloc * loc_numpt_, lda_, ss.getSubMatrix(iloc));
+            }
+            incremental_gram_index_ = getIterativeIndex();
         }
+        else
+        {
+            for (short iloc = 0; iloc < subdivx_; iloc++)
+            {
+                ss.syrk(iloc, loc_numpt_, psi + iloc * loc_numpt_, lda_);
+            }
 
-        // We may need the full matrix
-        ss.fillUpperWithLower();
+            // We may need the full matrix
+            ss.fillUpperWithLower();
+        }
 
         ss.scal(grid_.vel());
 #endif
     }
+    modified_colors_set_ = false;
+}
+
+void LocGridOrbitals::setModifiedColors(const vector<int>& colors)
+{
+    // incremental update valid only if no other modification of data
+    // since last overlap computation
+    const bool uptodate = incremental_gram_
+                          && (incremental_gram_index_ == getIterativeIndex());
+
+    incrementIterativeIndex();
+
+    if (uptodate)
+    {
+        for (short iloc = 0; iloc < subdivx_; iloc++)
+            for (vector<int>::const_iterator it = colors.begin();
+                 it != colors.end(); ++it)
+                if (*it >= 0) (*incremental_gram_)[iloc].setModified(*it);
+
+        incremental_gram_index_ = getIterativeIndex();
+    }
+    modified_colors_set_ = true;
 }
 
 void LocGridOrbitals::getLocalOverlap(
@@ -2119,6 +2540,9 @@ void LocGridOrbitals::orthonormalize2states(const int st1, const int st2)
         (*MPIdata::sout) << "Gram matrix = " << overlap[0] << "," << overlap[1]
                          << "," << overlap[2] << endl;
 #endif
+
+    vector<int> colors(color_st, color_st + 2);
+    setModifiedColors(colors);
 }
 
 void LocGridOrbitals::multiplyByMatrix2states(
@@ -2170,6 +2594,11 @@ void LocGridOrbitals::multiplyByMatrix2states(
                     mat[1], block_vector_, color_st2, color_st1, iloc);
             }
     }
+
+    vector<int> colors;
+    colors.push_back(color_st1);
+    colors.push_back(color_st2);
+    product.setModifiedColors(colors);
 }
 
 void LocGridOrbitals::computeDiagonalGram(
@@ -2606,6 +3035,7 @@ void LocGridOrbitals::printTimers(ostream& os)
     assign_tm_.print(os);
     normalize_tm_.print(os);
     axpy_tm_.print(os);
+    IncrementalGram::printTimers(os);
 }
 
 void LocGridOrbitals::initWF(const LocalizationRegions& lrs)
@@ -17,6 +17,7 @@
 #include "FunctionsPacking.h"
 #include "GridFunc.h"
 #include "HDFrestart.h"
+#include "IncrementalGram.h"
 #include "Lap.h"
 #include "MGmol_MPI.h"
 #include "MPIdata.h"
@@ -99,6 +100,17 @@ private:
     ////////////////////////////////////////////////////////
     BlockVector<ORBDTYPE> block_vector_;
 
+    // Gram matrix of each subdomain, updated for modified functions only.
+    // Allocated only for objects which had colors declared as modified
+    // with setModifiedColors() before computing their overlap matrix.
+    std::unique_ptr<std::vector<IncrementalGram>> incremental_gram_;
+
+    // iterative index of data incremental_gram_ corresponds to
+    short incremental_gram_index_;
+
+    // true if setModifiedColors() was called since last overlap computation
+    bool modified_colors_set_;
+
     ////////////////////////////////////////////////////////
     //
     // private functions
@@ -366,6 +378,11 @@ public:
     void getLocalOverlap(
         const LocGridOrbitals& orbitals, SquareLocalMatrices<MATDTYPE>&);
 
+    // declare functions of some colors modified (and increment iterative
+    // index), so that only their contributions to local overlap matrices
+    // need to be recomputed
+    void setModifiedColors(const std::vector<int>& colors);
+
     void addDotWithNcol2Matrix(const int, const int, LocGridOrbitals&,
         dist_matrix::SparseDistMatrix<DISTMATDTYPE>&) const;
     void addDotWithNcol2Matrix(
@@ -412,6 +429,8 @@ public:
     int write_func_hdf5(HDFrestart&, std::string name = "Function");
     int read_hdf5(HDFrestart& h5f_file);
     int read_func_hdf5(HDFrestart&, std::string name = "Function");
+    int write_func_sparse_hdf5(HDFrestart&, std::string name);
+    int read_func_sparse_hdf5(HDFrestart&, std::string name);
 
     void setGids2Storage();
 
@@ -17,7 +17,6 @@ std::vector<std::vector<int>> LocalMatrices2DistMatrix::global_indexes_;
 double LocalMatrices2DistMatrix::tol_mat_elements = 1.e-14;
 dist_matrix::RemoteTasksDistMatrix<DISTMATDTYPE>*
     LocalMatrices2DistMatrix::remote_tasks_DistMatrix_ = nullptr;
-short LocalMatrices2DistMatrix::sparse_distmatrix_nb_tasks_per_partitions_ = 256;
 
 template <class T>
 void LocalMatrices2DistMatrix::convert(
@@ -101,8 +100,8 @@ void LocalMatrices2DistMatrix::convert(const LocalMatrices<T>& lmat,
 #ifdef USE_MPI
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
     MPI_Comm comm   = mmpi.commSameSpin();
-    dist_matrix::SparseDistMatrix<DISTMATDTYPE> sm(comm, dst,
-        remote_tasks_DistMatrix_, sparse_distmatrix_nb_tasks_per_partitions_);
+    dist_matrix::SparseDistMatrix<DISTMATDTYPE> sm(
+        comm, dst, remote_tasks_DistMatrix_);
 #else
     dist_matrix::SparseDistMatrix<DISTMATDTYPE> sm(
         0, dst, remote_tasks_DistMatrix_);
@@ -132,8 +131,8 @@ void LocalMatrices2DistMatrix::accumulate(const LocalMatrices<T>& lmat,
 #ifdef USE_MPI
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
     MPI_Comm comm   = mmpi.commSameSpin();
-    dist_matrix::SparseDistMatrix<DISTMATDTYPE> sm(comm, dst,
-        remote_tasks_DistMatrix_, sparse_distmatrix_nb_tasks_per_partitions_);
+    dist_matrix::SparseDistMatrix<DISTMATDTYPE> sm(
+        comm, dst, remote_tasks_DistMatrix_);
 #else
     dist_matrix::SparseDistMatrix<DISTMATDTYPE> sm(
         0, dst, remote_tasks_DistMatrix_);
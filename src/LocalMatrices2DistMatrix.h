@@ -35,7 +35,6 @@ private:
 
     static dist_matrix::RemoteTasksDistMatrix<DISTMATDTYPE>*
         remote_tasks_DistMatrix_;
-    static short sparse_distmatrix_nb_tasks_per_partitions_;
 
 public:
     static LocalMatrices2DistMatrix* instance()
@@ -11,6 +11,7 @@
 #include "global.h"
 
 #include "LocalizationRegions.h"
+#include "CentersCellList.h"
 #include "LocGridOrbitals.h"
 #include "Mesh.h"
 #include "OrbitalsTransform.h"
@@ -688,6 +689,21 @@ float LocalizationRegions::imposeMinDistanceBetweenCentersGlobal(
     Control& ct    = *(Control::instance());
     int step       = 1;
     int npairs     = 1000;
+
+    // spatial index to find pairs of centers closer than drmin
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    const Vector3D origin(mygrid.origin(0), mygrid.origin(1), mygrid.origin(2));
+    vector<Vector3D> centers(nglobal_);
+    for (int index = 0; index < nglobal_; index++)
+        centers[index] = all_regions_[index].center;
+    CentersCellList cell_list(origin, cell_, ct.bcPoisson);
+    cell_list.setup(centers, max((double)drmin, 1.e-2));
+
+    // search radius slightly larger than drmin to be safe with round-offs
+    const double rsearch = 1.0001 * drmin;
+    vector<int> neighbors;
+
     while (npairs > 0)
     {
         npairs = 0;
@@ -696,9 +712,13 @@ float LocalizationRegions::imposeMinDistanceBetweenCentersGlobal(
         for (int index0 = 0; index0 < nglobal_; index0++)
         {
             float* pforce0 = &forces[3 * index0];
-            for (int index1 = 0; index1 < index0; index1++)
+            cell_list.getNeighbors(
+                all_regions_[index0].center, rsearch, neighbors);
+            for (vector<int>::const_iterator itn = neighbors.begin();
+                 itn != neighbors.end() && *itn < index0; ++itn)
             {
-                float* pforce1 = &forces[3 * index1];
+                const int index1 = *itn;
+                float* pforce1   = &forces[3 * index1];
                 Vector3D dr    = all_regions_[index1].center.vminimage(
                     all_regions_[index0].center, cell_, ct.bcPoisson);
                 const float dr0 = length(dr);
@@ -749,6 +769,8 @@ float LocalizationRegions::imposeMinDistanceBetweenCentersGlobal(
                 norm2f = norm2f + forces[3 * index + 1] * forces[3 * index + 1];
                 norm2f = norm2f + forces[3 * index + 2] * forces[3 * index + 2];
                 if (norm2f > maxdispl) maxdispl = norm2f;
+
+                cell_list.update(index, all_regions_[index].center);
             }
         }
     }
@@ -771,28 +793,61 @@ float LocalizationRegions::getStatesWithClosestCenters(
     float drmin2 = 1.e12;
     Control& ct  = *(Control::instance());
 
-    for (int index0 = 0; index0 < (int)overlap_regions_.size(); index0++)
+    const int nregions = (int)overlap_regions_.size();
+
+    // spatial index to visit only pairs of close centers
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    const Vector3D origin(mygrid.origin(0), mygrid.origin(1), mygrid.origin(2));
+    vector<Vector3D> centers(nregions);
+    for (int index = 0; index < nregions; index++)
+        centers[index] = overlap_regions_[index].center;
+
+    // initial search radius: mean distance between centers
+    double r = cbrt(cell_[0] * cell_[1] * cell_[2] / (double)max(nglobal_, 1));
+    const double rmax = length(cell_);
+
+    CentersCellList cell_list(origin, cell_, ct.bcPoisson);
+    cell_list.setup(centers, r);
+
+    vector<int> neighbors;
+    for (;;)
     {
-        for (int index1 = 0; index1 < index0; index1++)
+        drmin2 = 1.e12;
+        for (int index0 = 0; index0 < nregions; index0++)
         {
-
-            Vector3D dr = overlap_regions_[index1].center.vminimage(
-                overlap_regions_[index0].center, cell_, ct.bcPoisson);
-            const float dr2 = norm2(dr);
-            // if(onpe0)(*MPIdata::sout)<<"dr2="<<dr2<<endl;
-            if (dr2 < drmin2)
+            cell_list.getNeighbors(
+                overlap_regions_[index0].center, r, neighbors);
+            for (vector<int>::const_iterator itn = neighbors.begin();
+                 itn != neighbors.end() && *itn < index0; ++itn)
             {
-                const int sti0 = overlap_regions_[index0].gid[0];
-                const int sti1 = overlap_regions_[index1].gid[0];
-                SymmetricPair pair(sti0, sti1);
-                if (exclude_set.find(pair) == exclude_set.end())
+                const int index1 = *itn;
+
+                Vector3D dr = overlap_regions_[index1].center.vminimage(
+                    overlap_regions_[index0].center, cell_, ct.bcPoisson);
+                const float dr2 = norm2(dr);
+                // if(onpe0)(*MPIdata::sout)<<"dr2="<<dr2<<endl;
+                if (dr2 < drmin2)
                 {
-                    drmin2 = dr2;
-                    *st1   = sti0;
-                    *st2   = sti1;
+                    const int sti0 = overlap_regions_[index0].gid[0];
+                    const int sti1 = overlap_regions_[index1].gid[0];
+                    SymmetricPair pair(sti0, sti1);
+                    if (exclude_set.find(pair) == exclude_set.end())
+                    {
+                        drmin2 = dr2;
+                        *st1   = sti0;
+                        *st2   = sti1;
+                    }
                 }
             }
         }
+
+        // pairs further apart than r cannot be closer than pair found
+        if (drmin2 < r * r || r > rmax) break;
+
+        // increase search radius (up to all pairs)
+        r *= 2.;
+        if (r > rmax) r = 1.e12;
     }
 
     /* communicate info */
@@ -940,20 +995,18 @@ void LocalizationRegions::setupLocalRegionsFromOverlapRegions()
 void LocalizationRegions::setupSubdomainGeometry()
 {
 
-    Mesh* mymesh             = Mesh::instance();
-    const pb::Grid& mygrid   = mymesh->grid();
-    const pb::PEenv& myPEenv = mymesh->peenv();
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
 
     for (short i = 0; i < 3; i++)
     {
         subdom_origin_[i]  = mygrid.origin(i);
-        subdom_lattice_[i] = mygrid.ll(i) / (double)(myPEenv.n_mpi_task(i));
+        subdom_lattice_[i] = (double)mygrid.dim(i) * mygrid.hgrid(i);
     }
     for (short i = 0; i < 3; i++)
         subdom_end_[i] = subdom_origin_[i] + mygrid.ll(i);
     for (short i = 0; i < 3; i++)
-        subdom_lower_left_[i] = (double)myPEenv.my_mpi(i) * subdom_lattice_[i]
-                                + subdom_origin_[i];
+        subdom_lower_left_[i] = mygrid.start(i);
     for (short i = 0; i < 3; i++)
         subdom_upper_right_[i] = subdom_lower_left_[i] + subdom_lattice_[i];
     for (short i = 0; i < 3; i++)
@@ -1022,13 +1075,43 @@ void LocalizationRegions::computeOverlapRegionsGlobal()
 
     overlap_regions_.clear();
 
-    vector<LRData>::const_iterator itc = all_regions_.begin();
-    while (itc != all_regions_.end())
+    // use spatial index to select regions with center close enough
+    // to local subdomain, before checking actual overlap
+    const int nregions = (int)all_regions_.size();
+    vector<Vector3D> centers(nregions);
+    float max_radius = 0.;
+    for (int i = 0; i < nregions; i++)
     {
-        assert(!itc->gid.empty());
-        const LRData& region(*itc);
+        centers[i] = all_regions_[i].center;
+        max_radius = max(max_radius, all_regions_[i].radius);
+    }
+    const double half_diag = 0.5
+                             * sqrt(subdom_lattice_[0] * subdom_lattice_[0]
+                                    + subdom_lattice_[1] * subdom_lattice_[1]
+                                    + subdom_lattice_[2] * subdom_lattice_[2]);
+    const double rsearch
+        = 1.0001 * (half_diag + max_radius + subdom_delta_) + 1.e-6;
+
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    const Vector3D origin(mygrid.origin(0), mygrid.origin(1), mygrid.origin(2));
+
+    // addOverlappingRegion() assumes periodicity in all directions
+    const short periodic[3] = { 1, 1, 1 };
+    CentersCellList cell_list(origin, cell_, periodic);
+    cell_list.setup(centers, rsearch);
+
+    const Vector3D center(subdom_center_[0], subdom_center_[1], subdom_center_[2]);
+    vector<int> candidates;
+    cell_list.getNeighbors(center, rsearch, candidates);
+
+    // candidates are sorted, so overlap_regions_ ordering is unchanged
+    for (vector<int>::const_iterator it = candidates.begin();
+         it != candidates.end(); ++it)
+    {
+        const LRData& region(all_regions_[*it]);
+        assert(!region.gid.empty());
         addOverlappingRegion(region);
-        itc++;
     }
 
     // cout<<"Num. overalapping regions: "<<overlap_regions_.size()<<endl;
@@ -1103,6 +1186,11 @@ void LocalizationRegions::computeSubdivOverlapGids()
             }
         }
     }
+
+    sorted_subdiv_overlap_gids_ = subdiv_overlap_gids_;
+    for (short iloc = 0; iloc < subdivx; iloc++)
+        sort(sorted_subdiv_overlap_gids_[iloc].begin(),
+            sorted_subdiv_overlap_gids_[iloc].end());
 }
 
 bool LocalizationRegions::overlap(const int gid1, const int gid2)
@@ -1114,10 +1202,10 @@ bool LocalizationRegions::overlap(const int gid1, const int gid2)
 
     for (short iloc = 0; iloc < subdivx; iloc++)
     {
-        const vector<int>& ov(subdiv_overlap_gids_[iloc]);
+        const vector<int>& ov(sorted_subdiv_overlap_gids_[iloc]);
         // assert( ov.size()>0 );
-        bool f1 = (find(ov.begin(), ov.end(), gid1) != ov.end());
-        bool f2 = (find(ov.begin(), ov.end(), gid2) != ov.end());
+        bool f1 = binary_search(ov.begin(), ov.end(), gid1);
+        bool f2 = binary_search(ov.begin(), ov.end(), gid2);
         if (f1 && f2) return true;
     }
     return false;
@@ -1127,8 +1215,8 @@ bool LocalizationRegions::overlapSubdiv(const int gid, const short iloc) const
 {
     assert(subdiv_overlap_gids_.size() > 0);
 
-    const vector<int>& ov(subdiv_overlap_gids_[iloc]);
-    return (find(ov.begin(), ov.end(), gid) != ov.end());
+    const vector<int>& ov(sorted_subdiv_overlap_gids_[iloc]);
+    return binary_search(ov.begin(), ov.end(), gid);
 }
 
 bool LocalizationRegions::overlapSubdiv(const int gid) const
@@ -1149,10 +1237,13 @@ bool LocalizationRegions::overlapSubdiv(const int gid) const
 void LocalizationRegions::computeOverlapGids()
 {
     overlap_gids_.clear();
+    gid2overlap_index_.clear();
     vector<LRData>::const_iterator it = overlap_regions_.begin();
     while (it != overlap_regions_.end())
     {
         assert(!it->gid.empty());
+        gid2overlap_index_.insert(pair<int, int>(
+            it->gid[0], (int)(it - overlap_regions_.begin())));
         vector<int>::const_iterator git = it->gid.begin();
         while (git != it->gid.end())
         {
@@ -23,6 +23,7 @@
 #include "SpreadsAndCenters.h"
 
 #include <iostream>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -54,6 +55,12 @@ private:
     std::vector<int> overlap_gids_;
     std::vector<std::vector<int>> subdiv_overlap_gids_;
 
+    // same as subdiv_overlap_gids_, but sorted for fast searches
+    std::vector<std::vector<int>> sorted_subdiv_overlap_gids_;
+
+    // map gid -> index in overlap_regions_
+    std::map<int, int> gid2overlap_index_;
+
     int nglobal_;
 
     float max_displ_;
@@ -238,17 +245,25 @@ public:
         return (nglobal_ >= max_nb_lrs);
     }
 
+    // return index of region gid in overlap_regions_
+    // return -1 if gid not known locally
+    int getOverlapIndex(const int gid) const
+    {
+        std::map<int, int>::const_iterator it = gid2overlap_index_.find(gid);
+        if (it == gid2overlap_index_.end()) return -1;
+
+        assert(it->second < (int)overlap_regions_.size());
+        assert(overlap_regions_[it->second].gid[0] == gid);
+        return it->second;
+    }
+
     const Vector3D& getCenter(const int gid) const
     {
         assert(0 <= gid);
         assert(gid < nglobal_);
 
-        for (std::vector<LRData>::const_iterator it = overlap_regions_.begin();
-             it != overlap_regions_.end(); ++it)
-        {
-            const std::vector<int>& gids(it->gid);
-            if (gid == gids[0]) return it->center;
-        }
+        const int index = getOverlapIndex(gid);
+        if (index >= 0) return overlap_regions_[index].center;
 
         std::cout << "mype:" << mype
                   << ", WARNING: didn't find a center for gid=" << gid
@@ -281,16 +296,11 @@ public:
         assert(0 <= gid);
         assert(gid < nglobal_);
 
-        for (std::vector<LRData>::const_iterator it = overlap_regions_.begin();
-             it != overlap_regions_.end(); ++it)
+        const int index = getOverlapIndex(gid);
+        if (index >= 0)
         {
-            const std::vector<int>& gids(it->gid);
-            assert(!gids.empty());
-            if (gid == gids[0])
-            {
-                center = it->center;
-                return it->radius;
-            }
+            center = overlap_regions_[index].center;
+            return overlap_regions_[index].radius;
         }
         std::cout << "mype:" << mype
                   << ", WARNING: didn't find a center and radius for gid="
@@ -344,12 +354,8 @@ public:
     {
         assert(gid < (int)all_regions_.size());
 
-        for (std::vector<LRData>::iterator it = overlap_regions_.begin();
-             it != overlap_regions_.end(); ++it)
-        {
-            const std::vector<int>& gids(it->gid);
-            if (gid == gids[0]) it->center = center;
-        }
+        const int index = getOverlapIndex(gid);
+        if (index >= 0) overlap_regions_[index].center = center;
     }
 
     // return radius of regions gid
@@ -357,12 +363,9 @@ public:
     float radius(const int gid) const
     {
         assert(gid < nglobal_);
-        for (std::vector<LRData>::const_iterator it = overlap_regions_.begin();
-             it != overlap_regions_.end(); ++it)
-        {
-            const std::vector<int>& gids(it->gid);
-            if (gid == gids[0]) return it->radius;
-        }
+
+        const int index = getOverlapIndex(gid);
+        if (index >= 0) return overlap_regions_[index].radius;
 
         return -1.;
     }
@@ -30,6 +30,8 @@ using namespace std;
 #include "FDoper.h"
 #include "FIRE.h"
 #include "Forces.h"
+#include "FunctionsPacking.h"
+#include "ImagesEnsemble.h"
 #include "GrassmanLineMinimization.h"
 #include "GridFunc.h"
 #include "HDFrestart.h"
@@ -92,6 +94,7 @@ extern Timer ttdot_tm;
 extern Timer get_NOLMO_tm;
 extern Timer get_MLWF_tm;
 extern Timer md_iterations_tm;
+extern Timer evaluate_tm;
 extern Timer md_tau_tm;
 extern Timer md_moveVnuc_tm;
 extern Timer md_updateMasks_tm;
@@ -135,6 +138,8 @@ MGmol<T>::MGmol(MPI_Comm comm, std::ostream& os) : os_(os)
     forces_ = 0;
 
     energy_ = 0;
+
+    nevaluations_ = 0;
 }
 
 template <class T>
@@ -496,6 +501,20 @@ void MGmol<T>::run()
     double eks = 0.;
 
     if (ct.verbose > 0) printWithTimeStamp("Run...", os_);
+
+    // ensemble of images relaxed concurrently
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+    if (mmpi.nimages() > 1
+        && (ct.AtomsDynamic() == AtomsDynamicType::LBFGS
+               || ct.AtomsDynamic() == AtomsDynamicType::FIRE))
+    {
+        ImagesEnsemble<T> ensemble(*this, *ions_, os_);
+        ensemble.run();
+
+        cleanup();
+        return;
+    }
+
     // Dispatch to the method chosen
     switch (ct.AtomsDynamic())
     {
@@ -885,6 +904,8 @@ void MGmol<T>::printTimers()
     Power<LocalVector<double>, SquareLocalMatrices<double>>::printTimers(os_);
     SP2::printTimers(os_);
     lrs_->printTimers(os_);
+    FunctionsPacking::printTimers(os_);
+    ImagesEnsemble<T>::printTimers(os_);
     local_cluster_->printTimers(os_);
     forces_->printTimers(os_);
     if (ct.OuterSolver() == OuterSolverType::ABPG)
@@ -894,6 +915,7 @@ void MGmol<T>::printTimers()
     adaptLR_tm_.print(os_);
     updateCenters_tm.print(os_);
     md_iterations_tm.print(os_);
+    evaluate_tm.print(os_);
     md_tau_tm.print(os_);
     md_moveVnuc_tm.print(os_);
     init_nuc_tm_.print(os_);
@@ -115,6 +115,9 @@ private:
     float md_time_;
     int md_iteration_;
 
+    // number of calls to evaluateEnergyAndForces()
+    int nevaluations_;
+
     // private functions
     void check_anisotropy();
     double get_charge(RHODTYPE* rho);
@@ -314,6 +317,12 @@ public:
     int setupFromInput(const std::string input_file);
     int setupLRsFromInput(const std::string input_file);
     int setupConstraintsFromInput(const std::string input_file);
+    double evaluateEnergyAndForces(
+        const std::vector<double>& tau, std::vector<double>& forces);
+    void evaluateEnergyAndForces(const std::vector<std::vector<double>>& taus,
+        std::vector<double>& energies,
+        std::vector<std::vector<double>>& forces);
+    void getAtomicPositions(std::vector<double>& tau);
     void cleanup();
     void geomOptimSetup();
     void geomOptimQuench();
@@ -12,6 +12,7 @@
 #define MGMOLINTERFACE_H
 
 #include <cstring>
+#include <vector>
 
 class MGmolInterface
 {
@@ -24,6 +25,27 @@ public:
     virtual int setupLRsFromInput(const std::string input_file)=0;
     virtual int setupConstraintsFromInput(const std::string input_file)=0;
     virtual void run()=0;
+
+    // Repeated evaluations in memory, after setupFromInput/setupLRsFromInput
+    // and setup():
+    // energy and forces for atomic positions tau[3*ia+j], ordered by ion
+    // index and identical on all tasks. Electronic structure of previous
+    // call (or initial guess) is used as starting point.
+    // Forces are returned on all tasks, ordered by ion index.
+    virtual double evaluateEnergyAndForces(
+        const std::vector<double>& tau, std::vector<double>& forces)=0;
+
+    // same for a batch of configurations, evaluated in given order
+    virtual void evaluateEnergyAndForces(
+        const std::vector<std::vector<double>>& taus,
+        std::vector<double>& energies,
+        std::vector<std::vector<double>>& forces)=0;
+
+    // positions of all atoms, ordered by ion index, on all tasks
+    virtual void getAtomicPositions(std::vector<double>& tau)=0;
+
+    virtual void setup()=0;
+    virtual void cleanup()=0;
 };
 
 #endif
@@ -9,8 +9,10 @@
 // Please also read this link https://github.com/llnl/mgmol/LICENSE
 
 #include "DFTsolver.h"
+#include "ExtendedGridOrbitals.h"
 #include "FIRE.h"
 #include "LBFGS.h"
+#include "LocGridOrbitals.h"
 #include "MGmol.h"
 #include "ProjectedMatricesInterface.h"
 
@@ -104,3 +106,6 @@ short MGmol<T>::geomOptimCheckTolForces(const double tol_force)
 {
     return geom_optimizer_->checkTolForces(tol_force);
 }
+
+template class MGmol<LocGridOrbitals>;
+template class MGmol<ExtendedGridOrbitals>;
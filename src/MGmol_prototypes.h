@@ -18,6 +18,9 @@ class KBPsiMatrixSparse;
 
 void get_vnlpsi(const Ions& ions, const std::vector<std::vector<int>>&,
     const int, const KBPsiMatrixSparse* const kbpsi, ORBDTYPE* const);
+void add_vnlpsi(const Ions& ions, const std::vector<std::vector<int>>&,
+    const int first_color, const int ncolors,
+    const KBPsiMatrixSparse* const kbpsi, ORBDTYPE* const vpsi, const int ld);
 double getLAeigen(const double tol, const int maxit, Ions& ions);
 
 #endif
@@ -92,6 +92,36 @@ void MLWFTransform::compute_transform(const int maxsweep, const double tol)
                 << " after " << maxsweep << " iterations" << endl;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Apply all the rotations R(p,q) of one round to the rows of local
+// column "col" of the matrices r_loc[k]: A := R(p,q) * A.
+// The rotations are applied one column at a time to get contiguous
+// memory accesses.
+void MLWFTransform::rotateRows(vector<vector<DISTMATDTYPE>>& r_loc,
+    const int col, const vector<double>& cs, const vector<int>& rows)
+{
+    const int npairs = (int)cs.size() / 2;
+    for (size_t k = 0; k < r_loc.size(); k++)
+    {
+        DISTMATDTYPE* const a = &r_loc[k][nst_ * col];
+        for (int ip = 0; ip < npairs; ip++)
+        {
+            const int rowp = rows[2 * ip];
+            const int rowq = rows[2 * ip + 1];
+            if (rowp < nst_ && rowq < nst_)
+            {
+                const double c = cs[2 * ip];
+                const double s = cs[2 * ip + 1];
+                const double x = a[rowp];
+                const double y = a[rowq];
+
+                a[rowp] = c * x + s * y;
+                a[rowq] = c * y - s * x;
+            }
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 double MLWFTransform::jade(int maxsweep, double tol)
@@ -347,53 +377,28 @@ double MLWFTransform::jade(int maxsweep, double tol)
                     actualv[ip2 + 1] = rq;
                 } // loop over local pairs
 
-                vector<double> v_small(n_loc);
-                vector<int> remote_actualv(n_loc);
-                for (int pe = 0; pe < npecol; pe++)
-                {
-
+                // gather rotations computed by all tasks in this round
+                vector<double> all_cs(n_loc * npecol);
+                vector<int> all_actualv(n_loc * npecol);
 #ifdef SCALAPACK
-                    if (mype == pe)
-                    {
-                        v_small        = u_small;
-                        remote_actualv = actualv;
-                    }
-
-                    MPI_Bcast(&v_small[0], n_loc, MPI_DOUBLE, pe, comm_);
-                    MPI_Bcast(&remote_actualv[0], n_loc, MPI_INT, pe, comm_);
+                MPI_Allgather(&u_small[0], n_loc, MPI_DOUBLE, &all_cs[0], n_loc,
+                    MPI_DOUBLE, comm_);
+                MPI_Allgather(&actualv[0], n_loc, MPI_INT, &all_actualv[0],
+                    n_loc, MPI_INT, comm_);
 #else
-                    v_small        = u_small;
-                    remote_actualv = actualv;
+                all_cs      = u_small;
+                all_actualv = actualv;
 #endif
-                    // Rotate rows rp and rq
-                    for (int ip = 0; ip < n_loc_2; ip++)
-                    {
-                        const int ip2 = 2 * ip;
-
-                        // rows to rotate
-                        const int rowp = remote_actualv[ip2];
-                        const int rowq = remote_actualv[ip2 + 1];
-
-                        // rotation coefficients
-                        double c = v_small[ip2];
-                        double s = v_small[ip2 + 1];
 
-                        // update the rows of the matrices r_loc[k]
-                        if (rowp < nst_ && rowq < nst_)
-                        // if( iu_[rowp+nst_*rowq] )
-                        {
-                            for (int k = 0; k < m; k++)
-                            {
-                                // A := R(p,q) * A
-                                DROT(&n_loc, &r_loc[k][rowp], &nst_,
-                                    &r_loc[k][rowq], &nst_, &c, &s);
-                            }
-                        }
-                    } // ip
+#ifdef SCALAPACK
+                const int colr = column[(n_loc_2 - 1)];
+                const int coll = column[(n_loc - 1)];
 
-                } // pe
+                // rotate rows of the columns to exchange first, so that
+                // exchange can overlap with rotations of other columns
+                rotateRows(r_loc, colr, all_cs, all_actualv);
+                rotateRows(r_loc, coll, all_cs, all_actualv);
 
-#ifdef SCALAPACK
                 for (int i = 0; i < 8; i++)
                     req[i] = MPI_REQUEST_NULL;
 
@@ -401,48 +406,45 @@ double MLWFTransform::jade(int maxsweep, double tol)
                 int destleft  = (mype - 1) % npecol;
 
                 // save data to exchange in buffers
-                assert(column[(n_loc_2 - 1)] < n_loc);
-                assert(column[(n_loc - 1)] < n_loc);
+                assert(colr < n_loc);
+                assert(coll < n_loc);
 
                 // copy column n_loc_2-1 into buffer to transfer right
                 if (mype != npecol - 1)
                 {
                     for (int k = 0; k < m; k++)
-                        memcpy(&sbuf1[k * nst_],
-                            &r_loc[k][column[(n_loc_2 - 1)] * nst_],
+                        memcpy(&sbuf1[k * nst_], &r_loc[k][colr * nst_],
                             nst_ * sizeof(DISTMATDTYPE));
-                    memcpy(&sbuf1[m * nst_],
-                        &u_loc[column[(n_loc_2 - 1)] * nst_],
+                    memcpy(&sbuf1[m * nst_], &u_loc[colr * nst_],
                         nst_ * sizeof(double));
                 }
                 // copy column n_loc-1 into buffer to transfer left
                 if (mype != 0)
                 {
                     for (int k = 0; k < m; k++)
-                        memcpy(&sbuf2[k * nst_],
-                            &r_loc[k][column[(n_loc - 1)] * nst_],
+                        memcpy(&sbuf2[k * nst_], &r_loc[k][coll * nst_],
                             nst_ * sizeof(double));
-                    memcpy(&sbuf2[m * nst_], &u_loc[column[(n_loc - 1)] * nst_],
+                    memcpy(&sbuf2[m * nst_], &u_loc[coll * nst_],
                         nst_ * sizeof(double));
                 }
-                int scolr = actual[column[(n_loc_2 - 1)]];
-                int scoll = actual[column[(n_loc - 1)]];
+                int scolr = actual[colr];
+                int scoll = actual[coll];
 
                 // Exchange columns of matrices
                 if (mype != npecol - 1)
                 {
                     MPI_Irecv(&rbuf2[0], (m + 1) * nst_, MPI_DOUBLE, destright,
                         destright, comm_, req);
-                    MPI_Irecv(&actual[column[(n_loc_2 - 1)]], 1, MPI_INT,
-                        destright, destright + npecol, comm_, req + 4);
+                    MPI_Irecv(&actual[colr], 1, MPI_INT, destright,
+                        destright + npecol, comm_, req + 4);
                 }
 
                 if (mype != 0)
                 {
                     MPI_Irecv(&rbuf1[0], (m + 1) * nst_, MPI_DOUBLE, destleft,
                         destleft, comm_, req + 1);
-                    MPI_Irecv(&actual[column[(n_loc - 1)]], 1, MPI_INT,
-                        destleft, destleft + npecol, comm_, req + 5);
+                    MPI_Irecv(&actual[coll], 1, MPI_INT, destleft,
+                        destleft + npecol, comm_, req + 5);
                 }
 
                 if (mype != 0)
@@ -451,8 +453,6 @@ double MLWFTransform::jade(int maxsweep, double tol)
                         mype, comm_, req + 2);
                     MPI_Isend(&scoll, 1, MPI_INT, destleft, mype + npecol,
                         comm_, req + 6);
-                    //(*MPIdata::sout)<<"mype="<<mype<<", send col left
-                    //"<<scoll<<endl;
                 }
 
                 if (mype != npecol - 1)
@@ -461,34 +461,35 @@ double MLWFTransform::jade(int maxsweep, double tol)
                         mype, comm_, req + 3);
                     MPI_Isend(&scolr, 1, MPI_INT, destright, mype + npecol,
                         comm_, req + 7);
-                    //(*MPIdata::sout)<<"mype="<<mype<<", send col right
-                    //"<<scolr<<endl;
                 }
 
-                MPI_Wait(req, status);
-                MPI_Wait(req + 1, status + 1);
-                MPI_Wait(req + 2, status + 2);
-                MPI_Wait(req + 3, status + 3);
-                MPI_Wait(req + 4, status + 4);
-                MPI_Wait(req + 5, status + 5);
-                MPI_Wait(req + 6, status + 6);
-                MPI_Wait(req + 7, status + 7);
+                // Rotate rows rp and rq of all the other local columns
+                // while columns are being exchanged
+                for (int ic = 0; ic < n_loc; ic++)
+                    if (ic != colr && ic != coll)
+                        rotateRows(r_loc, ic, all_cs, all_actualv);
+
+                MPI_Waitall(8, req, status);
 
                 for (int k = 0; k < m; k++)
                 {
                     if (mype != npecol - 1)
-                        memcpy(&r_loc[k][column[(n_loc_2 - 1)] * nst_],
-                            &rbuf2[k * nst_], nst_ * sizeof(double));
+                        memcpy(&r_loc[k][colr * nst_], &rbuf2[k * nst_],
+                            nst_ * sizeof(double));
                     if (mype != 0)
-                        memcpy(&r_loc[k][column[(n_loc - 1)] * nst_],
-                            &rbuf1[k * nst_], nst_ * sizeof(double));
+                        memcpy(&r_loc[k][coll * nst_], &rbuf1[k * nst_],
+                            nst_ * sizeof(double));
                 }
                 if (mype != npecol - 1)
-                    memcpy(&u_loc[column[(n_loc_2 - 1)] * nst_],
-                        &rbuf2[m * nst_], nst_ * sizeof(double));
+                    memcpy(&u_loc[colr * nst_], &rbuf2[m * nst_],
+                        nst_ * sizeof(double));
                 if (mype != 0)
-                    memcpy(&u_loc[column[(n_loc - 1)] * nst_], &rbuf1[m * nst_],
+                    memcpy(&u_loc[coll * nst_], &rbuf1[m * nst_],
                         nst_ * sizeof(double));
+#else
+                // Rotate rows rp and rq of all local columns
+                for (int ic = 0; ic < n_loc; ic++)
+                    rotateRows(r_loc, ic, all_cs, all_actualv);
 #endif
 
                 // rotate pointers for local columns
@@ -22,6 +22,10 @@ private:
 
     double jade(int maxsweep, double tol);
 
+    void rotateRows(std::vector<std::vector<DISTMATDTYPE>>& r_loc,
+        const int col, const std::vector<double>& cs,
+        const std::vector<int>& rows);
+
 public:
     double spread2(int i, int j) const;
 
@@ -29,8 +29,6 @@ Timer MVPSolver<T>::solve_tm_("MVPSolver::solve");
 template <class T>
 Timer MVPSolver<T>::target_tm_("MVPSolver::target");
 
-static int sparse_distmatrix_nb_partitions = 128;
-
 double evalEntropyMVP(ProjectedMatricesInterface* projmatrices,
     const bool print_flag, ostream& os)
 {
@@ -205,8 +203,7 @@ int MVPSolver<T>::solve(T& orbitals)
 
         // compute linear component of H
         dist_matrix::DistMatrixWithSparseComponent<DISTMATDTYPE> h11("h11",
-            numst_, numst_, comm_, mgmol_strategy_->getRemoteTasksDistMatrix(),
-            sparse_distmatrix_nb_partitions);
+            numst_, numst_, comm_, mgmol_strategy_->getRemoteTasksDistMatrix());
 
         kbpsi.computeAll(ions_, orbitals);
 
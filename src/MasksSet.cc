@@ -13,6 +13,7 @@
 #include "GridMaskMax.h"
 #include "GridMaskMult.h"
 #include "LocalizationRegions.h"
+#include "MGmol_MPI.h"
 #include "Mesh.h"
 
 #define USE_MASKMAX 1
@@ -155,6 +156,37 @@ void MasksSet::setup(
     if (onpe0 && ct.verbose > 0)
         (*MPIdata::sout) << "MasksSet: Total: " << pgrid_masks_.size()
                          << " masks" << endl;
+
+    if (ct.verbose > 1) printMemoryUsage(*MPIdata::sout);
+}
+
+void MasksSet::printMemoryUsage(ostream& os) const
+{
+    // local memory in compressed and dense formats
+    double mem[2] = { 0., 0. };
+    for (map<int, GridMask*>::const_iterator it = pgrid_masks_.begin();
+         it != pgrid_masks_.end(); it++)
+    {
+        mem[0] += (double)(it->second)->memory();
+        mem[1] += (double)(it->second)->denseMemory();
+    }
+
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+    double max_mem[2] = { mem[0], mem[1] };
+    mmpi.allreduce(&max_mem[0], 2, MPI_MAX);
+    mmpi.allreduce(&mem[0], 2, MPI_SUM);
+
+    if (onpe0)
+    {
+        const double mb = 1. / (1024. * 1024.);
+        os << "MasksSet memory (MB): compressed format: total = "
+           << mem[0] * mb << ", max per task = " << max_mem[0] * mb << endl;
+        os << "MasksSet memory (MB): dense format:      total = "
+           << mem[1] * mb << ", max per task = " << max_mem[1] * mb << endl;
+        if (mem[0] > 0.)
+            os << "MasksSet memory: compression ratio = " << mem[1] / mem[0]
+               << endl;
+    }
 }
 
 void MasksSet::allocate(const vector<int>& gids)
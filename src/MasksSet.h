@@ -69,6 +69,10 @@ public:
             return it->second;
     }
     size_t size() const { return pgrid_masks_.size(); }
+
+    // print memory used by masks data in compressed format,
+    // compared to dense format
+    void printMemoryUsage(std::ostream& os) const;
 };
 
 #endif
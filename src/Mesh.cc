@@ -25,6 +25,68 @@ int Mesh::subdivx_       = 1;
 int Mesh::numpt_         = -1;
 int Mesh::loc_numpt_     = -1;
 
+std::vector<unsigned> Mesh::partition_[3];
+
+const std::vector<unsigned>* Mesh::checkPartition()
+{
+    if (partition_[0].empty() && partition_[1].empty()
+        && partition_[2].empty())
+        return 0;
+
+    // local sizes must be compatible with MG preconditioner coarse levels
+    Control& ct           = *(Control::instance());
+    const short nlevels   = ct.getMGlevels();
+    const short nghosts   = GridFactory::nghosts(lap_type_, false);
+    const unsigned factor = 1u << (nlevels > 0 ? nlevels : 0);
+
+    for (short d = 0; d < 3; d++)
+    {
+        const int ntasks = myPEenv_->n_mpi_task(d);
+
+        // uniform decomposition in directions without user partition
+        const bool user_partition = !partition_[d].empty();
+        if (!user_partition) partition_[d].assign(ntasks, ngpts_[d] / ntasks);
+
+        unsigned sum = 0;
+        for (std::vector<unsigned>::const_iterator it = partition_[d].begin();
+             it != partition_[d].end(); ++it)
+        {
+            if (*it == 0)
+            {
+                (*MPIdata::serr) << "Mesh: empty subdomain in direction " << d
+                                 << endl;
+                MPI_Abort(comm_, 2);
+            }
+            sum += *it;
+        }
+        if ((int)partition_[d].size() != ntasks || sum != ngpts_[d])
+        {
+            (*MPIdata::serr)
+                << "Mesh: partition in direction " << d << " has "
+                << partition_[d].size() << " intervals and " << sum
+                << " points, expected " << ntasks << " intervals and "
+                << ngpts_[d] << " points" << endl;
+            MPI_Abort(comm_, 2);
+        }
+
+        if (!user_partition) continue;
+        const int j
+            = pb::Grid::checkCoarsening(partition_[d], nlevels, nghosts);
+        if (j >= 0)
+        {
+            (*MPIdata::serr)
+                << "Mesh: interval " << j << " of partition in direction "
+                << d << " has " << partition_[d][j]
+                << " points, expected a multiple of " << factor
+                << " (2^MG levels) with at least " << 2 * nghosts
+                << " points at coarsest level" << endl;
+            MPI_Abort(comm_, 2);
+        }
+    }
+
+    return partition_;
+}
+
 void Mesh::print(ostream& os) const
 {
     os << " Grid:" << endl;
@@ -66,6 +128,9 @@ void Mesh::subdivGridx(const int nlevels)
     // communications when gathering data for local (subdomain) matrices
     const int smin = max(2 * (1 << nlevels), 16);
 
+    // subdomains must have the same size on all tasks
+    if (!myGrid_->uniformPartition()) return;
+
     const int dimx = myGrid_->dim(0);
     for (int i = smin; i <= dimx; i += 4)
         if (dimx % i == 0)
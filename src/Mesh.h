@@ -16,6 +16,7 @@
 #include "PEenv.h"
 #include <cassert>
 #include <ostream>
+#include <vector>
 
 #ifdef USE_MPI
 #include <mpi.h>
@@ -33,6 +34,9 @@ class Mesh
     static double lattice_[3];
     static int lap_type_;
 
+    // optional number of grid points for each task in each direction
+    static std::vector<unsigned> partition_[3];
+
     // nb. subdivision of grid in direction 0
     static int subdivx_;
     static int numpt_;
@@ -45,8 +49,8 @@ class Mesh
     {
         myPEenv_ = new pb::PEenv(comm_, ngpts_[0], ngpts_[1], ngpts_[2], 1);
 
-        myGrid_ = GridFactory::createGrid(
-            ngpts_, origin_, lattice_, lap_type_, false, *myPEenv_);
+        myGrid_ = GridFactory::createGrid(ngpts_, origin_, lattice_,
+            lap_type_, false, *myPEenv_, checkPartition());
         numpt_     = myGrid_->size();
         loc_numpt_ = numpt_;
     };
@@ -58,6 +62,9 @@ class Mesh
     };
     Mesh(const Mesh&){};
 
+    // validate user defined partition, return 0 if none
+    const std::vector<unsigned>* checkPartition();
+
 public:
     static Mesh* instance()
     {
@@ -76,7 +83,8 @@ public:
     }
 
     static void setup(MPI_Comm comm, const unsigned ngpts[3],
-        const double origin[3], const double lattice[3], const int lap_type)
+        const double origin[3], const double lattice[3], const int lap_type,
+        const std::vector<unsigned>* partition = 0)
     {
         assert(pinstance_ == NULL);
         assert(ngpts[0] > 0);
@@ -98,6 +106,7 @@ public:
             ngpts_[i]   = ngpts[i];
             origin_[i]  = origin[i];
             lattice_[i] = lattice[i];
+            if (partition != 0) partition_[i] = partition[i];
         }
         lap_type_ = lap_type;
     }
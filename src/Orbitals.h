@@ -11,6 +11,8 @@
 #ifndef MGMOL_ORBITALS_H
 #define MGMOL_ORBITALS_H
 
+#include "global.h"
+
 #include "hdf5.h"
 
 class Orbitals
@@ -68,5 +70,12 @@ public:
         return dtype_id;
     }
 
+    // HDF5 type of orbitals data in memory
+    hid_t memHdfDataType() const
+    {
+        return sizeof(ORBDTYPE) == sizeof(float) ? H5T_NATIVE_FLOAT
+                                                 : H5T_NATIVE_DOUBLE;
+    }
+
 };
 #endif
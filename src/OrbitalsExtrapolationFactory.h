@@ -13,6 +13,7 @@
 
 #include "OrbitalsExtrapolationOrder2.h"
 #include "OrbitalsExtrapolationOrder3.h"
+#include "OrbitalsExtrapolationXLBOMD.h"
 #include "SpreadPenalty.h"
 
 template <class T>
@@ -34,6 +35,10 @@ public:
                 orbitals_extrapol =
                     new OrbitalsExtrapolationOrder3<T>();
                 break;
+            case WFExtrapolationType::XLBOMD:
+                orbitals_extrapol = new OrbitalsExtrapolationXLBOMD<T>(
+                    Control::instance()->getXLBOMDdissipationOrder());
+                break;
             default:
                 (*MPIdata::serr)
                     << "OrbitalsExtrapolation* create() --- option invalid\n";
@@ -0,0 +1,150 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "OrbitalsExtrapolationXLBOMD.h"
+#include "Control.h"
+#include "DistMatrixTools.h"
+#include "ExtendedGridOrbitals.h"
+#include "LocGridOrbitals.h"
+
+#include <cassert>
+using namespace std;
+
+// coefficients of dissipation schemes for K=3,...,7
+// (Niklasson et al., J. Chem. Phys. 130, 214109 (2009), Table I)
+static const double xlbomd_kappa[5] = { 1.69, 1.75, 1.82, 1.84, 1.86 };
+static const double xlbomd_alpha[5]
+    = { 150.e-3, 57.e-3, 18.e-3, 5.5e-3, 1.6e-3 };
+static const double xlbomd_c[5][8]
+    = { { -2., 3., 0., -1. }, { -3., 6., -2., -2., 1. },
+          { -6., 14., -8., -3., 4., -1. },
+          { -14., 36., -27., -2., 12., -6., 1. },
+          { -36., 99., -88., 11., 32., -25., 8., -1. } };
+
+template <class T>
+OrbitalsExtrapolationXLBOMD<T>::OrbitalsExtrapolationXLBOMD(const short order)
+    : order_(order)
+{
+    assert(order_ >= 3 && order_ <= 7);
+
+    const short i = order_ - 3;
+    kappa_        = xlbomd_kappa[i];
+    alpha_        = xlbomd_alpha[i];
+    coeffs_.assign(&xlbomd_c[i][0], &xlbomd_c[i][0] + order_ + 1);
+}
+
+template <class T>
+OrbitalsExtrapolationXLBOMD<T>::~OrbitalsExtrapolationXLBOMD()
+{
+    for (typename vector<T*>::iterator it = aux_.begin(); it != aux_.end();
+         ++it)
+        delete *it;
+}
+
+template <class T>
+void OrbitalsExtrapolationXLBOMD<T>::clearOldOrbitals()
+{
+    OrbitalsExtrapolation<T>::clearOldOrbitals();
+
+    for (typename vector<T*>::iterator it = aux_.begin(); it != aux_.end();
+         ++it)
+        delete *it;
+    aux_.clear();
+}
+
+// start (or restart) auxiliary dynamics at rest, from SCF orbitals
+template <class T>
+void OrbitalsExtrapolationXLBOMD<T>::initAuxiliaryOrbitals(T& orbitals)
+{
+    Control& ct = *(Control::instance());
+    if (ct.verbose > 1 && onpe0)
+        (*MPIdata::sout) << "XL-BOMD: initialize " << order_ + 1
+                         << " sets of auxiliary orbitals" << endl;
+
+    assert(aux_.empty());
+    for (short k = 0; k <= order_; k++)
+        aux_.push_back(new T("XLBOMD_aux", orbitals));
+}
+
+// rotate auxiliary orbitals to match SCF orbitals
+// (extended orbitals are defined up to a unitary transformation)
+template <class T>
+void OrbitalsExtrapolationXLBOMD<T>::alignAuxiliaryOrbitals(T& orbitals)
+{
+    Control& ct = *(Control::instance());
+
+    dist_matrix::DistMatrix<DISTMATDTYPE> matQ("Q", ct.numst, ct.numst);
+    dist_matrix::DistMatrix<DISTMATDTYPE> yyt("yyt", ct.numst, ct.numst);
+
+    for (short k = 0; k <= order_; k++)
+    {
+        aux_[k]->computeGram(orbitals, matQ);
+        getProcrustesTransform(matQ, yyt);
+        aux_[k]->multiply_by_matrix(matQ);
+    }
+}
+
+template <class T>
+void OrbitalsExtrapolationXLBOMD<T>::extrapolate_orbitals(
+    T** orbitals, T* new_orbitals)
+{
+    Control& ct = *(Control::instance());
+
+    T& scf_orbitals(**orbitals);
+
+    if (aux_.empty())
+    {
+        initAuxiliaryOrbitals(scf_orbitals);
+    }
+    else if (!ct.isLocMode())
+    {
+        alignAuxiliaryOrbitals(scf_orbitals);
+    }
+
+    if (ct.verbose > 1 && onpe0)
+        (*MPIdata::sout) << "XL-BOMD: propagate auxiliary orbitals..." << endl;
+
+    // auxiliary orbitals at step n+1
+    new_orbitals->assign(*aux_[0]);
+    new_orbitals->scal(2. - kappa_ + alpha_ * coeffs_[0]);
+    new_orbitals->axpy(-1. + alpha_ * coeffs_[1], *aux_[1]);
+    for (short k = 2; k <= order_; k++)
+        new_orbitals->axpy(alpha_ * coeffs_[k], *aux_[k]);
+    new_orbitals->axpy(kappa_, scf_orbitals);
+
+    // recycle oldest auxiliary orbitals to save new ones
+    T* tmp = aux_[order_];
+    for (short k = order_; k > 0; k--)
+        aux_[k] = aux_[k - 1];
+    aux_[0] = tmp;
+    aux_[0]->assign(*new_orbitals);
+
+    // keep SCF orbitals (consistent with forces) for restart
+    if (OrbitalsExtrapolation<T>::orbitals_minus1_ != 0)
+        delete OrbitalsExtrapolation<T>::orbitals_minus1_;
+    OrbitalsExtrapolation<T>::orbitals_minus1_ = *orbitals;
+
+    *orbitals = new_orbitals;
+
+    (*orbitals)->incrementIterativeIndex();
+
+    if (ct.isLocMode())
+    {
+        (*orbitals)->normalize();
+        (*orbitals)->applyMask();
+    }
+    else
+    {
+        (*orbitals)->orthonormalizeLoewdin();
+    }
+}
+
+template class OrbitalsExtrapolationXLBOMD<LocGridOrbitals>;
+template class OrbitalsExtrapolationXLBOMD<ExtendedGridOrbitals>;
@@ -0,0 +1,54 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_ORBITALSEXTRAPOLATIONXLBOMD_H
+#define MGMOL_ORBITALSEXTRAPOLATIONXLBOMD_H
+
+#include "OrbitalsExtrapolation.h"
+
+#include <vector>
+
+// Extended Lagrangian Born-Oppenheimer MD:
+// auxiliary orbitals are propagated with a time-reversible Verlet scheme,
+// harmonically coupled to the SCF orbitals, plus a small dissipative term
+// to remove numerical noise (Niklasson et al., J. Chem. Phys. 130, 214109):
+// aux(n+1) = 2*aux(n) - aux(n-1) + kappa*(scf(n) - aux(n))
+//            + alpha * sum_{k=0}^{K} c_k aux(n-k)
+// The auxiliary orbitals are used as initial guess for the SCF iterations.
+template <class T>
+class OrbitalsExtrapolationXLBOMD : public OrbitalsExtrapolation<T>
+{
+private:
+    // order K of dissipation scheme
+    const short order_;
+
+    // auxiliary orbitals at steps n, n-1, ..., n-K
+    std::vector<T*> aux_;
+
+    double kappa_;
+    double alpha_;
+    std::vector<double> coeffs_;
+
+    void initAuxiliaryOrbitals(T& orbitals);
+    void alignAuxiliaryOrbitals(T& orbitals);
+
+public:
+    OrbitalsExtrapolationXLBOMD(const short order);
+
+    ~OrbitalsExtrapolationXLBOMD();
+
+    void extrapolate_orbitals(T** orbitals, T* new_orbitals);
+
+    void clearOldOrbitals();
+
+    short getNumAuxiliaryOrbitals() { return (short)aux_.size(); }
+};
+
+#endif
@@ -75,13 +75,8 @@ void PCGSolver<T, T2>::setupPrecon()
     nlevels_ = max_nlevels_;
     for (short ln = 1; ln <= max_nlevels_; ln++)
     {
-        const bool flag_coarsen
-            = ((!(mygrid->dim(0)
-                   & 1)) // cannot coarsen if mesh not divisible by 2
-                && (!(mygrid->dim(1) & 1)) && (!(mygrid->dim(2) & 1))
-                && (mygrid->dim(0) >= 2 * nghosts)
-                && (mygrid->dim(1) >= 2 * nghosts)
-                && (mygrid->dim(2) >= 2 * nghosts));
+        // cannot coarsen if mesh not divisible by 2 (on all tasks)
+        const bool flag_coarsen = mygrid->canCoarsen(nghosts);
 
         if (!flag_coarsen)
         {
@@ -158,8 +158,80 @@ void Preconditioning<T>::setup(map<int, GridMask*>& st_to_mask,
     gid2mask_ = st_to_mask;
 }
 
-// MG V-cycle with mask corresponding to state istate
-// (no mask if istate==-1)
+// Determine colors which are not masked out everywhere in local subdomain.
+// A color zero at some level is considered zero on all coarser levels too.
+// Skipping is done per color only: a color active in one of the subdivx
+// subdomains is smoothed over the whole local grid, since the FD operators
+// apply to complete GridFunc's. Its zero parts are cleared by app_mask().
+template <typename T>
+void Preconditioning<T>::setActiveColors()
+{
+    const short subdivx = overlapping_gids_.size();
+    const int ncolors   = overlapping_gids_[0].size();
+
+    active_colors_.resize(max_levels_ + 1);
+    is_active_color_.resize(max_levels_ + 1);
+    for (short level = 0; level <= max_levels_; level++)
+    {
+        active_colors_[level].clear();
+        is_active_color_[level].assign(ncolors, false);
+        for (int color = 0; color < ncolors; color++)
+        {
+            if (level > 0 && !is_active_color_[level - 1][color]) continue;
+
+            for (short iloc = 0; iloc < subdivx; iloc++)
+            {
+                const int st = overlapping_gids_[iloc][color];
+                if (st == -1) continue;
+
+                map<int, GridMask*>::const_iterator it = gid2mask_.find(st);
+                assert(it != gid2mask_.end());
+                if (!(it->second)->maskIs0(level, iloc))
+                {
+                    is_active_color_[level][color] = true;
+                    break;
+                }
+            }
+            if (is_active_color_[level][color])
+                active_colors_[level].push_back(color);
+        }
+    }
+}
+
+// Damped Jacobi smoothing, fused with mask application.
+// Colors that are zero everywhere in local subdomain are skipped.
+template <typename T>
+void Preconditioning<T>::smooth(pb::GridFuncVector<T>& gfv_v,
+    const pb::GridFuncVector<T>& gfv_f, const short level, const short nu)
+{
+    pb::Lap<T>* myoper = precond_oper_[level];
+    const double scale = myoper->jacobiScale();
+
+    pb::GridFuncVector<T>& work(*gfv_work_[level]);
+    const vector<int>& active_colors(active_colors_[level]);
+    const int nactive = (int)active_colors.size();
+
+    for (short it = 0; it < nu; it++)
+    {
+        gfv_v.trade_boundaries();
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < nactive; i++)
+        {
+            const int k = active_colors[i];
+            myoper->apply(gfv_v.func(k), work.func(k));
+            work.func(k) -= gfv_f.func(k);
+            gfv_v.func(k).axpy(scale, work.func(k));
+            app_mask(gfv_v.func(k), level, k);
+        }
+
+        gfv_v.set_updated_boundaries(false);
+    }
+}
+
+// MG V-cycle with masks corresponding to each color
 template <typename T>
 void Preconditioning<T>::mg(pb::GridFuncVector<T>& gfv_v,
     const pb::GridFuncVector<T>& gfv_f, const short level)
@@ -168,17 +240,22 @@ void Preconditioning<T>::mg(pb::GridFuncVector<T>& gfv_v,
     if (onpe0)
         (*MPIdata::sout) << "Preconditioning::mg() at level " << level << endl;
 #endif
+    if (level == 0)
+    {
+        // masks may have changed since last call
+        setActiveColors();
+
+        // colors not active on finest level are set to zero once for all
+        const int nfunc = (int)gfv_v.size();
+        for (int k = 0; k < nfunc; k++)
+            if (!is_active_color_[0][k]) gfv_v.func(k).resetData();
+    }
+
     short ncycl = 2;
     if (level == max_levels_) ncycl = 4;
 
-    pb::Lap<T>* myoper = precond_oper_[level];
-
     // SMOOTHING
-    for (short it = 0; it < ncycl; it++)
-    {
-        myoper->jacobi(gfv_v, gfv_f, *gfv_work_[level]);
-        app_mask(gfv_v, level);
-    }
+    smooth(gfv_v, gfv_f, level, ncycl);
 
     if (level == max_levels_) return;
 
@@ -210,11 +287,7 @@ void Preconditioning<T>::mg(pb::GridFuncVector<T>& gfv_v,
     gfv_v -= (*gfv_work_[level]);
 
     // post-smoothing
-    for (short it = 0; it < 2; it++)
-    {
-        myoper->jacobi(gfv_v, gfv_f, *gfv_work_[level]);
-        app_mask(gfv_v, level);
-    }
+    smooth(gfv_v, gfv_f, level, 2);
 
     if (bc_[0] != 1 || bc_[2] != 1 || bc_[2] != 1) gfv_v.trade_boundaries();
 }
@@ -274,17 +347,20 @@ void Preconditioning<T>::mg(pb::GridFunc<T>& gf_v, const pb::GridFunc<T>& gf_f,
     if (bc_[0] != 1 || bc_[2] != 1 || bc_[2] != 1) gf_v.trade_boundaries();
 }
 
+// apply masks to active colors only
+// (others are not used in V-cycle)
 template <typename T>
 void Preconditioning<T>::app_mask(
     pb::GridFuncVector<T>& gvu, const short level) const
 {
-    const int nfunc = (int)gvu.size();
+    const vector<int>& active_colors(active_colors_[level]);
+    const int nactive = (int)active_colors.size();
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for (int k = 0; k < nfunc; k++)
+    for (int i = 0; i < nactive; i++)
     {
-        app_mask(gvu.func(k), level, k);
+        app_mask(gvu.func(active_colors[i]), level, active_colors[i]);
     }
 }
 
@@ -39,10 +39,20 @@ class Preconditioning
     std::map<int, GridMask*> gid2mask_; // map state->mask;
     std::vector<std::vector<int>> overlapping_gids_;
 
+    // for each level, list of colors with a mask not zero
+    // everywhere in local subdomain (for that level and coarser ones)
+    std::vector<std::vector<int>> active_colors_;
+    std::vector<std::vector<bool>> is_active_color_;
+
+    void setActiveColors();
+
     void app_mask(
         pb::GridFunc<T>&, const short level, const int istate = -1) const;
     void app_mask(pb::GridFuncVector<T>&, const short level) const;
 
+    void smooth(pb::GridFuncVector<T>& gf_v, const pb::GridFuncVector<T>& gf_f,
+        const short level, const short nu);
+
 public:
     Preconditioning(const short lap_type, const short maxlevels,
         const pb::Grid& grid, const short bc[3]);
@@ -10,6 +10,7 @@
 
 #include "ProjectedMatrices.h"
 
+#include "ChebyshevFermi.h"
 #include "Control.h"
 #include "DensityMatrix.h"
 #include "GramMatrix.h"
@@ -42,11 +43,9 @@ Timer ProjectedMatrices::update_submatT_tm_("ProjectedMatrices::updateSubmatT");
 Timer ProjectedMatrices::update_submatX_tm_("ProjectedMatrices::updateSubmatX");
 Timer ProjectedMatrices::eigsum_tm_("ProjectedMatrices::eigsum");
 Timer ProjectedMatrices::consolidate_H_tm_("ProjectedMatrices::consolidate_sH");
+Timer ProjectedMatrices::chebyshev_tm_("ProjectedMatrices::chebyshev");
 
-// const short LocGridOrbitals::sparse_distmatrix_nb_tasks_per_partitions_=96;
-// const short LocGridOrbitals::sparse_distmatrix_nb_tasks_per_partitions_=256;
-short ProjectedMatrices::sparse_distmatrix_nb_tasks_per_partitions_ = 256;
-short ProjectedMatrices::n_instances_                               = 0;
+short ProjectedMatrices::n_instances_ = 0;
 
 dist_matrix::RemoteTasksDistMatrix<DISTMATDTYPE>*
     ProjectedMatrices::remote_tasks_DistMatrix_
@@ -54,8 +53,6 @@ dist_matrix::RemoteTasksDistMatrix<DISTMATDTYPE>*
 GramMatrix* ProjectedMatrices::gram_4dotProducts_  = 0;
 DensityMatrix* ProjectedMatrices::dm_4dot_product_ = 0;
 
-static int sparse_distmatrix_nb_partitions = 128;
-
 ProjectedMatrices::ProjectedMatrices(const int ndim, const bool with_spin)
     : with_spin_(with_spin),
       dim_(ndim),
@@ -64,6 +61,9 @@ ProjectedMatrices::ProjectedMatrices(const int ndim, const bool with_spin)
 {
     width_           = 0.;
     min_val_         = 0.25;
+    nb_eigenpairs_   = ndim;
+    cheb_width_      = -1.;
+    cheb_entropy_    = 0.;
 
     sH_ = 0;
 
@@ -80,10 +80,6 @@ ProjectedMatrices::ProjectedMatrices(const int ndim, const bool with_spin)
         work_.reset( new dist_matrix::DistMatrix<DISTMATDTYPE>("work", ndim, ndim) );
     }
 
-    if (onpe0)
-        (*MPIdata::sout)
-            << "ProjectedMatrices: sparse_distmatrix_nb_tasks_per_partitions_="
-            << sparse_distmatrix_nb_tasks_per_partitions_ << endl;
     n_instances_++;
 }
 
@@ -137,8 +133,8 @@ void ProjectedMatrices::setup(
 #endif
 
 #ifdef USE_MPI
-    sH_ = new dist_matrix::SparseDistMatrix<DISTMATDTYPE>(comm, *matH_,
-        remote_tasks_DistMatrix_, sparse_distmatrix_nb_partitions);
+    sH_ = new dist_matrix::SparseDistMatrix<DISTMATDTYPE>(
+        comm, *matH_, remote_tasks_DistMatrix_);
 #else
     sH_ = new dist_matrix::SparseDistMatrix<DISTMATDTYPE>(
         0, *matH_, remote_tasks_DistMatrix_);
@@ -208,11 +204,60 @@ void ProjectedMatrices::setDMto2InvS()
     dm_->setto2InvS(gm_->getInverse(), gm_->getAssociatedOrbitalsIndex());
 }
 
+// number of eigenpairs needed to build DM:
+// occupied states plus a few unoccupied ones
+int ProjectedMatrices::nbEigenpairsNeeded() const
+{
+    Control& ct = *(Control::instance());
+
+    const int nocc = (nel_ + 1) / 2;
+
+    return std::min((int)dim_, nocc + ct.nbExtraEigenpairs());
+}
+
+// solve standard symmetric eigenvalue problem with ScaLapack
+// solver selected in Control
+void ProjectedMatrices::solveStdEigenProblem(
+    dist_matrix::DistMatrix<DISTMATDTYPE>& mat,
+    dist_matrix::DistMatrix<DISTMATDTYPE>& z, const char job, const int nev)
+{
+    Control& ct = *(Control::instance());
+
+    nb_eigenpairs_ = dim_;
+
+    if (job == 'n')
+    {
+        mat.syev(job, 'l', eigenvalues_, z);
+        return;
+    }
+
+    switch (ct.DistEigensolver())
+    {
+        case DistEigensolverType::Syevd:
+            mat.syevd('l', eigenvalues_, z);
+            break;
+        case DistEigensolverType::Syevr:
+            // columns of z beyond nev are not set by solver
+            if (nev < (int)dim_) z.clear();
+            mat.syevr('l', 0, nev - 1, eigenvalues_, z);
+            nb_eigenpairs_ = nev;
+            break;
+        default:
+            mat.syev(job, 'l', eigenvalues_, z);
+    }
+
+    // states not computed are left unoccupied
+    // (see computeChemicalPotentialAndOccupations())
+    for (int i = nb_eigenpairs_; i < (int)dim_; i++)
+        eigenvalues_[i] = eigenvalues_[nb_eigenpairs_ - 1];
+}
+
 void ProjectedMatrices::solveGenEigenProblem(
     dist_matrix::DistMatrix<DISTMATDTYPE>& z, vector<DISTMATDTYPE>& val,
-    char job)
+    char job, const int nev)
 {
     assert(val.size() == eigenvalues_.size());
+    assert(nev <= (int)dim_);
 
     sygv_tm_.start();
 
@@ -222,7 +267,7 @@ void ProjectedMatrices::solveGenEigenProblem(
     gm_->sygst(mat);
 
     // solve a standard symmetric eigenvalue problem
-    mat.syev(job, 'l', eigenvalues_, z);
+    solveStdEigenProblem(mat, z, job, nev < 0 ? dim_ : nev);
 
     // Get the eigenvectors Z of the generalized eigenvalue problem
     // Solve Z=L**(-T)*U
@@ -262,11 +307,28 @@ void ProjectedMatrices::updateDMwithEigenstates(const int iterative_index)
     vector<DISTMATDTYPE> val(dim_);
 
     // solves generalized eigenvalue problem
-    // and return solution in zz and val
-    solveGenEigenProblem(zz, val);
+    // and return solution in zz and val.
+    // Only occupied states are needed to build DM
+    const int nev = (ct.DistEigensolver() == DistEigensolverType::Syevr)
+                        ? nbEigenpairsNeeded()
+                        : (int)dim_;
+    solveGenEigenProblem(zz, val, 'v', nev);
     double final_mu = computeChemicalPotentialAndOccupations();
     if (onpe0 && ct.verbose > 1) cout << "Final mu_ = " << final_mu << endl;
 
+    if (nb_eigenpairs_ < (int)dim_ && width_ > 1.e-10 && onpe0)
+    {
+        // occupation of highest state computed
+        const double occ = 1.
+            / (1. + exp((eigenvalues_[nb_eigenpairs_ - 1] - mu_) / width_));
+        if (occ > 1.e-8)
+            (*MPIdata::sout) << "WARNING: occupation of highest computed "
+                                "eigenstate = "
+                             << occ
+                             << ", increase DensityMatrix.nb_extra_eigenpairs"
+                             << endl;
+    }
+
     // Build the density matrix X
     // X = Z * gamma * Z^T
     buildDM(zz, iterative_index);
@@ -327,6 +389,122 @@ void ProjectedMatrices::updateDMwithSP2(const int iterative_index)
 #endif
 }
 
+// Fermi-operator expansion of DM with Chebyshev polynomials.
+// With S=L*L^T and Hs=L^{-1}*HB*L^{-T}, DM=L^{-T}*f(Hs)*L^{-1},
+// where f is the Fermi-Dirac function.
+// Uses only matrix-matrix multiplications
+void ProjectedMatrices::updateDMwithChebApproximation(const int iterative_index)
+{
+    Control& ct = *(Control::instance());
+
+    if (onpe0 && ct.verbose > 1)
+        (*MPIdata::sout)
+            << "ProjectedMatrices: Compute DM using Chebyshev approximation\n";
+
+    chebyshev_tm_.start();
+
+    // spectral bounds
+    vector<double> interval;
+    computeGenEigenInterval(interval, ct.dm_approx_power_maxits, 0.05);
+    const double emin = interval[0];
+    const double emax = interval[1];
+
+    // a finite width is needed for a polynomial approximation
+    // of the Fermi function
+    double width = width_;
+    const double min_width = ChebyshevFermi::minWidth(
+        emin, emax, ct.dm_approx_order, ct.dm_approx_ndigits);
+    if (width < min_width)
+    {
+        if (onpe0 && ct.verbose > 0)
+            (*MPIdata::sout) << "Chebyshev approximation of DM uses width "
+                             << min_width << " instead of " << width_ << endl;
+        width = min_width;
+    }
+    const int order = std::min((int)ct.dm_approx_order,
+        ChebyshevFermi::estimateOrder(emin, emax, width, ct.dm_approx_ndigits));
+
+    ChebyshevFermi cheb(emin, emax, width, order);
+
+    // Hs, with spectrum mapped onto [-1,1]
+    dist_matrix::DistMatrix<DISTMATDTYPE> hs(*matHB_);
+    gm_->sygst(hs);
+    // symmetrize (only lower triangular part set by sygst)
+    vector<DISTMATDTYPE> diag(dim_);
+    hs.getDiagonalValues(&diag[0]);
+    hs.trset('l');
+    work_->transpose(hs);
+    hs.axpy(1., *work_);
+    hs.setDiagonal(diag);
+    hs.shift(-cheb.center());
+    hs.scal(cheb.scale());
+
+    // moments tr(T_k(Hs)) for k=0..order, using
+    // T_{2k}=2*T_k*T_k-T_0 and T_{2k+1}=2*T_{k+1}*T_k-T_1
+    // so that only order/2 matrix multiplications are needed
+    const int half = order / 2;
+    vector<double> moments(2 * half + 2);
+    moments[0] = (double)dim_;
+    moments[1] = hs.trace();
+
+    dist_matrix::DistMatrix<DISTMATDTYPE> tkm1("Tkm1", dim_, dim_);
+    dist_matrix::DistMatrix<DISTMATDTYPE> tk(hs);
+    dist_matrix::DistMatrix<DISTMATDTYPE> tkp1("Tkp1", dim_, dim_);
+    tkm1.identity();
+    for (int k = 1; k <= half; k++)
+    {
+        moments[2 * k] = 2. * tk.traceProduct(tk) - moments[0];
+
+        tkp1 = tkm1;
+        tkp1.gemm('n', 'n', 2., hs, tk, -1.);
+        moments[2 * k + 1] = 2. * tkp1.traceProduct(tk) - moments[1];
+
+        tkm1 = tk;
+        tk   = tkp1;
+    }
+
+    // chemical potential from moments only
+    mu_ = cheb.computeChemicalPotential(moments, 0.5 * nel_);
+    if (onpe0 && ct.verbose > 1)
+        (*MPIdata::sout) << "Chebyshev approximation of DM with order "
+                         << order << ", width = " << width
+                         << ", mu = " << mu_ << endl;
+
+    // entropy from same moments, to avoid a diagonalization later
+    cheb_width_   = width;
+    cheb_entropy_ = dm_->getOrbitalOccupation() * cheb.entropy(moments, mu_);
+
+    vector<double> coeffs;
+    cheb.computeCoefficients(mu_, coeffs);
+
+    // f(Hs) = sum_k c_k*T_k(Hs)
+    dist_matrix::DistMatrix<DISTMATDTYPE> fmat("f", dim_, dim_);
+    fmat.identity();
+    fmat.scal(coeffs[0]);
+    fmat.axpy(coeffs[1], hs);
+    tkm1.identity();
+    tk = hs;
+    for (int k = 2; k <= order; k++)
+    {
+        tkp1 = tkm1;
+        tkp1.gemm('n', 'n', 2., hs, tk, -1.);
+        fmat.axpy(coeffs[k], tkp1);
+
+        tkm1 = tk;
+        tk   = tkp1;
+    }
+
+    // DM = occupation*L^{-T}*f(Hs)*L^{-1}
+    gm_->solveLST(fmat);
+    work_->transpose(fmat);
+    gm_->solveLST(*work_);
+    work_->scal(dm_->getOrbitalOccupation());
+
+    dm_->setMatrix(*work_, iterative_index);
+
+    chebyshev_tm_.stop();
+}
+
 void ProjectedMatrices::updateDM(const int iterative_index)
 {
     Control& ct = *(Control::instance());
@@ -335,6 +513,8 @@ void ProjectedMatrices::updateDM(const int iterative_index)
         updateDMwithEigenstates(iterative_index);
     else if(ct.DMEigensolver() == DMEigensolverType::SP2)
         updateDMwithSP2(iterative_index);
+    else if (ct.DMEigensolver() == DMEigensolverType::Chebyshev)
+        updateDMwithChebApproximation(iterative_index);
     else
     {
         cerr<<"Eigensolver not available in ProjectedMatrices::updateDM()\n";
@@ -479,7 +659,13 @@ double ProjectedMatrices::computeEntropy()
     // if(onpe0)(*MPIdata::sout)<<"width_="<<width_<<endl;
 
     Control& ct = *(Control::instance());
-    double entropy;
+    double entropy = 0.;
+
+    // entropy of last DM computed by Chebyshev expansion
+    // (before mixing), with the width actually used in expansion
+    if (ct.DMEigensolver() == DMEigensolverType::Chebyshev
+        && cheb_width_ > 0.)
+        return cheb_width_ * cheb_entropy_;
 
     if (ct.DMEigensolver() == DMEigensolverType::Eigensolver
         || ct.DMEigensolver() == DMEigensolverType::SP2
@@ -639,7 +825,7 @@ void ProjectedMatrices::printEigenvaluesEV(ostream& os) const
         os.setf(ios::right, ios::adjustfield);
         os.setf(ios::fixed, ios::floatfield);
         os << setprecision(3);
-        for (int i = 0; i < dim_; i++)
+        for (int i = 0; i < nb_eigenpairs_; i++)
         {
             if ((i % 10) == 0) os << endl;
             os << setw(7) << RY2EV * eigenvalues_[i] << " ";
@@ -662,7 +848,7 @@ void ProjectedMatrices::printEigenvaluesHa(ostream& os) const
         os.setf(ios::right, ios::adjustfield);
         os.setf(ios::fixed, ios::floatfield);
         os << setprecision(3);
-        for (int i = 0; i < dim_; i++)
+        for (int i = 0; i < nb_eigenpairs_; i++)
         {
             if ((i % 10) == 0) os << endl;
             os << setw(7) << 0.5 * eigenvalues_[i] << " ";
@@ -914,6 +1100,7 @@ void ProjectedMatrices::printTimers(ostream& os)
     init_gram_matrix_tm_.print(os);
     eigsum_tm_.print(os);
     consolidate_H_tm_.print(os);
+    chebyshev_tm_.print(os);
 }
 
 // Assumes SquareLocalMatrix object contains partial contributions
@@ -38,8 +38,6 @@ class HDFrestart;
 class ProjectedMatrices : public ProjectedMatricesInterface
 {
     static short n_instances_;
-
-    static short sparse_distmatrix_nb_tasks_per_partitions_;
     static GramMatrix* gram_4dotProducts_;
     static DensityMatrix* dm_4dot_product_;
 
@@ -48,6 +46,9 @@ class ProjectedMatrices : public ProjectedMatricesInterface
 
     std::vector<DISTMATDTYPE> eigenvalues_;
 
+    // number of eigenpairs computed in last diagonalization
+    int nb_eigenpairs_;
+
     /*!
      * matrices to save old values and enable mixing or reset
      */
@@ -56,6 +57,11 @@ class ProjectedMatrices : public ProjectedMatricesInterface
 
     double min_val_;
 
+    // width used in last Chebyshev approximation of DM (<0 if none)
+    // and entropy of that approximation (in units of width)
+    double cheb_width_;
+    double cheb_entropy_;
+
     static Timer sygv_tm_;
     static Timer compute_inverse_tm_;
     static Timer compute_invB_tm_;
@@ -65,6 +71,7 @@ class ProjectedMatrices : public ProjectedMatricesInterface
     static Timer update_submatX_tm_;
     static Timer eigsum_tm_;
     static Timer consolidate_H_tm_;
+    static Timer chebyshev_tm_;
 
     static dist_matrix::RemoteTasksDistMatrix<DISTMATDTYPE>*
         remote_tasks_DistMatrix_;
@@ -90,9 +97,15 @@ class ProjectedMatrices : public ProjectedMatricesInterface
 
     double computeChemicalPotentialAndOccupations()
     {
-        return computeChemicalPotentialAndOccupations(width_, nel_, dim_);
+        return computeChemicalPotentialAndOccupations(
+            width_, nel_, nb_eigenpairs_);
     }
 
+    int nbEigenpairsNeeded() const;
+    void solveStdEigenProblem(dist_matrix::DistMatrix<DISTMATDTYPE>& mat,
+        dist_matrix::DistMatrix<DISTMATDTYPE>& z, const char job,
+        const int nev);
+
 protected:
     // indexes corresponding to valid function in each subdomain
     std::vector<std::vector<int>> global_indexes_;
@@ -312,8 +325,10 @@ public:
     double getExpectation(const dist_matrix::DistMatrix<DISTMATDTYPE>& A);
     double getExpectationH();
 
+    // solve generalized eigenvalue problem HB*z=S*z*val
+    // for the lowest nev eigenpairs (all of them if nev<0)
     void solveGenEigenProblem(dist_matrix::DistMatrix<DISTMATDTYPE>& zz,
-        std::vector<DISTMATDTYPE>& val, char job = 'v');
+        std::vector<DISTMATDTYPE>& val, char job = 'v', const int nev = -1);
     void computeOccupationsFromDM();
 
     virtual void rotateAll(
@@ -348,6 +363,7 @@ public:
     void updateDM(const int iterative_index);
     void updateDMwithEigenstates(const int iterative_index);
     void updateDMwithSP2(const int iterative_index);
+    void updateDMwithChebApproximation(const int iterative_index);
     void updateDMwithEigenstatesAndRotate(
         const int iterative_index, dist_matrix::DistMatrix<DISTMATDTYPE>& zz);
     double computeChemicalPotentialAndOccupations(
@@ -0,0 +1,150 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "SCFController.h"
+#include "MGmol_MPI.h"
+
+#include <iomanip>
+#include <mpi.h>
+
+using namespace std;
+
+// max. number of iterations between two DM updates
+static const short max_dm_period = 4;
+
+// reduction rates of energy variation for fast and slow convergence
+static const double fast_rate = 0.3;
+static const double slow_rate = 0.7;
+
+// DM updates are skipped only if they are at least that fraction of
+// iteration cost
+static const double min_dm_cost_fraction = 0.05;
+
+// energy variations larger than loose_factor*tol are considered far
+// from convergence
+static const double loose_factor = 1.e3;
+
+static const char* const phase_names[SCFController::NbPhases]
+    = { "Density", "Hartree", "Hamiltonian", "Orbitals update", "DM update" };
+
+SCFController::SCFController(const bool active, const double tol)
+    : active_(active),
+      tol_(tol),
+      dm_period_(1),
+      steps_since_dm_update_(0),
+      dm_updated_(true),
+      start_time_(0.),
+      niterations_(0)
+{
+    de_[0] = 1.e9;
+    de_[1] = 1.e9;
+    for (short p = 0; p < NbPhases; p++)
+    {
+        phase_time_[p]     = 0.;
+        phase_calls_[p]    = 0;
+        iteration_time_[p] = 0.;
+    }
+}
+
+void SCFController::startPhase() { start_time_ = MPI_Wtime(); }
+
+void SCFController::stopPhase(const Phase phase)
+{
+    iteration_time_[phase] += MPI_Wtime() - start_time_;
+    phase_calls_[phase]++;
+}
+
+double SCFController::dmCostFraction() const
+{
+    double total = 0.;
+    for (short p = 0; p < NbPhases; p++)
+        total += phase_time_[p];
+    if (total <= 0.) return 0.;
+
+    // average cost of one DM update relative to average iteration cost
+    const double dm_cost = phase_calls_[DMUpdate] > 0
+                               ? phase_time_[DMUpdate] / phase_calls_[DMUpdate]
+                               : 0.;
+    return dm_cost * niterations_ / total;
+}
+
+void SCFController::endIteration(const double de)
+{
+    if (!active_) return;
+
+    // reduce times over tasks so that all tasks take the same decisions
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+    mmpi.allreduce(&iteration_time_[0], NbPhases, MPI_MAX);
+    for (short p = 0; p < NbPhases; p++)
+    {
+        phase_time_[p] += iteration_time_[p];
+        iteration_time_[p] = 0.;
+    }
+    niterations_++;
+
+    de_[1] = de_[0];
+    de_[0] = de;
+
+    const double rate = de_[0] / de_[1];
+    if (de_[0] < 10. * tol_ || rate > slow_rate)
+    {
+        // close to convergence or slow convergence: back to full DM updates
+        dm_period_ = 1;
+    }
+    else if (rate < fast_rate && dmCostFraction() > min_dm_cost_fraction)
+    {
+        if (dm_period_ < max_dm_period) dm_period_++;
+    }
+}
+
+short SCFController::hartreeSweeps(const short max_sweeps) const
+{
+    if (active_ && de_[0] > loose_factor * tol_)
+    {
+        const short nsweeps = max_sweeps / 2;
+        return nsweeps > 0 ? nsweeps : 1;
+    }
+
+    return max_sweeps;
+}
+
+bool SCFController::updateDM()
+{
+    if (!active_)
+    {
+        dm_updated_ = true;
+        return true;
+    }
+
+    steps_since_dm_update_++;
+    dm_updated_ = (steps_since_dm_update_ >= dm_period_);
+    if (dm_updated_) steps_since_dm_update_ = 0;
+
+    return dm_updated_;
+}
+
+void SCFController::printCosts(ostream& os) const
+{
+    double total = 0.;
+    for (short p = 0; p < NbPhases; p++)
+        total += phase_time_[p];
+
+    os << "SCF cost per phase after " << niterations_ << " iterations:" << endl;
+    for (short p = 0; p < NbPhases; p++)
+    {
+        os << setw(20) << phase_names[p] << ": " << setprecision(3) << fixed
+           << phase_time_[p] << " s, " << setw(4) << phase_calls_[p]
+           << " calls";
+        if (total > 0.)
+            os << ", " << setprecision(1) << 100. * phase_time_[p] / total
+               << "%";
+        os << endl;
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_SCFCONTROLLER_H
+#define MGMOL_SCFCONTROLLER_H
+
+#include <iostream>
+
+// Adaptive control of SCF iterations:
+// monitors the reduction rate of the energy variation from one iteration
+// to the next, and the cost of each phase of an iteration,
+// to cheapen or skip some phases while far from convergence:
+// - fewer Hartree solver sweeps while energy variation is large,
+// - density matrix updated only every k iterations while convergence
+//   is fast, if DM update is a significant fraction of iteration cost.
+class SCFController
+{
+public:
+    enum Phase
+    {
+        Density,
+        Hartree,
+        Hamiltonian,
+        OrbitalsUpdate,
+        DMUpdate,
+        NbPhases
+    };
+
+private:
+    const bool active_;
+
+    // target tolerance on energy variation
+    const double tol_;
+
+    // last two energy variations
+    double de_[2];
+
+    // DM updated every dm_period_ iterations
+    short dm_period_;
+    short steps_since_dm_update_;
+    bool dm_updated_;
+
+    // accumulated cost of each phase (max. over MPI tasks)
+    double phase_time_[NbPhases];
+    int phase_calls_[NbPhases];
+
+    // cost of each phase during current iteration
+    double iteration_time_[NbPhases];
+    double start_time_;
+
+    int niterations_;
+
+    double dmCostFraction() const;
+
+public:
+    SCFController(const bool active, const double tol);
+
+    bool active() const { return active_; }
+
+    void startPhase();
+    void stopPhase(const Phase phase);
+
+    // end of iteration with energy variation de:
+    // update cost accounting and adapt DM update period
+    void endIteration(const double de);
+
+    // number of sweeps to use in Hartree solver
+    short hartreeSweeps(const short max_sweeps) const;
+
+    // should DM be updated at this iteration?
+    bool updateDM();
+
+    // true if DM was updated at the end of last iteration,
+    // so that energy variation can be trusted for convergence
+    bool dmUpToDate() const { return dm_updated_; }
+
+    void printCosts(std::ostream& os) const;
+};
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "SP2.h"
 #include "linear_algebra/blas3_c.h"
+#include "DeterministicReduce.h"
 #include "DistMatrix.h"
 #include "LocalMatrices2DistMatrix.h"
 #include "MGmol_MPI.h"
@@ -22,18 +23,17 @@ double computePartialTrace(bml_matrix_t* A, const vector<int>& ids)
 {
     assert(A != 0);
 
-    double trace = 0.;
-    const int n  = (int)ids.size();
+    const int n = (int)ids.size();
+    vector<double> diag(n);
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : trace)
+#pragma omp parallel for
 #endif
     for (int i = 0; i < n; i++)
     {
-        assert(ids[i] < m);
-        trace += *((double*)bml_get(A, ids[i], ids[i]));
+        diag[i] = *((double*)bml_get(A, ids[i], ids[i]));
     }
 
-    return trace;
+    return deterministicSum(n, &diag[0]);
 }
 #endif
 
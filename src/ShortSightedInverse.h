@@ -109,6 +109,8 @@ public:
     void printGramMat(std::ostream& os, int nrows = NUM_PRINT_ROWS) const;
     double getTraceDotProductWithInvS(VariableSizeMatrix<sparserow>* mat);
     static void printTimers(std::ostream& os); // print timers
+    // accumulated time spent computing the local inverse on this task
+    static double computeInvSTime() { return compute_invS_tm_.realTime(); }
     ~ShortSightedInverse(); // destructor
 
     /* get the initial local size */
@@ -28,8 +28,6 @@
 #include "ProjectedMatricesInterface.h"
 #include "ProjectedMatricesSparse.h"
 
-static int sparse_distmatrix_nb_partitions = 128;
-
 template <>
 template <>
 void MGmol<LocGridOrbitals>::addHlocal2matrix(LocGridOrbitals& orbitalsi,
@@ -192,7 +190,7 @@ void MGmol<T>::computeHij_private(T& orbitals_i, T& orbitals_j,
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
     MPI_Comm comm   = mmpi.commSameSpin();
     dist_matrix::SparseDistMatrix<DISTMATDTYPE> sparseH(
-        comm, hij, remote_tasks_DistMatrix_, sparse_distmatrix_nb_partitions);
+        comm, hij, remote_tasks_DistMatrix_);
 #else
     dist_matrix::SparseDistMatrix<DISTMATDTYPE> sparseH(
         0, hij, rtasks_distmatrix);
@@ -244,7 +242,7 @@ void MGmol<T>::computeHij_private(T& orbitals_i, T& orbitals_j,
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
     MPI_Comm comm   = mmpi.commSameSpin();
     dist_matrix::SparseDistMatrix<DISTMATDTYPE> sparseH(
-        comm, hij, remote_tasks_DistMatrix_, sparse_distmatrix_nb_partitions);
+        comm, hij, remote_tasks_DistMatrix_);
 #else
     dist_matrix::SparseDistMatrix<DISTMATDTYPE> sparseH(
         0, hij, rtasks_distmatrix);
@@ -403,21 +401,17 @@ void MGmol<T>::computeHnlPhiAndAdd2HPhi(Ions& ions, T& phi,
         }
         else // no Mehrstellen
         {
+            // add Hnl*phi directly to H*phi, by blocks of colors
+            const short bsize = 16;
+            ORBDTYPE* hpsi    = hphi.getPsi(0);
+            const int lda     = hphi.getLda();
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel for
 #endif
+            for (short icolor = 0; icolor < ncolors; icolor += bsize)
             {
-                ORBDTYPE* hnl = new ORBDTYPE[numpt];
-#ifdef _OPENMP
-#pragma omp for
-#endif
-                for (short icolor = 0; icolor < ncolors; icolor++)
-                {
-                    get_vnlpsi(ions, gid, icolor, kbpsi, hnl);
-                    MPaxpy(numpt, 1., hnl, hphi.getPsi(icolor));
-                }
-
-                delete[] hnl;
+                const short nb = min(bsize, (short)(ncolors - icolor));
+                add_vnlpsi(ions, gid, icolor, nb, kbpsi, hpsi, lda);
             }
         }
     }
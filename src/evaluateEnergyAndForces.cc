@@ -0,0 +1,121 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "Control.h"
+#include "DFTsolver.h"
+#include "ExtendedGridOrbitals.h"
+#include "Ions.h"
+#include "LocGridOrbitals.h"
+#include "MGmol.h"
+#include "MGmol_MPI.h"
+#include "MPIdata.h"
+
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <vector>
+using namespace std;
+
+Timer evaluate_tm("evaluateEnergyAndForces");
+
+template <class T>
+double MGmol<T>::evaluateEnergyAndForces(
+    const vector<double>& tau, vector<double>& forces)
+{
+    assert((int)tau.size() == 3 * ions_->getNumIons());
+
+    evaluate_tm.start();
+
+    Control& ct = *(Control::instance());
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+
+    // new positions of local ions
+    vector<Ion*>& local_ions(ions_->local_ions());
+    vector<double> ltau(3 * local_ions.size());
+    double maxdisp = 0.;
+    for (unsigned i = 0; i < local_ions.size(); i++)
+    {
+        const int index = local_ions[i]->index();
+        for (short d = 0; d < 3; d++)
+        {
+            ltau[3 * i + d] = tau[3 * index + d];
+            maxdisp         = max(
+                maxdisp, fabs(ltau[3 * i + d] - local_ions[i]->position(d)));
+        }
+    }
+    mmpi.allreduce(&maxdisp, 1, MPI_MAX);
+
+    // update ions, potentials and orbitals only if atoms moved
+    if (maxdisp > 0.)
+    {
+        ions_->setPositions(ltau);
+        ions_->setup();
+
+        moveVnuc(*ions_);
+        move_orbitals(&current_orbitals_);
+    }
+
+    // first call starts from initial guess, later calls from
+    // the electronic structure of previous configuration
+    if (nevaluations_ == 0) DFTsolver<T>::resetItCount();
+
+    double eks       = 0.;
+    const int iprint = (nevaluations_ == 0) ? 20 : 0;
+    const int retval = quench(
+        current_orbitals_, *ions_, ct.max_electronic_steps, iprint, eks);
+    if (retval < 0 && onpe0)
+        os_ << "WARNING evaluateEnergyAndForces(): quench returned value "
+            << retval << endl;
+    total_energy_ = eks;
+
+    force(*current_orbitals_, *ions_);
+
+    // forces of all ions on all tasks
+    forces.clear();
+    ions_->gatherForces(forces, 0);
+    mmpi.bcast(&forces[0], (int)forces.size());
+
+    if (onpe0 && ct.verbose > 0)
+        os_ << setprecision(12) << fixed << "%%  " << nevaluations_
+            << "  IONIC CONFIGURATION ENERGY = " << eks << endl;
+
+    nevaluations_++;
+
+    evaluate_tm.stop();
+
+    return eks;
+}
+
+template <class T>
+void MGmol<T>::evaluateEnergyAndForces(const vector<vector<double>>& taus,
+    vector<double>& energies, vector<vector<double>>& forces)
+{
+    const int nconfigs = (int)taus.size();
+
+    energies.resize(nconfigs);
+    forces.resize(nconfigs);
+
+    // each configuration uses the previous one as starting point,
+    // so consecutive configurations should be close to each other
+    for (int i = 0; i < nconfigs; i++)
+        energies[i] = evaluateEnergyAndForces(taus[i], forces[i]);
+}
+
+template <class T>
+void MGmol<T>::getAtomicPositions(vector<double>& tau)
+{
+    MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
+
+    ions_->gatherPositions(tau, 0);
+    mmpi.bcast(&tau[0], (int)tau.size());
+}
+
+template class MGmol<LocGridOrbitals>;
+template class MGmol<ExtendedGridOrbitals>;
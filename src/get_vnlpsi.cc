@@ -10,6 +10,7 @@
 
 #include "Ions.h"
 #include "KBPsiMatrixSparse.h"
+#include "KBprojectorSparse.h"
 #include "MGmol.h"
 #include "Mesh.h"
 #include "Species.h"
@@ -86,3 +87,64 @@ void get_vnlpsi(const Ions& ions, const vector<vector<int>>& subdomain_gids,
 
     vnlpsi_tm.stop();
 }
+
+// add Vnl*psi to vpsi+color*ld for colors in [first_color,
+// first_color+ncolors), with one GEMM per ion and subdomain
+void add_vnlpsi(const Ions& ions, const vector<vector<int>>& subdomain_gids,
+    const int first_color, const int ncolors,
+    const KBPsiMatrixSparse* const kbpsi, ORBDTYPE* const vpsi, const int ld)
+{
+    if (omp_get_thread_num() == 0) vnlpsi_tm.start();
+
+    Mesh* mymesh      = Mesh::instance();
+    const int subdivx = mymesh->subdivx();
+
+    const vector<Ion*>& nl_ions(ions.overlappingNL_ions());
+
+    for (int iloc = 0; iloc < subdivx; iloc++)
+    {
+        vector<int> colors;
+        vector<int> states;
+        for (int color = first_color; color < first_color + ncolors; color++)
+            if (subdomain_gids[iloc][color] != -1)
+            {
+                colors.push_back(color);
+                states.push_back(subdomain_gids[iloc][color]);
+            }
+        if (colors.empty()) continue;
+
+        // Loop over all the ions if nl proj. overlaps with sub-domain
+        vector<Ion*>::const_iterator ion = nl_ions.begin();
+        while (ion != nl_ions.end())
+        {
+            const std::shared_ptr<KBprojector> ion_kbproj((*ion)->kbproj());
+            if (ion_kbproj->overlaps(iloc))
+            {
+                vector<int> ion_gids;
+                (*ion)->getGidsNLprojs(ion_gids);
+
+                vector<short> signs;
+                (*ion)->getKBsigns(signs);
+
+                vector<double> kbcoeffs;
+                (*ion)->getKBcoeffs(kbcoeffs);
+
+                const short nprojs = (short)ion_gids.size();
+                vector<double> coeff(nprojs * colors.size());
+                for (unsigned j = 0; j < states.size(); j++)
+                    for (short i = 0; i < nprojs; i++)
+                        coeff[i + j * nprojs]
+                            = kbpsi->getValIonState(ion_gids[i], states[j])
+                              * kbcoeffs[i] * signs[i];
+
+                ion_kbproj->axpyKetBlock(iloc, colors, coeff, vpsi, ld);
+            }
+
+            ion++;
+
+        } // end loop over ions
+
+    } // end loop over iloc
+
+    if (omp_get_thread_num() == 0) vnlpsi_tm.stop();
+}
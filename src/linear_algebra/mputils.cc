@@ -12,7 +12,10 @@
 #include "MPIdata.h"
 #include "Timer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 
 Timer dgemm_tm("dgemm");
@@ -30,6 +33,200 @@ Timer ttdot_tm("ttdot");
 
 
 
+/* Blocked kernels for mixed-precision gemm/syrk.
+ * C is divided into tiles of MC x NC elements, distributed among threads.
+ * For each tile, blocks of op(A) and op(B) of depth KC are converted to
+ * double and packed into contiguous panels of MR rows (A) and NR columns
+ * (B), which are then multiplied by a register-blocked MR x NR kernel.
+ * Products are accumulated in double in a tile buffer and C is updated
+ * once at the end with alpha and beta, so inputs are read in their
+ * original precision and only converted once per tile.
+ * Work arrays are allocated once per thread and reused between calls.
+ */
+static const int MPG_MR = 8;
+static const int MPG_NR = 4;
+static const int MPG_MC = 64;
+static const int MPG_NC = 64;
+static const int MPG_KC = 256;
+
+static double* mpgemmWorkspace()
+{
+    static thread_local std::vector<double> work(
+        (MPG_MC + MPG_NC) * MPG_KC + MPG_MC * MPG_NC);
+    return work.data();
+}
+
+// pack rows [i0,i0+mc) and columns [l0,l0+kc) of op(A)
+// into panels of MPG_MR rows, padded with zeros
+template <typename T>
+static void packA(const bool trans, const int i0, const int mc, const int l0,
+    const int kc, const T* const a, const int lda, double* __restrict__ ap)
+{
+    for (int ir = 0; ir < mc; ir += MPG_MR)
+    {
+        const int mr = std::min(MPG_MR, mc - ir);
+        if (trans)
+        {
+            for (int ii = 0; ii < mr; ii++)
+            {
+                const T* const ai = a + (size_t)lda * (i0 + ir + ii) + l0;
+                for (int l = 0; l < kc; l++)
+                    ap[l * MPG_MR + ii] = (double)ai[l];
+            }
+        }
+        else
+        {
+            for (int l = 0; l < kc; l++)
+            {
+                const T* const al = a + (size_t)lda * (l0 + l) + i0 + ir;
+                for (int ii = 0; ii < mr; ii++)
+                    ap[l * MPG_MR + ii] = (double)al[ii];
+            }
+        }
+        if (mr < MPG_MR)
+            for (int l = 0; l < kc; l++)
+                for (int ii = mr; ii < MPG_MR; ii++)
+                    ap[l * MPG_MR + ii] = 0.;
+        ap += kc * MPG_MR;
+    }
+}
+
+// pack rows [l0,l0+kc) and columns [j0,j0+nc) of op(B)
+// into panels of MPG_NR columns, padded with zeros
+template <typename T>
+static void packB(const bool trans, const int j0, const int nc, const int l0,
+    const int kc, const T* const b, const int ldb, double* __restrict__ bp)
+{
+    for (int jr = 0; jr < nc; jr += MPG_NR)
+    {
+        const int nr = std::min(MPG_NR, nc - jr);
+        if (trans)
+        {
+            for (int l = 0; l < kc; l++)
+            {
+                const T* const bl = b + (size_t)ldb * (l0 + l) + j0 + jr;
+                for (int jj = 0; jj < nr; jj++)
+                    bp[l * MPG_NR + jj] = (double)bl[jj];
+            }
+        }
+        else
+        {
+            for (int jj = 0; jj < nr; jj++)
+            {
+                const T* const bj = b + (size_t)ldb * (j0 + jr + jj) + l0;
+                for (int l = 0; l < kc; l++)
+                    bp[l * MPG_NR + jj] = (double)bj[l];
+            }
+        }
+        if (nr < MPG_NR)
+            for (int l = 0; l < kc; l++)
+                for (int jj = nr; jj < MPG_NR; jj++)
+                    bp[l * MPG_NR + jj] = 0.;
+        bp += kc * MPG_NR;
+    }
+}
+
+// c[MPG_MR x MPG_NR] += ap * bp
+static inline void microKernel(const int kc, const double* __restrict__ ap,
+    const double* __restrict__ bp, double* __restrict__ c, const int ldc)
+{
+    double acc[MPG_NR][MPG_MR];
+    for (int jj = 0; jj < MPG_NR; jj++)
+        for (int ii = 0; ii < MPG_MR; ii++)
+            acc[jj][ii] = 0.;
+
+    for (int l = 0; l < kc; l++)
+    {
+        for (int jj = 0; jj < MPG_NR; jj++)
+        {
+            const double bv = bp[jj];
+            for (int ii = 0; ii < MPG_MR; ii++)
+                acc[jj][ii] += ap[ii] * bv;
+        }
+        ap += MPG_MR;
+        bp += MPG_NR;
+    }
+
+    for (int jj = 0; jj < MPG_NR; jj++)
+        for (int ii = 0; ii < MPG_MR; ii++)
+            c[jj * ldc + ii] += acc[jj][ii];
+}
+
+// C <- alpha*op(A)*op(B) + beta*C
+// with uplo='U' or 'L', only the corresponding triangle of C is updated
+// (m==n assumed), otherwise (uplo='A') the whole matrix
+template <typename T1, typename T2, typename T3>
+static void MPgemmBlocked(const char transa, const char transb, const char uplo,
+    const int m, const int n, const int k, const double alpha,
+    const T1* const a, const int lda, const T2* const b, const int ldb,
+    const double beta, T3* const c, const int ldc)
+{
+    const bool ta    = (transa != 'N' && transa != 'n');
+    const bool tb    = (transb != 'N' && transb != 'n');
+    const bool upper = (uplo == 'U' || uplo == 'u');
+    const bool lower = (uplo == 'L' || uplo == 'l');
+
+    const int mtiles = (m + MPG_MC - 1) / MPG_MC;
+    const int ntiles = (n + MPG_NC - 1) / MPG_NC;
+
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2) schedule(dynamic) if (mtiles * ntiles > 1)
+#endif
+    for (int jt = 0; jt < ntiles; jt++)
+        for (int it = 0; it < mtiles; it++)
+        {
+            const int i0 = it * MPG_MC;
+            const int j0 = jt * MPG_NC;
+            const int mc = std::min(MPG_MC, m - i0);
+            const int nc = std::min(MPG_NC, n - j0);
+
+            // skip tiles outside triangle to compute
+            if (upper && i0 > j0 + nc - 1) continue;
+            if (lower && j0 > i0 + mc - 1) continue;
+
+            double* const ap    = mpgemmWorkspace();
+            double* const bp    = ap + MPG_MC * MPG_KC;
+            double* const ctile = bp + MPG_NC * MPG_KC;
+            memset(ctile, 0, MPG_MC * MPG_NC * sizeof(double));
+
+            if (alpha != 0.)
+                for (int l0 = 0; l0 < k; l0 += MPG_KC)
+                {
+                    const int kc = std::min(MPG_KC, k - l0);
+                    packA(ta, i0, mc, l0, kc, a, lda, ap);
+                    packB(tb, j0, nc, l0, kc, b, ldb, bp);
+
+                    for (int jr = 0; jr < nc; jr += MPG_NR)
+                        for (int ir = 0; ir < mc; ir += MPG_MR)
+                            microKernel(kc, ap + ir * kc, bp + jr * kc,
+                                ctile + jr * MPG_MC + ir, MPG_MC);
+                }
+
+            // update C
+            for (int jj = 0; jj < nc; jj++)
+            {
+                const int j = j0 + jj;
+                int ibeg    = 0;
+                int iend    = mc;
+                if (upper) iend = std::min(mc, j - i0 + 1);
+                if (lower) ibeg = std::max(0, j - i0);
+
+                T3* const cj           = c + (size_t)ldc * j + i0;
+                const double* const tj = ctile + jj * MPG_MC;
+                if (beta == 0.)
+                {
+                    for (int ii = ibeg; ii < iend; ii++)
+                        cj[ii] = (T3)(alpha * tj[ii]);
+                }
+                else
+                {
+                    for (int ii = ibeg; ii < iend; ii++)
+                        cj[ii] = (T3)(alpha * tj[ii] + beta * (double)cj[ii]);
+                }
+            }
+        }
+}
+
 /* Function definitions. See mputils.h for comments */
 
 void Tscal(const int len, const double scal, double* dptr)
@@ -198,95 +395,15 @@ void MPsyrk(const char uplo, const char trans, const int n, const int k,
     const double alpha, const float* const a, const int lda, const double beta,
     float* c, const int ldc)
 {
+    if (beta == 1. && (alpha == 0. || n == 0 || k == 0)) return;
+
     mpsyrk_tm.start();
 
-    if (beta == 1. && (alpha == 0. || n == 0 || k == 0)) return;
+    /* C = op(A)*op(A)^T with op(A) of dimension n x k */
+    const char transb = (trans == 'N' || trans == 'n') ? 'T' : 'N';
+    MPgemmBlocked(trans, transb, uplo, n, n, k, alpha, a, lda, a, lda, beta,
+        c, ldc);
 
-    /* case Trans == 'N' */
-    if (trans == 'N' || trans == 'n')
-    {
-        /* buffer to hold accumulation in double */
-        double* buff = new double[n];
-        if (uplo == 'U' || uplo == 'u')
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const int len = j + 1;
-                memset(buff, 0, len * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const float* colL = a + lda * l;
-                    /* get multiplier */
-                    double mult
-                        = (double)(alpha
-                                   * colL[j]); // same as alpha * a[lda*l + j];
-                    MPaxpy(len, mult, colL, buff);
-                }
-                /* Update col j of upper part of matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                float* cj = c + ldc * j;
-                MPscal(len, beta, cj);
-                for (int i = 0; i < len; i++)
-                    cj[i] += (float)buff[i];
-            }
-        }
-        else /* uplo = 'L' or 'l' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const int len = n - (j + 1);
-                memset(buff, 0, len * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const float* colL = a + lda * l + j;
-                    /* get multiplier */
-                    double mult
-                        = (double)(alpha
-                                   * colL[0]); // same as alpha * a[lda*l + j];
-                    MPaxpy(len, mult, colL, buff);
-                }
-                /* Update col j of upper part of matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                float* cj = c + ldc * j + j;
-                MPscal(len, beta, cj);
-                for (int i = 0; i < len; i++)
-                    cj[i] += (float)buff[i];
-            }
-        }
-    }
-    else /* Trans == 'T' or 'C' */
-    {
-        if (uplo == 'U' || uplo == 'u')
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const float* __restrict__ aj = a + lda * j;
-                for (int i = 0; i < j; i++)
-                {
-                    const int pos                = ldc * j + i;
-                    const float* __restrict__ ai = a + lda * i;
-                    double bc                    = (double)c[pos] * beta;
-                    c[pos] = (float)(alpha * MPdot(k, ai, aj) + bc);
-                }
-            }
-        }
-        else /* uplo = 'L' or 'l' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const float* __restrict__ aj = a + lda * j;
-                for (int i = j; i < n; i++)
-                {
-                    const int pos                = ldc * j + i;
-                    const float* __restrict__ ai = a + lda * i;
-                    double bc                    = (double)c[pos] * beta;
-                    c[pos] = (float)(alpha * MPdot(k, ai, aj) + bc);
-                }
-            }
-        }
-    }
     mpsyrk_tm.stop();
 }
 
@@ -355,95 +472,12 @@ void MPgemm(const char transa, const char transb, const int m, const int n,
     const float* const b, const int ldb, const double beta, float* const c,
     const int ldc)
 {
-    mpgemm_tm.start();
-
     if (beta == 1. && (alpha == 0. || m == 0 || n == 0 || k == 0)) return;
 
-    /* case transb == 'N' and transa == 'N' */
-    if (transb == 'N' || transb == 'n')
-    {
-        if (transa == 'N' || transa == 'n')
-        {
-            /* buffer to hold accumulation in double */
-            double* buff = new double[m];
-            for (int j = 0; j < n; j++)
-            {
-                memset(buff, 0, m * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const float* colL = a + lda * l;
-                    /* get multiplier */
-                    double mult = (double)(alpha * b[ldb * j + l]);
-                    MPaxpy(m, mult, colL, buff);
-                }
-                /* Update col j of of result matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                float* cj = c + ldc * j;
-                MPscal(m, beta, cj);
-                for (int i = 0; i < m; i++)
-                    cj[i] += (float)buff[i];
-            }
-        }
-        else /* transa == 'T'/'C' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const float* __restrict__ bj = b + ldb * j;
-                for (int i = 0; i < m; i++)
-                {
-                    const int pos                = ldc * j + i;
-                    double bc                    = (double)c[pos] * beta;
-                    const float* __restrict__ ai = a + lda * i;
-                    c[pos] = (float)(alpha * MPdot(k, ai, bj) + bc);
-                }
-            }
-        }
-    }
-    else /* transb == 'T'/'C' */
-    {
-        if (transa == 'N' || transa == 'n')
-        {
-            /* buffer to hold accumulation in double */
-            double* buff = new double[m];
-            for (int j = 0; j < n; j++)
-            {
-                memset(buff, 0, m * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const float* colL = a + lda * l;
-                    /* get multiplier */
-                    double mult = (double)(alpha * b[ldb * l + j]);
-                    MPaxpy(m, mult, colL, buff);
-                }
-                /* Update col j of of result matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                float* cj = c + ldc * j;
-                MPscal(m, beta, cj);
-                for (int i = 0; i < m; i++)
-                    cj[i] += (float)buff[i];
-            }
-        }
-        else /* transa == 'T'/'C' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                for (int i = 0; i < m; i++)
-                {
-                    const int pos   = ldc * j + i;
-                    const float* ai = a + lda * i;
-                    double sum      = 0.;
-                    for (int l = 0; l < k; l++)
-                    {
-                        sum += alpha * ai[l] * b[ldb * l + j];
-                    }
-                    sum += (double)(beta * c[pos]);
-                    c[pos] = (float)sum;
-                }
-            }
-        }
-    }
+    mpgemm_tm.start();
+
+    MPgemmBlocked(
+        transa, transb, 'A', m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
 
     mpgemm_tm.stop();
 }
@@ -505,101 +539,12 @@ void MPgemm(const char transa, const char transb, const int m, const int n,
     const T2* const b, const int ldb, const double beta, T3* const c,
     const int ldc)
 {
+    if (beta == 1. && (alpha == 0. || m == 0 || n == 0 || k == 0)) return;
 
     tttgemm_tm.start();
-    // if(onpe0)cout<<"template MPgemm..."<<endl;
 
-    if (beta == 1. && (alpha == 0. || m == 0 || n == 0 || k == 0)) return;
-
-    /* case transb == 'N' and transa == 'N' */
-    if (transb == 'N' || transb == 'n')
-    {
-        if (transa == 'N' || transa == 'n')
-        {
-            /* buffer to hold accumulation in double */
-            double* buff = new double[m];
-            for (int j = 0; j < n; j++)
-            {
-                memset(buff, 0, m * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const T1* colL = a + lda * l;
-                    /* get multiplier */
-                    double mult = (double)(alpha * b[ldb * j + l]);
-                    MPaxpy(m, mult, colL, buff);
-                }
-                /* Update col j of of result matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                T3* cj = c + ldc * j;
-                MPscal(m, beta, cj);
-                for (int i = 0; i < m; i++)
-                {
-                    cj[i] += (T3)buff[i];
-                }
-            }
-        }
-        else /* transa == 'T'/'C' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const T2* __restrict__ bj = b + ldb * j;
-                for (int i = 0; i < m; i++)
-                {
-                    const int pos             = ldc * j + i;
-                    double bc                 = (double)c[pos] * beta;
-                    const T1* __restrict__ ai = a + lda * i;
-                    c[pos] = (T3)(alpha * MPdot(k, ai, bj) + bc);
-                }
-            }
-        }
-    }
-    else /* transb == 'T'/'C' */
-    {
-        if (transa == 'N' || transa == 'n')
-        {
-            /* buffer to hold accumulation in double */
-            double* buff = new double[m];
-            for (int j = 0; j < n; j++)
-            {
-                memset(buff, 0, m * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const T1* colL = a + lda * l;
-                    /* get multiplier */
-                    double mult = (double)(alpha * b[ldb * l + j]);
-                    MPaxpy(m, mult, colL, buff);
-                }
-                /* Update col j of of result matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                T3* cj = c + ldc * j;
-                MPscal(m, beta, cj);
-                for (int i = 0; i < m; i++)
-                {
-                    cj[i] += (T3)buff[i];
-                }
-            }
-        }
-        else /* transa == 'T'/'C' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                for (int i = 0; i < m; i++)
-                {
-                    const int pos = ldc * j + i;
-                    const T1* ai  = a + lda * i;
-                    double sum    = 0.;
-                    for (int l = 0; l < k; l++)
-                    {
-                        sum += alpha * ai[l] * b[ldb * l + j];
-                    }
-                    sum += (double)(beta * c[pos]);
-                    c[pos] = (T3)sum;
-                }
-            }
-        }
-    }
+    MPgemmBlocked(
+        transa, transb, 'A', m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
 
     tttgemm_tm.stop();
 }
@@ -609,95 +554,14 @@ void MPsyrk(const char uplo, const char trans, const int n, const int k,
     const double alpha, const T1* const a, const int lda, const double beta,
     T2* c, const int ldc)
 {
-    tttsyrk_tm.start();
-
     if (beta == 1. && (alpha == 0. || n == 0 || k == 0)) return;
 
-    /* case Trans == 'N' */
-    if (trans == 'N' || trans == 'n')
-    {
-        /* buffer to hold accumulation in double */
-        double* buff = new double[n];
-        if (uplo == 'U' || uplo == 'u')
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const int len = j + 1;
-                memset(buff, 0, len * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const T1* colL = a + lda * l;
-                    /* get multiplier */
-                    double mult
-                        = (double)(alpha
-                                   * colL[j]); // same as alpha * a[lda*l + j];
-                    MPaxpy(len, mult, colL, buff);
-                }
-                /* Update col j of upper part of matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                T2* cj = c + ldc * j;
-                MPscal(len, beta, cj);
-                for (int i = 0; i < len; i++)
-                    cj[i] += (T2)buff[i];
-            }
-        }
-        else /* uplo = 'L' or 'l' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const int len = n - (j + 1);
-                memset(buff, 0, len * sizeof(double));
-                for (int l = 0; l < k; l++)
-                {
-                    /* pointer to beginning of column l in matrix a */
-                    const T1* colL = a + lda * l + j;
-                    /* get multiplier */
-                    double mult
-                        = (double)(alpha
-                                   * colL[0]); // same as alpha * a[lda*l + j];
-                    MPaxpy(len, mult, colL, buff);
-                }
-                /* Update col j of upper part of matrix C. */
-                /* Get pointer to beginning of column j in C. */
-                T2* cj = c + ldc * j + j;
-                MPscal(len, beta, cj);
-                for (int i = 0; i < len; i++)
-                    cj[i] += (T2)buff[i];
-            }
-        }
-    }
-    else /* Trans == 'T' or 'C' */
-    {
-        if (uplo == 'U' || uplo == 'u')
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const T1* __restrict__ aj = a + lda * j;
-                for (int i = 0; i < j; i++)
-                {
-                    const int pos             = ldc * j + i;
-                    const T1* __restrict__ ai = a + lda * i;
-                    double bc                 = (double)c[pos] * beta;
-                    c[pos] = (T2)(alpha * MPdot(k, ai, aj) + bc);
-                }
-            }
-        }
-        else /* uplo = 'L' or 'l' */
-        {
-            for (int j = 0; j < n; j++)
-            {
-                const T1* __restrict__ aj = a + lda * j;
-                for (int i = j; i < n; i++)
-                {
-                    const int pos             = ldc * j + i;
-                    const T1* __restrict__ ai = a + lda * i;
-                    double bc                 = (double)c[pos] * beta;
-                    c[pos] = (T2)(alpha * MPdot(k, ai, aj) + bc);
-                }
-            }
-        }
-    }
+    tttsyrk_tm.start();
+
+    /* C = op(A)*op(A)^T with op(A) of dimension n x k */
+    const char transb = (trans == 'N' || trans == 'n') ? 'T' : 'N';
+    MPgemmBlocked(trans, transb, uplo, n, n, k, alpha, a, lda, a, lda, beta,
+        c, ldc);
 
     tttsyrk_tm.stop();
 }
@@ -9,6 +9,7 @@
 // Please also read this link https://github.com/llnl/mgmol/LICENSE
 
 #include "SquareLocalMatrices.h"
+#include "DeterministicReduce.h"
 
 using namespace std;
 
@@ -83,18 +84,14 @@ double SquareLocalMatrices<T>::computePartialTrace(
 
     T* ssiloc = LocalMatrices<T>::getSubMatrix(iloc);
 
-    double trace = 0.;
-    const int n  = (int)ids.size();
-#ifdef _OPENMP
-#pragma omp parallel for reduction(+ : trace)
-#endif
+    const int n = (int)ids.size();
+#ifndef NDEBUG
     for (int i = 0; i < n; i++)
-    {
         assert(ids[i] < m);
-        trace += ssiloc[ids[i] * (m + 1)];
-    }
+#endif
 
-    return trace;
+    // sum of diagonal elements ssiloc[ids[i]*(m+1)]
+    return deterministicSum(n, ssiloc, m + 1, &ids[0]);
 }
 
 template <class T>
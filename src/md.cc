@@ -421,6 +421,11 @@ void MGmol<T>::md(T** orbitals, Ions& ions)
     bool extrapolated_flag = true;
     if (ct.dt <= 0.) extrapolated_flag = false;
 
+    // with XL-BOMD, only a few SCF iterations are done once
+    // auxiliary orbitals are propagated
+    const bool xlbomd = (ct.WFExtrapolation() == WFExtrapolationType::XLBOMD);
+    bool full_scf     = true;
+
     MDfiles md_files;
 
     // main MD iteration loop
@@ -439,7 +444,11 @@ void MGmol<T>::md(T** orbitals, Ions& ions)
         bool small_move = true;
         do
         {
-            retval = quench(*orbitals, ions, ct.max_electronic_steps, 0, eks);
+            int max_steps = ct.max_electronic_steps;
+            if (xlbomd && !full_scf)
+                max_steps = min(max_steps, (int)ct.getXLBOMDscfSteps());
+
+            retval = quench(*orbitals, ions, max_steps, 0, eks);
 
             // update localization regions
             if (ct.adaptiveLRs())
@@ -448,7 +457,8 @@ void MGmol<T>::md(T** orbitals, Ions& ions)
 
                 // update cluster for load balancing
                 if (ct.load_balancing_alpha > 0.0
-                    && mdstep % ct.load_balancing_modulo == 0)
+                    && mdstep % ct.load_balancing_modulo == 0
+                    && local_cluster_->needsRebalancing())
                 {
                     local_cluster_->computeClusters(
                         ct.load_balancing_max_iterations);
@@ -464,6 +474,7 @@ void MGmol<T>::md(T** orbitals, Ions& ions)
                 printWithTimeStamp(
                     "WARNING: large move->extra inner cycle...", cout);
                 small_move = false;
+                full_scf   = true;
                 move_orbitals(orbitals);
 
                 (*orbitals)->computeGramAndInvS();
@@ -610,6 +621,9 @@ void MGmol<T>::md(T** orbitals, Ions& ions)
             if (ct.lrs_extrapolation > 0) extrapolate_centers(small_move);
 
             extrapolate_orbitals(orbitals);
+
+            // auxiliary orbitals are restarted after a large move
+            full_scf = !small_move;
         }
         else
             move_orbitals(orbitals);
@@ -157,10 +157,9 @@ int MGmol<T>::getMLWF2states(const int st1, const int st2,
     assert(&orbitals != &work_orbitals);
 
     // orthogonal transformation of orbitals
+    // (increments iterative index of orbitals)
     work_orbitals.multiplyByMatrix2states(st1, st2, &mlwft.mat()[0], orbitals);
 
-    orbitals.incrementIterativeIndex();
-
     get_MLWF_tm.stop();
 
     return 0;
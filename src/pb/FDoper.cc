@@ -19,6 +19,7 @@ namespace pb
 using namespace std;
 
 Timer FDoperInterface::del2_4th_Mehr_tm_("FDoper::del2_4th_Mehr");
+Timer FDoperInterface::del2_4th_Mehr_wpot_tm_("FDoper::del2_4th_Mehr_wpot");
 Timer FDoperInterface::rhs_4th_Mehr1_tm_("FDoper::rhs_4th_Mehr1");
 Timer FDoperInterface::rhs_tm_("FDoper::rhs_");
 Timer FDoperInterface::del2_2nd_tm_("FDoper::del2_2nd");
@@ -802,6 +803,145 @@ void FDoper<T>::del2_4th_Mehr(GridFunc<T>& A, GridFunc<T>& B) const
     del2_4th_Mehr_tm_.stop();
 }
 
+// B = -Lap_Mehr*A + Rhs*(pot*A)
+// (B without ghosts)
+// pot*A is computed on the fly, x-plane by x-plane, and stored
+// in a circular buffer of 3 planes (with one layer of ghosts in y and z)
+template <class T>
+void FDoper<T>::del2_4th_Mehr_withPot(GridFunc<T>& A,
+    const GridFunc<double>& pot, T* const B, T* const work,
+    const short rhs_type) const
+{
+    if (!grid_.active()) return;
+
+    assert(rhs_type == 1 || rhs_type == 2);
+    assert(ghosts() > 0);
+    assert(pot.grid().sizeg() == grid_.sizeg());
+
+    if (!A.updated_boundaries()) A.trade_boundaries();
+
+    del2_4th_Mehr_wpot_tm_.start();
+
+    const int shift = grid_.ghost_pt();
+    const int dim0  = grid_.dim(0);
+    const int dim1  = grid_.dim(1);
+    const int dim2  = grid_.dim(2);
+    const int dim12 = dim1 * dim2;
+
+    // rhs coefficients: center, faces, edges
+    const double r0 = (rhs_type == 1) ? 0.5 : 2. / 3.;
+    const double r1 = (rhs_type == 1) ? inv12 : 1. / 36.;
+    const double r2 = (rhs_type == 1) ? 0. : 1. / 72.;
+
+    // planes of pot*A including one ghost layer in directions y and z
+    const int nz    = dim2 + 2;
+    const int psize = (dim1 + 2) * nz;
+
+    const T* const v      = A.uu(0);
+    const double* const w = pot.uu(0);
+
+    // compute plane ix of pot*A (ix in [-1,dim0]) into work buffer
+    T* planes[3] = { work, work + psize, work + 2 * psize };
+    const int iiy0 = (shift - 1) * incy_ + shift - 1;
+    for (int ix = -1; ix < 1; ix++)
+    {
+        T* const plane = planes[(ix + 1) % 3];
+        const int iix  = (shift + ix) * incx_ + iiy0;
+        for (int jy = 0; jy < dim1 + 2; jy++)
+        {
+            const int ii = iix + jy * incy_;
+            T* const p   = plane + jy * nz;
+            for (int jz = 0; jz < nz; jz++)
+                p[jz] = (T)(v[ii + jz] * w[ii + jz]);
+        }
+    }
+
+    for (int ix = 0; ix < dim0; ix++)
+    {
+        // compute next plane
+        {
+            T* const plane = planes[(ix + 2) % 3];
+            const int iix  = (shift + ix + 1) * incx_ + iiy0;
+            for (int jy = 0; jy < dim1 + 2; jy++)
+            {
+                const int ii = iix + jy * incy_;
+                T* const p   = plane + jy * nz;
+                for (int jz = 0; jz < nz; jz++)
+                    p[jz] = (T)(v[ii + jz] * w[ii + jz]);
+            }
+        }
+        const T* const pm = planes[ix % 3];
+        const T* const p0 = planes[(ix + 1) % 3];
+        const T* const pp = planes[(ix + 2) % 3];
+
+        const int iix = (shift + ix) * incx_;
+        for (int iy = 0; iy < dim1; iy++)
+        {
+            const int iiz = iix + (shift + iy) * incy_ + shift;
+
+            T* const u0          = B + ix * dim12 + iy * dim2;
+            const T* const v0    = v + iiz;
+            const T* const vmx   = v0 - incx_;
+            const T* const vpx   = v0 + incx_;
+            const T* const vmxmy = vmx - incy_;
+            const T* const vpxmy = vpx - incy_;
+            const T* const vmy   = v0 - incy_;
+            const T* const vpy   = v0 + incy_;
+            const T* const vmxpy = vmx + incy_;
+            const T* const vpxpy = vpx + incy_;
+
+            // pot*A around (ix,iy,0)
+            const int jj          = (iy + 1) * nz + 1;
+            const T* const q0     = p0 + jj;
+            const T* const qmx    = pm + jj;
+            const T* const qpx    = pp + jj;
+            const T* const qmy    = q0 - nz;
+            const T* const qpy    = q0 + nz;
+            const T* const qmxmy  = qmx - nz;
+            const T* const qpxmy  = qpx - nz;
+            const T* const qmxpy  = qmx + nz;
+            const T* const qpxpy  = qpx + nz;
+
+            for (int iz = 0; iz < dim2; iz++)
+            {
+                const double lap
+                    = c0mehr4_ * (double)v0[iz]
+
+                      + czmehr4_ * (double)(v0[iz - 1] + v0[iz + 1])
+                      + cymehr4_ * (double)(vmy[iz] + vpy[iz])
+                      + cxmehr4_ * (double)(vmx[iz] + vpx[iz])
+
+                      + cxzmehr4_
+                            * (double)(vmx[iz - 1] + vmx[iz + 1]
+                                       + vpx[iz - 1] + vpx[iz + 1])
+                      + cyzmehr4_
+                            * (double)(vmy[iz - 1] + vmy[iz + 1]
+                                       + vpy[iz - 1] + vpy[iz + 1])
+                      + cxymehr4_
+                            * (double)(vmxmy[iz] + vpxmy[iz] + vmxpy[iz]
+                                       + vpxpy[iz]);
+
+                double rhs = r0 * (double)q0[iz]
+                             + r1
+                                   * (double)(qmx[iz] + qpx[iz] + qmy[iz]
+                                              + qpy[iz] + q0[iz - 1]
+                                              + q0[iz + 1]);
+                if (rhs_type == 2)
+                    rhs += r2
+                           * (double)(qmxmy[iz] + qpxmy[iz] + qmxpy[iz]
+                                      + qpxpy[iz] + qmy[iz - 1] + qmy[iz + 1]
+                                      + qpy[iz - 1] + qpy[iz + 1]
+                                      + qmx[iz - 1] + qmx[iz + 1]
+                                      + qpx[iz - 1] + qpx[iz + 1]);
+
+                u0[iz] = (T)(lap + rhs);
+            }
+        }
+    }
+
+    del2_4th_Mehr_wpot_tm_.stop();
+}
+
 template <class T>
 void FDoper<T>::smooth(GridFunc<T>& A, GridFunc<T>& B, const double alpha)
 {
@@ -57,6 +57,12 @@ protected:
     void rhs_4th_Mehr1(GridFunc<T>&, T* const) const;
     void rhs_4th_Mehr2(GridFunc<T>&, GridFunc<T>&) const;
     void rhs_4th_Mehr2(GridFunc<T>&, T* const) const;
+
+    // Mehrstellen operator applied to A, plus rhs operator (type 1 or 2)
+    // applied to pot*A, in a single pass (pot*A computed by x-planes
+    // in work array of size sizeMehrWithPotWork())
+    void del2_4th_Mehr_withPot(GridFunc<T>& A, const GridFunc<double>& pot,
+        T* const B, T* const work, const short rhs_type) const;
     double Mgm(GridFunc<T>&, const GridFunc<T>&, const int, const int) const;
 
 public:
@@ -71,6 +77,12 @@ public:
     double inv_h2(const short i) const { return inv_h2_[i]; }
     const Grid& grid() { return grid_; }
 
+    // size of work array needed by del2_4th_Mehr_withPot()
+    int sizeMehrWithPotWork() const
+    {
+        return 3 * (dim_[1] + 2) * (dim_[2] + 2);
+    }
+
     void smooth(GridFunc<T>&, GridFunc<T>&, const double);
 
     virtual void transform(GridFunc<T>&) const {};
@@ -24,6 +24,7 @@ class FDoperInterface
 {
 protected:
     static Timer del2_4th_Mehr_tm_;
+    static Timer del2_4th_Mehr_wpot_tm_;
     static Timer rhs_4th_Mehr1_tm_;
     static Timer rhs_tm_;
     static Timer del2_2nd_tm_;
@@ -36,6 +37,7 @@ public:
     static void printTimers(std::ostream& os)
     {
         del2_4th_Mehr_tm_.print(os);
+        del2_4th_Mehr_wpot_tm_.print(os);
         rhs_tm_.print(os);
         rhs_4th_Mehr1_tm_.print(os);
         del2_2nd_tm_.print(os);
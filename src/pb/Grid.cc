@@ -18,7 +18,7 @@ namespace pb
 // constructor
 Grid::Grid(const double origin[3], const double lattice[3],
     const unsigned ngpts[3], const PEenv& mype_env, const short nghosts,
-    const short level)
+    const short level, const std::vector<unsigned>* partition)
     : mype_env_(mype_env)
 {
     assert(lattice[0] > 1.e-8);
@@ -51,12 +51,30 @@ Grid::Grid(const double origin[3], const double lattice[3],
         assert(mype_env.n_mpi_task(1) > 0);
         assert(mype_env.n_mpi_task(2) > 0);
 
-        dim_[0] = ngpts[0] / mype_env.n_mpi_task(0);
-        dim_[1] = ngpts[1] / mype_env.n_mpi_task(1);
-        dim_[2] = ngpts[2] / mype_env.n_mpi_task(2);
-        assert(dim_[0] * mype_env.n_mpi_task(0) == ngpts[0]);
-        assert(dim_[1] * mype_env.n_mpi_task(1) == ngpts[1]);
-        assert(dim_[2] * mype_env.n_mpi_task(2) == ngpts[2]);
+        for (short i = 0; i < 3; i++)
+        {
+            if (partition != 0)
+            {
+                assert((int)partition[i].size() == mype_env.n_mpi_task(i));
+                partition_[i] = partition[i];
+            }
+            else
+            {
+                assert(ngpts[i] % mype_env.n_mpi_task(i) == 0);
+                partition_[i].assign(mype_env.n_mpi_task(i),
+                    ngpts[i] / mype_env.n_mpi_task(i));
+            }
+            dim_[i] = partition_[i][mype_env.my_mpi(i)];
+        }
+#ifndef NDEBUG
+        for (short i = 0; i < 3; i++)
+        {
+            unsigned sum = 0;
+            for (unsigned j = 0; j < partition_[i].size(); j++)
+                sum += partition_[i][j];
+            assert(sum == ngpts[i]);
+        }
+#endif
 
         gdim_[0] = ngpts[0];
         gdim_[1] = ngpts[1];
@@ -88,8 +106,8 @@ Grid::Grid(const double origin[3], const double lattice[3],
 
         for (short i = 0; i < 3; i++)
         {
-            start_[i]  = mype_env.my_mpi(i) * dim_[i] * hgrid_[i] + origin_[i];
-            istart_[i] = mype_env.my_mpi(i) * dim_[i];
+            istart_[i] = istart(i, mype_env.my_mpi(i));
+            start_[i]  = istart_[i] * hgrid_[i] + origin_[i];
         }
     }
     else
@@ -173,6 +191,9 @@ Grid::Grid(const Grid& my_grid, const short nghosts)
     vel_   = my_grid.vel_;
     level_ = my_grid.level_;
 
+    for (short i = 0; i < 3; i++)
+        partition_[i] = my_grid.partition_[i];
+
     if (active_)
         for (short i = 0; i < 3; i++)
         {
@@ -223,6 +244,9 @@ Grid& Grid::operator=(const Grid& my_grid)
         vel_      = my_grid.vel_;
         level_    = my_grid.level_;
 
+        for (short i = 0; i < 3; i++)
+            partition_[i] = my_grid.partition_[i];
+
         active_ = my_grid.active_;
     }
     if (active_)
@@ -243,7 +267,20 @@ const Grid Grid::coarse_grid() const
     assert((gdim(2) % 2) == 0);
 
     unsigned dim[3] = { gdim_[0] >> 1, gdim_[1] >> 1, gdim_[2] >> 1 };
-    Grid coarse_G(origin_, ll_, dim, mype_env_, ghost_pt_, level_ - 1);
+
+    // each local grid is coarsened
+    std::vector<unsigned> partition[3];
+    for (short i = 0; i < 3; i++)
+    {
+        partition[i] = partition_[i];
+        for (unsigned j = 0; j < partition[i].size(); j++)
+        {
+            assert((partition[i][j] % 2) == 0);
+            partition[i][j] = partition[i][j] >> 1;
+        }
+    }
+    Grid coarse_G(
+        origin_, ll_, dim, mype_env_, ghost_pt_, level_ - 1, partition);
     // cout<<"gsize="<<gsize()<<endl;
     // cout<<"coarse_G.gsize="<<coarse_G.gsize()<<endl;
     // cout<<"size="<<size()<<endl;
@@ -264,6 +301,114 @@ const Grid Grid::replicated_grid(const PEenv& replicated_peenv) const
     return replicated_grid;
 }
 
+bool Grid::uniformPartition() const
+{
+    for (short i = 0; i < 3; i++)
+        for (unsigned j = 1; j < partition_[i].size(); j++)
+            if (partition_[i][j] != partition_[i][0]) return false;
+    return true;
+}
+
+bool Grid::canCoarsen(const short nghosts) const
+{
+    if (!active_) return false;
+    for (short i = 0; i < 3; i++)
+        for (unsigned j = 0; j < partition_[i].size(); j++)
+        {
+            const unsigned n = partition_[i][j];
+            if ((n & 1) || (n < (unsigned)(2 * nghosts))) return false;
+        }
+    return true;
+}
+
+int Grid::checkCoarsening(const std::vector<unsigned>& partition,
+    const short nlevels, const short nghosts)
+{
+    const unsigned factor = 1u << (nlevels > 0 ? nlevels : 0);
+    for (unsigned j = 0; j < partition.size(); j++)
+    {
+        const unsigned n = partition[j];
+        if ((n % factor) || (n / factor < (unsigned)(2 * nghosts)))
+            return (int)j;
+    }
+    return -1;
+}
+
+unsigned Grid::maxSizeg() const
+{
+    unsigned size = 1;
+    for (short i = 0; i < 3; i++)
+    {
+        unsigned maxdim = 0;
+        for (unsigned j = 0; j < partition_[i].size(); j++)
+            maxdim = std::max(maxdim, partition_[i][j]);
+        size *= (maxdim + 2 * ghost_pt_);
+    }
+    return size;
+}
+
+// Recursive bisection: split the set of tasks in two halves,
+// and the interval of grid points at the position where the sum of weights
+// on each side is proportional to the number of tasks on that side
+static void bisect(const std::vector<double>& cumul, const int first,
+    const int last, const int nparts, const unsigned granularity,
+    std::vector<unsigned>& cuts, const int firstpart)
+{
+    if (nparts == 1) return;
+
+    const int nleft  = nparts / 2;
+    const int nright = nparts - nleft;
+
+    const double wfirst = cumul[first];
+    const double wtotal = cumul[last] - wfirst;
+    const double target = wfirst + wtotal * (double)nleft / (double)nparts;
+
+    // candidate cuts leave at least one block of granularity per task
+    const int cmin = first + nleft * granularity;
+    const int cmax = last - nright * granularity;
+    assert(cmin <= cmax);
+
+    int cut       = cmin;
+    double misfit = std::abs(cumul[cmin] - target);
+    for (int c = cmin + granularity; c <= cmax; c += granularity)
+    {
+        const double diff = std::abs(cumul[c] - target);
+        if (diff < misfit)
+        {
+            misfit = diff;
+            cut    = c;
+        }
+    }
+    cuts[firstpart + nleft] = cut;
+
+    bisect(cumul, first, cut, nleft, granularity, cuts, firstpart);
+    bisect(cumul, cut, last, nright, granularity, cuts, firstpart + nleft);
+}
+
+void Grid::bisectWeights(const std::vector<double>& weights, const int nparts,
+    const unsigned granularity, std::vector<unsigned>& sizes)
+{
+    const int n = (int)weights.size();
+    assert(nparts > 0);
+    assert(granularity > 0);
+    assert(n % granularity == 0);
+    assert(n >= nparts * (int)granularity);
+
+    // cumulative weights: cumul[i] = sum_{j<i} weights[j]
+    std::vector<double> cumul(n + 1, 0.);
+    for (int i = 0; i < n; i++)
+        cumul[i + 1] = cumul[i] + weights[i];
+
+    std::vector<unsigned> cuts(nparts + 1);
+    cuts[0]      = 0;
+    cuts[nparts] = n;
+    bisect(cumul, 0, n, nparts, granularity, cuts, 0);
+
+    sizes.resize(nparts);
+    for (int i = 0; i < nparts; i++)
+        sizes[i] = cuts[i + 1] - cuts[i];
+}
+
 template <typename T>
 void Grid::getSinCosFunctions(std::vector<T>& sinx, std::vector<T>& siny,
     std::vector<T>& sinz, std::vector<T>& cosx, std::vector<T>& cosy,
@@ -42,12 +42,18 @@ private:
     double origin_[3];
     short level_;
 
+    // number of grid points in each direction for each MPI task index
+    // in that direction (rectilinear, possibly non-uniform decomposition)
+    std::vector<unsigned> partition_[3];
+
     bool active_;
 
 public:
+    // partition: optional array of 3 vectors of local sizes for each
+    // task index in each direction. Uniform decomposition by default.
     Grid(const double origin[3], const double lattice[3],
         const unsigned ngpts[3], const PEenv& mype_env, const short nghosts = 1,
-        const short level = 0);
+        const short level = 0, const std::vector<unsigned>* partition = 0);
 
     // copy constructor
     Grid(const Grid&, const short nghosts = -1);
@@ -63,6 +69,40 @@ public:
         return dim_[i];
     }
     unsigned gdim(const short i) const { return gdim_[i]; }
+
+    // local dim and global index of first point of tasks
+    // with index itask in direction i
+    unsigned dim(const short i, const int itask) const
+    {
+        assert(itask < (int)partition_[i].size());
+        return partition_[i][itask];
+    }
+    int istart(const short i, const int itask) const
+    {
+        int offset = 0;
+        for (int j = 0; j < itask; j++)
+            offset += partition_[i][j];
+        return offset;
+    }
+    const std::vector<unsigned>& partition(const short i) const
+    {
+        return partition_[i];
+    }
+    bool uniformPartition() const;
+    // true if local grids of all tasks can be coarsened
+    bool canCoarsen(const short nghosts) const;
+    // index of first local size in partition that cannot be coarsened
+    // nlevels times, keeping at least 2*nghosts points, -1 if none
+    static int checkCoarsening(const std::vector<unsigned>& partition,
+        const short nlevels, const short nghosts);
+    // size with ghosts of largest local grid among all tasks
+    unsigned maxSizeg() const;
+
+    // split n grid points into nparts intervals with sizes multiple of
+    // granularity, balancing the sum of weights[i] in each interval
+    static void bisectWeights(const std::vector<double>& weights,
+        const int nparts, const unsigned granularity,
+        std::vector<unsigned>& sizes);
     int inc(const short i) const { return inc_[i]; }
     double ll(const short i) const { return ll_[i]; }
     double maxDomainSize()const
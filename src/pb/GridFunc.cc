@@ -13,6 +13,7 @@
 #include "MGmol_blas1.h"
 #include "mputils.h"
 #include "radial_functions.h"
+#include <algorithm>
 #include <cstdarg>
 #include <cstdlib>
 #include <fstream>
@@ -456,15 +457,15 @@ GridFunc<T>::GridFunc(const T* const src, const Grid& new_grid, const short px,
     int kstart = 0;
     if (dis == 'g')
     {
-        istart = mype_env().my_mpi(0) * dim(0);
-        jstart = mype_env().my_mpi(1) * dim(1);
-        kstart = mype_env().my_mpi(2) * dim(2);
+        istart = grid_.istart(0);
+        jstart = grid_.istart(1);
+        kstart = grid_.istart(2);
     }
     else if (dis == 's')
     { // "shifted" option
-        istart = mype_env().my_mpi(0) * dim(0) + (grid_.gdim(0) >> 1);
-        jstart = mype_env().my_mpi(1) * dim(1) + (grid_.gdim(1) >> 1);
-        kstart = mype_env().my_mpi(2) * dim(2) + (grid_.gdim(2) >> 1);
+        istart = grid_.istart(0) + (grid_.gdim(0) >> 1);
+        jstart = grid_.istart(1) + (grid_.gdim(1) >> 1);
+        kstart = grid_.istart(2) + (grid_.gdim(2) >> 1);
     }
 
     uu_ = new T[grid_.sizeg()];
@@ -836,9 +837,9 @@ void GridFunc<T>::assign(const T2* const vv, const char dis)
         if (dis == 'g')
         {
             const int ldz    = grid_.gdim(2);
-            const int istart = mype_env().my_mpi(0) * dim_[0];
-            const int jstart = mype_env().my_mpi(1) * dim_[1];
-            const int kstart = mype_env().my_mpi(2) * dim_[2];
+            const int istart = grid_.istart(0);
+            const int jstart = grid_.istart(1);
+            const int kstart = grid_.istart(2);
             const int gincx  = grid_.gdim(1) * ldz;
             const int gincy  = ldz;
 
@@ -1043,9 +1044,8 @@ void GridFunc<T>::print(ostream& tfile)
 
     assert(grid_.inc(2) == 1);
 
-    tfile << mype_env().n_mpi_task(0) * dim_[0] << "\t"
-          << mype_env().n_mpi_task(1) * dim_[1] << "\t"
-          << mype_env().n_mpi_task(2) * dim_[2] << endl;
+    tfile << grid_.gdim(0) << "\t" << grid_.gdim(1) << "\t" << grid_.gdim(2)
+          << endl;
     tfile << grid_.hgrid(0) << "\t" << grid_.hgrid(1) << "\t" << grid_.hgrid(2)
           << endl;
 
@@ -1186,11 +1186,11 @@ void GridFunc<T>::global_xyz_task0(T* global_func)
 
     const short shift = ghost_pt();
 
-    T* work = new T[grid_.sizeg()];
+    // local grids of other tasks may be larger
+    T* work = new T[grid_.maxSizeg()];
 
-    const int gincx
-        = mype_env().n_mpi_task(1) * dim(1) * mype_env().n_mpi_task(2) * dim(2);
-    const int gincy = mype_env().n_mpi_task(2) * dim(2);
+    const int gincx = grid_.gdim(1) * grid_.gdim(2);
+    const int gincy = grid_.gdim(2);
 
     for (int ii = 0; ii < dim(0); ii++)
         for (int jj = 0; jj < dim(1); jj++)
@@ -1206,25 +1206,32 @@ void GridFunc<T>::global_xyz_task0(T* global_func)
         for (int j = 0; j < mype_env().n_mpi_task(1); j++)
             for (int k = 0; k < mype_env().n_mpi_task(2); k++)
             {
-                int istart = i * dim(0);
-                int jstart = j * dim(1);
-                int kstart = k * dim(2);
+                int istart = grid_.istart(0, i);
+                int jstart = grid_.istart(1, j);
+                int kstart = grid_.istart(2, k);
                 int ipe    = mype_env().xyz2task(i, j, k);
 
+                // dimensions of local grid of task ipe
+                const int ldim[3] = { (int)grid_.dim(0, i),
+                    (int)grid_.dim(1, j), (int)grid_.dim(2, k) };
+                const int lincy  = ldim[2] + 2 * shift;
+                const int lincx  = (ldim[1] + 2 * shift) * lincy;
+                const int lsizeg = (ldim[0] + 2 * shift) * lincx;
+
                 if (ipe > 0)
                 {
                     if (mype_env().onpe0())
                     {
-                        mpirc = mmpi.recv(work, grid_.sizeg(), ipe);
+                        mpirc = mmpi.recv(work, lsizeg, ipe);
                         if (mpirc != MPI_SUCCESS)
                             cout << "print: MPI_Recv work failed!!!" << endl;
-                        for (int ii = 0; ii < dim(0); ii++)
-                            for (int jj = 0; jj < dim(1); jj++)
+                        for (int ii = 0; ii < ldim[0]; ii++)
+                            for (int jj = 0; jj < ldim[1]; jj++)
                                 memcpy(global_func + (istart + ii) * gincx
                                            + (jstart + jj) * gincy + kstart,
-                                    work + (ii + shift) * incx_
-                                        + (jj + shift) * incy_ + shift,
-                                    dim(2) * sizeof(T));
+                                    work + (ii + shift) * lincx
+                                        + (jj + shift) * lincy + shift,
+                                    ldim[2] * sizeof(T));
                     }
                     else if (mytask_ == ipe)
                     {
@@ -1250,11 +1257,11 @@ void GridFunc<T>::write_global_xyz(ofstream& tfile)
 
     const long gsize = grid_.gsize();
     T* global_func   = new T[gsize];
-    T* work          = new T[grid_.sizeg()];
+    // local grids of other tasks may be larger
+    T* work = new T[grid_.maxSizeg()];
 
-    const int gincx
-        = mype_env().n_mpi_task(1) * dim(1) * mype_env().n_mpi_task(2) * dim(2);
-    const int gincy = mype_env().n_mpi_task(2) * dim(2);
+    const int gincx = grid_.gdim(1) * grid_.gdim(2);
+    const int gincy = grid_.gdim(2);
 
     size_t sizez    = dim(2) * sizeof(T);
     const int ldim0 = dim(0);
@@ -1271,33 +1278,40 @@ void GridFunc<T>::write_global_xyz(ofstream& tfile)
         cout << "GridFunc<T>::write_global_xyz, Collect data on PE 0" << endl;
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
     int mpirc;
-    const int ldim2 = dim(2);
 
     for (int i = 0; i < mype_env().n_mpi_task(0); i++)
         for (int j = 0; j < mype_env().n_mpi_task(1); j++)
             for (int k = 0; k < mype_env().n_mpi_task(2); k++)
             {
-                const int istart = i * ldim0;
-                const int jstart = j * ldim1;
-                const int kstart = k * ldim2;
+                const int istart = grid_.istart(0, i);
+                const int jstart = grid_.istart(1, j);
+                const int kstart = grid_.istart(2, k);
                 const int ipe    = mype_env().xyz2task(i, j, k);
 
+                // dimensions of local grid of task ipe
+                const int rdim0  = grid_.dim(0, i);
+                const int rdim1  = grid_.dim(1, j);
+                const int rdim2  = grid_.dim(2, k);
+                const int lincy  = rdim2 + 2 * shift;
+                const int lincx  = (rdim1 + 2 * shift) * lincy;
+                const int lsizeg = (rdim0 + 2 * shift) * lincx;
+
                 if (ipe > 0)
                 {
                     if (mytask_ == 0)
                     {
-                        mpirc = mmpi.recv(work, grid_.sizeg(), ipe);
+                        mpirc = mmpi.recv(work, lsizeg, ipe);
                         if (mpirc != MPI_SUCCESS)
                             cout << "GridFunc<T>::write_global_xyz, MPI_Recv "
                                     "work failed!!!"
                                  << endl;
-                        for (int ii = 0; ii < ldim0; ii++)
-                            for (int jj = 0; jj < ldim1; jj++)
+                        for (int ii = 0; ii < rdim0; ii++)
+                            for (int jj = 0; jj < rdim1; jj++)
                                 memcpy(global_func + (istart + ii) * gincx
                                            + (jstart + jj) * gincy + kstart,
-                                    work + (ii + shift) * incx_
-                                        + (jj + shift) * incy_ + shift,
-                                    sizez);
+                                    work + (ii + shift) * lincx
+                                        + (jj + shift) * lincy + shift,
+                                    rdim2 * sizeof(T));
                     }
                     else if (mytask_ == ipe)
                     {
@@ -1408,12 +1422,16 @@ void GridFunc<T>::allGather(T* global_func) const
     if(mpi_err!=MPI_SUCCESS)
         cout<<"GridFunc<T>::gather --- MPI_Allgather() call failed"<<endl;
 #else
+    // local dimensions of each task
+    vector<int> odims(3 * ntasks);
     for (int i = 0; i < ntasks; i++)
     {
         int other_start[3];
         for (short dir = 0; dir < 3; dir++)
         {
-            other_start[dir] = mype_env().other_tasks_dir(dir, i) * ldim[dir];
+            const int itask    = mype_env().other_tasks_dir(dir, i);
+            other_start[dir]   = grid_.istart(dir, itask);
+            odims[3 * i + dir] = grid_.dim(dir, itask);
         }
         displs[i]
             = other_start[0] * gincx + other_start[1] * gincy + other_start[2];
@@ -1421,9 +1439,9 @@ void GridFunc<T>::allGather(T* global_func) const
     }
 #endif
 
-    const int sizeg    = grid_.sizeg();
-    const int gsize    = sizeg * ntasks;
-    const size_t sdim2 = ldim[2] * sizeof(T);
+    // all local grids are communicated in blocks of the size of the largest
+    const int sizeg = grid_.maxSizeg();
+    const int gsize = sizeg * ntasks;
 #if 0 // old version
     T* buffer=new T[sizeg];
     T* tbuffer;
@@ -1445,20 +1463,33 @@ void GridFunc<T>::allGather(T* global_func) const
         }
     }
 #else
-    T* buffer = new T[gsize];
-    mpi_err   = mmpi.allGather(uu_, sizeg, buffer, gsize);
+    T* buffer  = new T[gsize];
+    T* sendbuf = uu_;
+    if ((int)grid_.sizeg() < sizeg)
+    {
+        sendbuf = new T[sizeg];
+        memcpy(sendbuf, uu_, grid_.sizeg() * sizeof(T));
+    }
+    mpi_err = mmpi.allGather(sendbuf, sizeg, buffer, gsize);
+    if (sendbuf != uu_) delete[] sendbuf;
 
     for (int i = 0; i < ntasks; i++)
-        for (int ii = 0; ii < ldim[0]; ii++)
+    {
+        const int* const odim = &odims[3 * i];
+        const int oincy       = odim[2] + 2 * shift;
+        const int oincx       = (odim[1] + 2 * shift) * oincy;
+        const size_t sdim2    = odim[2] * sizeof(T);
+        for (int ii = 0; ii < odim[0]; ii++)
         {
             T* const dest      = global_func + displs[i] + ii * gincx;
-            const T* const src = buffer + i * sizeg + (ii + shift) * incx_
-                                 + shift * (1 + incy_);
-            for (int jj = 0; jj < ldim[1]; jj++)
+            const T* const src = buffer + i * sizeg + (ii + shift) * oincx
+                                 + shift * (1 + oincy);
+            for (int jj = 0; jj < odim[1]; jj++)
             {
-                memcpy(dest + jj * gincy, src + jj * incy_, sdim2);
+                memcpy(dest + jj * gincy, src + jj * oincy, sdim2);
             }
         }
+    }
 #endif
     delete[] buffer;
     delete[] displs;
@@ -1501,17 +1532,20 @@ void GridFunc<T>::gather(T* global_func) const
     MGmol_MPI& mmpi  = *(MGmol_MPI::instance());
     int* displs      = NULL;
     const int ntasks = mype_env().n_mpi_tasks();
+    vector<int> odims;
     if (mype_env().onpe0())
     {
         displs = new int[ntasks];
+        odims.resize(3 * ntasks);
 
         for (int i = 0; i < ntasks; i++)
         {
             int other_start[3];
             for (short dir = 0; dir < 3; dir++)
             {
-                other_start[dir]
-                    = mype_env().other_tasks_dir(dir, i) * ldim[dir];
+                const int itask    = mype_env().other_tasks_dir(dir, i);
+                other_start[dir]   = grid_.istart(dir, itask);
+                odims[3 * i + dir] = grid_.dim(dir, itask);
             }
             displs[i] = other_start[0] * gincx + other_start[1] * gincy
                         + other_start[2];
@@ -1519,29 +1553,41 @@ void GridFunc<T>::gather(T* global_func) const
         }
     }
 
-    const int sizeg = grid_.sizeg();
+    // all local grids are communicated in blocks of the size of the largest
+    const int sizeg = grid_.maxSizeg();
     const int gsize = sizeg * ntasks;
 
     T* buffer = NULL;
     if (mype_env().onpe0()) buffer = new T[gsize];
 
-    mmpi.gather(uu_, sizeg, buffer, gsize, 0);
+    T* sendbuf = uu_;
+    if ((int)grid_.sizeg() < sizeg)
+    {
+        sendbuf = new T[sizeg];
+        memcpy(sendbuf, uu_, grid_.sizeg() * sizeof(T));
+    }
+    mmpi.gather(sendbuf, sizeg, buffer, gsize, 0);
+    if (sendbuf != uu_) delete[] sendbuf;
 
     if (mype_env().onpe0())
     {
-        const size_t sdim2 = ldim[2] * sizeof(T);
         for (int i = 0; i < ntasks; i++)
         {
+            const int* const odim = &odims[3 * i];
+            const int oincy       = odim[2] + 2 * shift;
+            const int oincx       = (odim[1] + 2 * shift) * oincy;
+            const size_t sdim2    = odim[2] * sizeof(T);
+
             T* const pdst = global_func + displs[i];
             T* const psrc = buffer + i * sizeg;
-            for (int ii = 0; ii < ldim[0]; ii++)
+            for (int ii = 0; ii < odim[0]; ii++)
             {
                 T* const dst = pdst + ii * gincx;
                 const T* const src
-                    = psrc + (ii + shift) * incx_ + shift * (1 + incy_);
-                for (int jj = 0; jj < ldim[1]; jj++)
+                    = psrc + (ii + shift) * oincx + shift * (1 + oincy);
+                for (int jj = 0; jj < odim[1]; jj++)
                 {
-                    memcpy(dst + jj * gincy, src + jj * incy_, sdim2);
+                    memcpy(dst + jj * gincy, src + jj * oincy, sdim2);
                 }
             }
         }
@@ -1592,17 +1638,20 @@ void GridFunc<T>::scatterFrom(const GridFunc<T>& src)
     // Compute and communicate displacements (used in MPI_Scatter)
     int* displs      = NULL;
     const int ntasks = mype_env().n_mpi_tasks();
+    vector<int> odims;
     if (mype_env().onpe0())
     {
         displs = new int[ntasks];
+        odims.resize(3 * ntasks);
 
         for (int i = 0; i < ntasks; i++)
         {
             int other_start[3];
             for (short dir = 0; dir < 3; dir++)
             {
-                other_start[dir]
-                    = mype_env().other_tasks_dir(dir, i) * ldim[dir];
+                const int itask    = mype_env().other_tasks_dir(dir, i);
+                other_start[dir]   = grid_.istart(dir, itask);
+                odims[3 * i + dir] = grid_.dim(dir, itask);
             }
             displs[i] = other_start[0] * incx_src + other_start[1] * incy_src
                         + other_start[2];
@@ -1610,7 +1659,8 @@ void GridFunc<T>::scatterFrom(const GridFunc<T>& src)
         }
     }
 
-    const int sizeg = grid_.sizeg();
+    // all local grids are communicated in blocks of the size of the largest
+    const int sizeg = grid_.maxSizeg();
     const int gsize = sizeg * ntasks;
 
     T* buffer = NULL;
@@ -1618,26 +1668,40 @@ void GridFunc<T>::scatterFrom(const GridFunc<T>& src)
 
     if (mype_env().onpe0())
     { // fill buffer
-        const size_t sdim2 = ldim[2] * sizeof(T);
         for (int i = 0; i < ntasks; i++)
         {
+            const int* const odim = &odims[3 * i];
+            const int oincy       = odim[2] + 2 * ghosts_dst;
+            const int oincx       = (odim[1] + 2 * ghosts_dst) * oincy;
+            const size_t sdim2    = odim[2] * sizeof(T);
+
             T* const pdst       = buffer + i * sizeg;
             const T* const psrc = src.uu_ + displs[i];
-            for (int ii = 0; ii < ldim[0]; ii++)
+            for (int ii = 0; ii < odim[0]; ii++)
             {
-                T* const ldst = pdst + (ii + ghosts_dst) * incx_
-                                + ghosts_dst * (1 + incy_);
+                T* const ldst = pdst + (ii + ghosts_dst) * oincx
+                                + ghosts_dst * (1 + oincy);
                 const T* const lsrc = psrc + (ii + ghosts_src) * incx_src
                                       + ghosts_src * (1 + incy_src);
-                for (int jj = 0; jj < ldim[1]; jj++)
+                for (int jj = 0; jj < odim[1]; jj++)
                 {
-                    memcpy(ldst + jj * incy_, lsrc + jj * incy_src, sdim2);
+                    memcpy(ldst + jj * oincy, lsrc + jj * incy_src, sdim2);
                 }
             }
         }
     }
 
-    mmpi.scatter(buffer, gsize, uu_, sizeg, 0);
+    if ((int)grid_.sizeg() < sizeg)
+    {
+        T* recvbuf = new T[sizeg];
+        mmpi.scatter(buffer, gsize, recvbuf, sizeg, 0);
+        memcpy(uu_, recvbuf, grid_.sizeg() * sizeof(T));
+        delete[] recvbuf;
+    }
+    else
+    {
+        mmpi.scatter(buffer, gsize, uu_, sizeg, 0);
+    }
 
     if (mype_env().onpe0())
     {
@@ -1662,87 +1726,63 @@ void GridFunc<T>::init_vect_shift(T* global_func) const
 
     assert(grid_.inc(2) == 1);
 
-    const int gincx = grid_.gdim(1) * grid_.gdim(2);
-    const int gincy = grid_.gdim(2);
+    const int gdim0 = grid_.gdim(0);
+    const int gdim1 = grid_.gdim(1);
+    const int gdim2 = grid_.gdim(2);
+    const int gincx = gdim1 * gdim2;
+    const int gincy = gdim2;
 
-    // Compute and communicate displacements (used in MPI_Allgatherv)
-    const int il     = (grid_.gdim(0) >> 1);
-    const int jl     = (grid_.gdim(1) >> 1);
-    const int kl     = (grid_.gdim(2) >> 1);
-    const int dimil2 = (grid_.dim(0) >> 1);
-    const int dimjl2 = (grid_.dim(1) >> 1);
-    const int dimkl2 = (grid_.dim(2) >> 1);
-
-    MGmol_MPI& mmpi   = *(MGmol_MPI::instance());
-    const int bufsize = mype_env().n_mpi_tasks();
-
-    vector<vector<int>> displx;
-    displx.resize(2);
-    displx[0].resize(bufsize);
-    displx[1].resize(bufsize);
-
-    vector<vector<int>> disply;
-    disply.resize(2);
-    disply[0].resize(bufsize);
-    disply[1].resize(bufsize);
-
-    vector<vector<int>> displz;
-    displz.resize(2);
-    displz[0].resize(bufsize);
-    displz[1].resize(bufsize);
-
-    int istart = (mype_env().my_mpi(0) * dim(0) + il) % grid_.gdim(0);
-    int jstart = (mype_env().my_mpi(1) * dim(1) + jl) % grid_.gdim(1);
-    int kstart = (mype_env().my_mpi(2) * dim(2) + kl) % grid_.gdim(2);
-    mmpi.allGather(&istart, 1, &displx[0][0], bufsize);
-    mmpi.allGather(&jstart, 1, &disply[0][0], bufsize);
-    mmpi.allGather(&kstart, 1, &displz[0][0], bufsize);
-
-    istart = (mype_env().my_mpi(0) * dim(0) + dimil2 + il) % grid_.gdim(0);
-    jstart = (mype_env().my_mpi(1) * dim(1) + dimjl2 + jl) % grid_.gdim(1);
-    kstart = (mype_env().my_mpi(2) * dim(2) + dimkl2 + kl) % grid_.gdim(2);
-    mmpi.allGather(&istart, 1, &displx[1][0], bufsize);
-    mmpi.allGather(&jstart, 1, &disply[1][0], bufsize);
-    mmpi.allGather(&kstart, 1, &displz[1][0], bufsize);
-
-    int sizeg = grid_.sizeg();
-
-    T* buffer = new T[sizeg];
-    T* tbuffer;
-    for (int i = 0; i < mype_env().n_mpi_tasks(); i++)
-    {
-        if (mytask_ == i)
-        {
-            tbuffer = uu_;
-        }
-        else
-        {
-            tbuffer = buffer;
-        }
-        mmpi.bcast(tbuffer, sizeg, i);
-        for (int a = 0; a < 2; a++)
-            for (int b = 0; b < 2; b++)
+    // global function is shifted by half the domain in each direction
+    const int il = (gdim0 >> 1);
+    const int jl = (gdim1 >> 1);
+    const int kl = (gdim2 >> 1);
+
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+
+    // local grids may have different sizes on different tasks
+    T* buffer = new T[grid_.maxSizeg()];
+
+    for (int i = 0; i < mype_env().n_mpi_task(0); i++)
+        for (int j = 0; j < mype_env().n_mpi_task(1); j++)
+            for (int k = 0; k < mype_env().n_mpi_task(2); k++)
             {
-                int displ1 = displx[a][i] * gincx + disply[b][i] * gincy
-                             + displz[0][i];
-                int displ2 = displx[a][i] * gincx + disply[b][i] * gincy
-                             + displz[1][i];
-                for (int ii = a * dimil2; ii < (a + 1) * dimil2; ii++)
-                    for (int jj = b * dimjl2; jj < (b + 1) * dimjl2; jj++)
+                const int ipe = mype_env().xyz2task(i, j, k);
+
+                // dimensions of local grid of task ipe
+                const int rdim0  = grid_.dim(0, i);
+                const int rdim1  = grid_.dim(1, j);
+                const int rdim2  = grid_.dim(2, k);
+                const int lincy  = rdim2 + 2 * shift;
+                const int lincx  = (rdim1 + 2 * shift) * lincy;
+                const int lsizeg = (rdim0 + 2 * shift) * lincx;
+
+                T* tbuffer = (mytask_ == ipe) ? uu_ : buffer;
+                mmpi.bcast(tbuffer, lsizeg, ipe);
+
+                // position of first point of task ipe in shifted function
+                const int istart = (grid_.istart(0, i) + il) % gdim0;
+                const int jstart = (grid_.istart(1, j) + jl) % gdim1;
+                const int kstart = (grid_.istart(2, k) + kl) % gdim2;
+
+                // number of points in z direction before wrapping around
+                const int nk1 = std::min(rdim2, gdim2 - kstart);
+
+                for (int ii = 0; ii < rdim0; ii++)
+                {
+                    const int gi = (istart + ii) % gdim0;
+                    for (int jj = 0; jj < rdim1; jj++)
                     {
-                        memcpy(global_func + displ1 + (ii - a * dimil2) * gincx
-                                   + (jj - b * dimjl2) * gincy,
-                            tbuffer + (ii + shift) * incx_
-                                + (jj + shift) * incy_ + shift,
-                            dimkl2 * sizeof(T));
-                        memcpy(global_func + displ2 + (ii - a * dimil2) * gincx
-                                   + (jj - b * dimjl2) * gincy,
-                            tbuffer + (ii + shift) * incx_
-                                + (jj + shift) * incy_ + shift + dimkl2,
-                            dimkl2 * sizeof(T));
+                        const int gj = (jstart + jj) % gdim1;
+
+                        T* const dest = global_func + gi * gincx + gj * gincy;
+                        const T* const src = tbuffer + (ii + shift) * lincx
+                                             + (jj + shift) * lincy + shift;
+                        memcpy(dest + kstart, src, nk1 * sizeof(T));
+                        if (nk1 < rdim2)
+                            memcpy(dest, src + nk1, (rdim2 - nk1) * sizeof(T));
                     }
+                }
             }
-    }
     delete[] buffer;
 }
 
@@ -1844,9 +1884,9 @@ void GridFunc<T>::initTrigo3d(const short bc[3], const int n[3])
 
     const short nghosts = ghost_pt();
 
-    const int ilow = mype_env().my_mpi(0) * dim_[0];
-    const int jlow = mype_env().my_mpi(1) * dim_[1];
-    const int klow = mype_env().my_mpi(2) * dim_[2];
+    const int ilow = grid_.istart(0);
+    const int jlow = grid_.istart(1);
+    const int klow = grid_.istart(2);
 
     const bool last[3]
         = { (mype_env().my_mpi(0) == (mype_env().n_mpi_task(0) - 1)),
@@ -2077,9 +2117,9 @@ void GridFunc<T>::init_radial(
     const double h1 = grid_.hgrid(1);
     const double h2 = grid_.hgrid(2);
 
-    const int ilow = mype_env().my_mpi(0) * grid_.dim(0);
-    const int jlow = mype_env().my_mpi(1) * grid_.dim(1);
-    const int klow = mype_env().my_mpi(2) * grid_.dim(2);
+    const int ilow = grid_.istart(0);
+    const int jlow = grid_.istart(1);
+    const int klow = grid_.istart(2);
 
     const short nghosts = ghost_pt();
 
@@ -4114,7 +4154,7 @@ void GridFunc<T>::add_bias(const double bias)
         if (mype_env().onpe0()) cout << "Add bias " << bias << endl;
 
         const short shift = ghost_pt();
-        int istart        = grid_.dim(0) * mype_env().my_mpi(0);
+        int istart        = grid_.istart(0);
         for (int i = 0; i < grid_.dim(0); i++)
             for (int j = 0; j < grid_.dim(1); j++)
                 for (int k = 0; k < grid_.dim(2); k++)
@@ -4136,7 +4176,7 @@ double GridFunc<T>::get_bias()
         // cout<<"Compute bias "<<bias<<endl;
 
         const short shift = ghost_pt();
-        int istart        = grid_.dim(0) * mype_env().my_mpi(0);
+        int istart        = grid_.istart(0);
         int i0            = 1;
         if (istart > 0) i0 = 0;
 
@@ -4237,9 +4277,9 @@ void GridFunc<T>::assign(const GridFunc<T>& src, const char dis)
         int kstart = 0;
         if (dis == 'g')
         { // src is "global"
-            istart = mype_env().my_mpi(0) * dim(0);
-            jstart = mype_env().my_mpi(1) * dim(1);
-            kstart = mype_env().my_mpi(2) * dim(2);
+            istart = grid_.istart(0);
+            jstart = grid_.istart(1);
+            kstart = grid_.istart(2);
         }
 
         memset(uu_, 0, grid_.sizeg() * sizeof(T));
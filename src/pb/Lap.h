@@ -36,6 +36,14 @@ public:
         std::cerr << "ERROR: Lap::applyWithPot() not implemented" << std::endl;
         MPI_Abort(MPI_COMM_WORLD, 0);
     }
+    // Mehrstellen version: B = Lap*A + Rhs*(pot*A), with pot including
+    // ghost values and work of size FDoper::sizeMehrWithPotWork()
+    virtual void applyWithPot(
+        GridFunc<T>& A, const GridFunc<double>&, T*, T* const)
+    {
+        std::cerr << "ERROR: Lap::applyWithPot() not implemented" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 0);
+    }
     virtual void apply(GridFuncVector<T>& A, GridFuncVector<T>& B) = 0;
 
     std::string name() const { return name_; }
@@ -54,6 +62,9 @@ public:
     void jacobi(GridFuncVector<T>&, const GridFuncVector<T>&,
         GridFuncVector<T>&, const double);
 
+    // multiplicative factor for residual in (damped) Jacobi iteration
+    virtual double jacobiScale() const { return -invDiagEl(); }
+
     double energyES(GridFunc<T>&, GridFunc<T>&);
     virtual double diagEl(void) const    = 0;
     virtual double invDiagEl(void) const = 0;
@@ -40,6 +40,11 @@ void Laph2<T>::jacobi(
 
     Lap<T>::jacobi(A, B, W, scale);
 }
+template <class T>
+double Laph2<T>::jacobiScale() const
+{
+    return -omega * invDiagEl_;
+}
 template class Laph2<double>;
 template class Laph2<float>;
 } // namespace pb
@@ -37,6 +37,11 @@ void Laph4<T>::jacobi(
 
     Lap<T>::jacobi(A, B, W, scale);
 }
+template <class T>
+double Laph4<T>::jacobiScale() const
+{
+    return -omega * invDiagEl_;
+}
 template class Laph4<double>;
 template class Laph4<float>;
 } // namespace pb
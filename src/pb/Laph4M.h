@@ -75,6 +75,12 @@ public:
         }
     }
 
+    void applyWithPot(GridFunc<T>& A, const GridFunc<double>& pot, T* B,
+        T* const work)
+    {
+        this->del2_4th_Mehr_withPot(A, pot, B, work, 1);
+    }
+
     void rhs(GridFunc<T>& A, GridFunc<T>& B) const
     {
         this->rhs_4th_Mehr1(A, B);
@@ -42,6 +42,12 @@ public:
         return replicated_A;
     }
 
+    void applyWithPot(GridFunc<T>& A, const GridFunc<double>& pot, T* B,
+        T* const work)
+    {
+        FDoper<T>::del2_4th_Mehr_withPot(A, pot, B, work, 2);
+    }
+
     void rhs(GridFunc<T>& A, GridFunc<T>& B) const
     {
         FDoper<T>::rhs_4th_Mehr2(A, B);
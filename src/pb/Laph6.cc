@@ -37,6 +37,11 @@ void Laph6<T>::jacobi(
 
     Lap<T>::jacobi(A, B, W, scale);
 }
+template <class T>
+double Laph6<T>::jacobiScale() const
+{
+    return -omega * invDiagEl_;
+}
 template class Laph6<double>;
 template class Laph6<float>;
 } // namespace pb
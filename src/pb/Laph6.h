@@ -113,6 +113,7 @@ public:
 
     double diagEl(void) const { return diagEl_; };
     double invDiagEl(void) const { return invDiagEl_; };
+    double jacobiScale() const;
 };
 
 } // namespace pb
@@ -37,6 +37,11 @@ void Laph8<T>::jacobi(
 
     Lap<T>::jacobi(A, B, W, scale);
 }
+template <class T>
+double Laph8<T>::jacobiScale() const
+{
+    return -omega * invDiagEl_;
+}
 template class Laph8<double>;
 template class Laph8<float>;
 } // namespace pb
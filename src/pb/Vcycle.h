@@ -53,13 +53,8 @@ int Vcycle(T1& A, T2& x, const GridFunc<T3>& rhs, const short cogr,
     if (level_grid.mype_env().onpe0()) cout << "Vcycle: x=" << norm_tmp << endl;
 #endif
 
-    const bool flag_coarsen
-        = ((!(level_grid.dim(0)
-               & 1)) // cannot coarsen if mesh not divisible by 2
-            && (!(level_grid.dim(1) & 1)) && (!(level_grid.dim(2) & 1))
-            && (level_grid.dim(0) >= 2 * nghosts)
-            && (level_grid.dim(1) >= 2 * nghosts)
-            && (level_grid.dim(2) >= 2 * nghosts));
+    // cannot coarsen if mesh not divisible by 2 (on all tasks)
+    const bool flag_coarsen = level_grid.canCoarsen(nghosts);
 #if VCYCLE_DEBUG
     if (level_grid.mype_env().onpe0())
         cout << "Vcycle: flag_coarsen=" << flag_coarsen << endl;
@@ -0,0 +1,29 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_READ_CONFIG_H
+#define MGMOL_READ_CONFIG_H
+
+#include <boost/program_options.hpp>
+
+#include <string>
+#include <vector>
+
+// Read options from command line and configuration file (to be called
+// on PE0 only).
+// Returns 0 on success, 1 if the run should stop without error
+// (help, version), -1 on error.
+int read_config(int argc, char** argv,
+    boost::program_options::variables_map& vm,
+    std::vector<std::string>& input_files, std::string& lrs_filename,
+    std::string& constraints_filename, float& total_spin, bool& with_spin,
+    bool& tcheck, short& nimages, std::vector<int>& image_tasks);
+
+#endif
@@ -44,6 +44,14 @@ int MGmol<T>::setupFromInput(const string filename)
     int status = readCoordinates(filename, false);
     if (status == -1) return -1;
 
+    if (ct.verbose > 0)
+    {
+        // keep local mesh sizes compatible with multigrid coarsening
+        const unsigned granularity
+            = (ct.getMGlevels() > 0) ? (1 << ct.getMGlevels()) : 1;
+        ions_->printRecommendedMeshPartition(os_, granularity);
+    }
+
     const short myspin = mmpi.myspin();
     const int nval     = ions_->getNValenceElectrons();
     ct.setNumst(myspin, nval);
@@ -14,6 +14,7 @@
 #include "VariableSizeMatrix.h"
 
 #include "../Control.h"
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
@@ -89,7 +90,22 @@ DataDistribution::DataDistribution(const std::string name,
     /* get cartesian communicator */
     cart_comm_ = myPEenv.cart_comm();
 
-    dir_reduce_ = new DirectionalReduce(myPEenv.cart_comm(), s_radius, domain);
+    // with a non-uniform mesh partition, use the smallest subdomain width
+    // to make sure the spread radius is covered
+    Control& ct(*(Control::instance()));
+    double width_domain[3] = { domain[0], domain[1], domain[2] };
+    for (short d = 0; d < 3; d++)
+        if (!ct.mesh_partition_[d].empty())
+        {
+            const unsigned nmin = *std::min_element(
+                ct.mesh_partition_[d].begin(), ct.mesh_partition_[d].end());
+            width_domain[d] = domain[d] * (double)nmin
+                              * (double)ct.mesh_partition_[d].size()
+                              / (double)ct.ngpts_[d];
+        }
+
+    dir_reduce_
+        = new DirectionalReduce(myPEenv.cart_comm(), s_radius, width_domain);
 
     assert(spread_radius_ > 0.0);
 
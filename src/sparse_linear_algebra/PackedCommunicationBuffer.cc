@@ -156,9 +156,10 @@ void PackedCommunicationBuffer::mergeRecvDataToMatrix(
          * this way to make it amenable to threading
          */
         vector<int> row_size(packed_num_rows_, 0);
-        /* update existing entries*/
-// Threading here leads to results slightly dependent on number of threads (jlf,
-// 07/15/2016)
+        /* update existing entries. Packed rows are distinct, so each
+         * matrix row is updated by one thread only, and results do not
+         * depend on the number of threads
+         */
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
@@ -182,35 +182,6 @@ void sqrtDistMatrix(dist_matrix::DistMatrix<DISTMATDTYPE>& u)
 #endif
 }
 
-void setSparseDistMatriConsolidationNumber(const int npes)
-{
-    int consolidation_number = 9;
-    int remainder            = (npes % consolidation_number);
-    // find consolidation number with max. or 0 remainder;
-    if (remainder > 0)
-        for (int i = consolidation_number - 2; i < consolidation_number + 8;
-             i++)
-        {
-            if ((npes % i) == 0)
-            {
-                consolidation_number = i;
-                break;
-            }
-            int new_remainder = npes % i;
-            if ((new_remainder) > remainder)
-            {
-                consolidation_number = i;
-                remainder            = new_remainder;
-            }
-        }
-    dist_matrix::SparseDistMatrix<DISTMATDTYPE>::setConsolidationNumber(
-        consolidation_number);
-
-    if (onpe0)
-        dist_matrix::SparseDistMatrix<DISTMATDTYPE>::printConsolidationNumber(
-            *MPIdata::sout);
-}
-
 void reduceBytes(std::vector<char>& val, const MPI_Comm comm)
 {
     assert(sizeof(char) == 1);
@@ -322,19 +293,16 @@ void printWithTimeStamp(const std::string string2print, std::ostream& os)
 
 bool isOverlaping(const Vector3D& center, const float radius)
 {
-    Mesh* mymesh             = Mesh::instance();
-    const pb::Grid& mygrid   = mymesh->grid();
-    const pb::PEenv& myPEenv = mymesh->peenv();
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
 
-    const double origin[3]
-        = { mygrid.origin(0), mygrid.origin(1), mygrid.origin(2) };
     double div_lattice[3];
     for (short i = 0; i < 3; i++)
-        div_lattice[i] = mygrid.ll(i) / (double)(myPEenv.n_mpi_task(i));
+        div_lattice[i] = (double)mygrid.dim(i) * mygrid.hgrid(i);
 
     double ll[3];
     for (short i = 0; i < 3; i++)
-        ll[i] = (double)myPEenv.my_mpi(i) * div_lattice[i] + origin[i];
+        ll[i] = mygrid.start(i);
     // double  ur[3];
     // for(short i=0;i<3;i++)
     //    ur[i] = ll[i] + div_lattice[i];
@@ -24,7 +24,6 @@ void read_comments(std::ifstream& tfile);
 void rotateSym(dist_matrix::DistMatrix<DISTMATDTYPE>& mat,
     const dist_matrix::DistMatrix<DISTMATDTYPE>& rotation_matrix,
     dist_matrix::DistMatrix<DISTMATDTYPE>& work);
-void setSparseDistMatriConsolidationNumber(const int npes);
 void reduceBytes(std::vector<char>& val, const MPI_Comm comm);
 void arrayops(const double* const a, const double* const b, const double s,
     const double e, const int dim, double* result);
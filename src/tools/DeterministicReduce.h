@@ -0,0 +1,75 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_DETERMINISTICREDUCE_H
+#define MGMOL_DETERMINISTICREDUCE_H
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+// Threaded reductions with results independent of the number of threads.
+// Data is split into blocks of fixed size (not dependent on the number of
+// threads). Each block is summed sequentially by one thread into its own
+// partial sum, and partial sums are then combined in a fixed pairwise tree.
+// Results are thus bitwise reproducible for any number of OpenMP threads,
+// unlike "reduction(+ : sum)" clauses.
+
+const int deterministic_reduce_block_size = 128;
+
+// Combine partial sums in a fixed pairwise tree.
+// Overwrites partial.
+template <typename T>
+T pairwiseSum(std::vector<T>& partial)
+{
+    int n = (int)partial.size();
+    if (n == 0) return (T)0;
+
+    while (n > 1)
+    {
+        const int half = n / 2;
+        for (int i = 0; i < half; i++)
+            partial[i] = partial[2 * i] + partial[2 * i + 1];
+        if (n % 2) partial[half] = partial[n - 1];
+        n = (n + 1) / 2;
+    }
+
+    return partial[0];
+}
+
+// Sum of x[ids[i]*stride], i=0..n-1
+// (x[i*stride] if ids is not specified)
+template <typename T>
+double deterministicSum(const int n, const T* const x, const int stride = 1,
+    const int* const ids = nullptr)
+{
+    const int bsize   = deterministic_reduce_block_size;
+    const int nblocks = (n + bsize - 1) / bsize;
+
+    std::vector<double> partial(nblocks);
+#ifdef _OPENMP
+#pragma omp parallel for if (nblocks > 1)
+#endif
+    for (int ib = 0; ib < nblocks; ib++)
+    {
+        const int iend = std::min(n, (ib + 1) * bsize);
+        double sum     = 0.;
+        for (int i = ib * bsize; i < iend; i++)
+        {
+            const int j = (ids == nullptr) ? i : ids[i];
+            sum += (double)x[j * stride];
+        }
+        partial[ib] = sum;
+    }
+
+    return pairwiseSum(partial);
+}
+
+#endif
@@ -61,8 +61,8 @@ void MGmol_MPI::printTimers(ostream& os)
     split_allreduce_sums_float_tm_.print(os);
 }
 
-void MGmol_MPI::setupComm(
-    const MPI_Comm comm, const bool with_spin, const int nimages)
+void MGmol_MPI::setupComm(const MPI_Comm comm, const bool with_spin,
+    const int nimages, const std::vector<int>& image_tasks)
 {
     assert(pinstance_ == 0);
 
@@ -77,12 +77,32 @@ void MGmol_MPI::setupComm(
     if (nimages_ > 1)
     {
         // cout<<"nimages="<<nimages_<<endl;
+        // number of tasks for each image (same for all images by default)
+        std::vector<int> ntasks(image_tasks);
+        if (ntasks.empty()) ntasks.assign(nimages_, npes / nimages_);
+        int sum = 0;
+        for (std::vector<int>::const_iterator it = ntasks.begin();
+             it != ntasks.end(); ++it)
+            sum += *it;
+        if ((int)ntasks.size() != nimages_ || sum != npes)
+        {
+            if (mype_ == 0)
+                cerr << " Number of MPI tasks per image incompatible with "
+                     << npes << " MPI tasks and " << nimages_ << " images!!!"
+                     << endl;
+            MPI_Abort(comm, 1);
+        }
+
         // create communicator to communicate data within one image calculation
-        int npes_sub = npes / nimages_;
-        assert(nimages_ * npes_sub == npes);
-        myimage_ = mype_ / npes_sub; // 0 to nimages_-1
+        myimage_  = 0;
+        int first = 0;
+        while (mype_ >= first + ntasks[myimage_])
+        {
+            first += ntasks[myimage_];
+            myimage_++;
+        }
         assert(myimage_ >= 0 && myimage_ < nimages_);
-        int key = mype_ % npes_sub;
+        int key = mype_ - first;
 #ifndef NDEBUG
         int mpirc =
 #endif
@@ -91,15 +111,17 @@ void MGmol_MPI::setupComm(
         assert(mpirc == MPI_SUCCESS);
 
         // create communicator to communicate data from other images
-        int color = mype_ % npes_sub;
+        // (tasks with same rank within their image)
+        int color = key;
 #ifndef NDEBUG
         mpirc =
 #endif
             MPI_Comm_split(comm, color, myimage_, &comm_images_);
         assert(mpirc == MPI_SUCCESS);
 
+        // all images have a task of rank 0
         MPI_Comm_size(comm_images_, &npes);
-        assert(npes == nimages_);
+        assert(key > 0 || npes == nimages_);
 
         nspin_  = 1;
         myspin_ = 0;
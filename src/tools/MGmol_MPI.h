@@ -64,8 +64,8 @@ private:
 
     MGmol_MPI();
 
-    static void setupComm(
-        const MPI_Comm comm, const bool with_spin, const int nimages);
+    static void setupComm(const MPI_Comm comm, const bool with_spin,
+        const int nimages, const std::vector<int>& image_tasks);
     static Timer split_allreduce_sums_double_tm_;
     static Timer split_allreduce_sums_float_tm_;
 
@@ -88,7 +88,8 @@ public:
 
     static void setup(const MPI_Comm comm, std::ostream& os,
         const bool with_spin = false,
-        const int nimages = 1)
+        const int nimages = 1,
+        const std::vector<int>& image_tasks = std::vector<int>())
     {
         assert(pinstance_ == 0);
 
@@ -97,7 +98,7 @@ public:
         short wspin = (short)with_spin;
         MPI_Bcast(&wspin, 1, MPI_SHORT, 0, comm);
 
-        setupComm(comm, (bool)wspin, nimages);
+        setupComm(comm, (bool)wspin, nimages, image_tasks);
     }
 
     static void printTimers(std::ostream& os);
@@ -111,6 +112,7 @@ public:
     int mypeSpin() const { return mype_spin_; }
     int mypeGlobal() const { return mype_spin_; }
     int myspin() const { return myspin_; }
+    int nimages() const { return nimages_; }
     int myimage() const
     {
         assert(myimage_ < nimages_);
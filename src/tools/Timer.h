@@ -93,6 +93,9 @@ public:
 
     bool running() const { return running_; };
 
+    // accumulated real time on this MPI task
+    double realTime() const { return real(); };
+
     void stop()
     {
 #ifdef _OPENMP
@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+import sys
+import os
+import subprocess
+import string
+
+print("Test evaluateEnergyAndForces...")
+
+nargs=len(sys.argv)
+
+mpicmd = sys.argv[1]+" "+sys.argv[2]+" "+sys.argv[3]
+for i in range(4,nargs-5):
+  mpicmd = mpicmd + " "+sys.argv[i]
+print("MPI run command: {}".format(mpicmd))
+
+driver = sys.argv[nargs-5]
+exe = sys.argv[nargs-4]
+inp = sys.argv[nargs-3]
+coords = sys.argv[nargs-2]
+print("coordinates file: %s"%coords)
+
+#create links to potentials files
+dst = 'pseudo.H_ONCV_PBE_SG15'
+src = sys.argv[nargs-1] + '/' + dst
+
+cwd = os.getcwd()
+if not os.path.exists(cwd+'/'+dst):
+  print("Create link to %s"%dst)
+  os.symlink(src, dst)
+
+#run driver: two evaluations of configuration with first atom
+#displaced by 0.1 bohr in x direction
+command = "{} {} -c {} -i {}".format(mpicmd,driver,inp,coords)
+print("Run command: {}".format(command))
+
+output = subprocess.check_output(command,shell=True)
+lines=output.split(b'\n')
+
+energies = []
+forces = [[],[]]
+for line in lines:
+  if line.count(b'@@'):
+    print(line)
+    words=line.split()
+    i=eval(words[1])
+    if words[2]==b'ENERGY':
+      energies.append(eval(words[3]))
+    if words[2]==b'FORCE':
+      forces[i].append([eval(words[4]),eval(words[5]),eval(words[6])])
+
+if len(energies)!=2:
+  print("ERROR: energies of 2 evaluations not found")
+  sys.exit(1)
+
+#write displaced configuration
+displaced = 'coords_displaced.in'
+f = open(displaced,'w')
+first = True
+for line in open(coords):
+  words=line.split()
+  if first and len(words)>4:
+    words[2] = str(eval(words[2])+0.1)
+    first = False
+  f.write("  ".join(words)+"\n")
+f.close()
+
+#quench displaced configuration from scratch
+command = "{} {} -c {} -i {}".format(mpicmd,exe,inp,displaced)
+print("Run command: {}".format(command))
+
+output = subprocess.check_output(command,shell=True)
+lines=output.split(b'\n')
+
+energy = 0.
+qforces = []
+for line in lines:
+  if line.count(b'SC ENERGY'):
+    words=line.split()
+    energy = eval(words[len(words)-1])
+  if line.count(b'##'):
+    words=line.split()
+    if len(words)==8:
+      print(line)
+      qforces.append([eval(words[5]),eval(words[6]),eval(words[7])])
+
+print("Quench energy: {}".format(energy))
+
+tole = 1.e-5
+for i in range(2):
+  if abs(energies[i]-energy)>tole:
+    print("ERROR: energy of evaluation {} = {}, quench = {}".format(
+      i,energies[i],energy))
+    sys.exit(1)
+
+tolf = 1.e-3
+for i in range(2):
+  if len(forces[i])!=len(qforces):
+    print("ERROR: wrong number of forces for evaluation {}".format(i))
+    sys.exit(1)
+  for ia in range(len(qforces)):
+    for j in range(3):
+      if abs(forces[i][ia][j]-qforces[ia][j])>tolf:
+        print("ERROR: force {} of ion {}, evaluation {} = {}, quench = {}"
+          .format(j,ia,i,forces[i][ia][j],qforces[ia][j]))
+        sys.exit(1)
+
+sys.exit(0)
@@ -0,0 +1,199 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Driver for MGmolInterface::evaluateEnergyAndForces():
+// sets up MGmol from a configuration file and coordinates file (same
+// command line options as mgmol-opt), then evaluates twice in a batch
+// the configuration obtained by displacing the first atom by
+// displacement (bohr) in x direction.
+// Energies and forces are printed on lines starting with "@@",
+// to be compared with a quench of the displaced configuration.
+
+#include "Control.h"
+#include "DistMatrix.h"
+#include "ExtendedGridOrbitals.h"
+#include "LocGridOrbitals.h"
+#include "MGmol.h"
+#include "MGmol_MPI.h"
+#include "MPIdata.h"
+#include "MatricesBlacsContext.h"
+#include "Mesh.h"
+#include "PackedCommunicationBuffer.h"
+#include "ReplicatedWorkSpace.h"
+#include "read_config.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static const double displacement = 0.1;
+
+int main(int argc, char** argv)
+{
+    int mpirc = MPI_Init(&argc, &argv);
+    if (mpirc != MPI_SUCCESS)
+    {
+        std::cerr << "MPI Initialization failed!!!" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 0);
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, &mype);
+    onpe0 = (mype == 0);
+
+    std::vector<std::string> input_files;
+    std::string lrs_filename;
+    std::string constraints_filename;
+    bool tcheck      = false;
+    float total_spin = 0.;
+    bool with_spin   = false;
+    short nimages    = 1;
+    std::vector<int> image_tasks;
+
+    boost::program_options::variables_map vm;
+
+    int rc = 0;
+    if (onpe0)
+        rc = read_config(argc, argv, vm, input_files, lrs_filename,
+            constraints_filename, total_spin, with_spin, tcheck, nimages,
+            image_tasks);
+    MPI_Bcast(&rc, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&nimages, 1, MPI_SHORT, 0, MPI_COMM_WORLD);
+    if (rc != 0 || nimages > 1)
+    {
+        if (onpe0)
+            std::cerr << "testEnergyAndForces: invalid options "
+                      << "(one image only)" << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout, with_spin);
+    MGmol_MPI& mmpi      = *(MGmol_MPI::instance());
+    MPI_Comm global_comm = mmpi.commGlobal();
+
+    Control::setup(global_comm, with_spin, total_spin);
+    Control& ct = *(Control::instance());
+
+    ct.setOptions(vm);
+    ct.sync();
+
+    int ret = ct.checkOptions();
+    if (ret < 0) return ret;
+
+    std::string input_file;
+    if (onpe0) input_file = input_files[0];
+    mmpi.bcastGlobal(input_file);
+    mmpi.bcastGlobal(lrs_filename);
+
+    sout = &std::cout;
+    serr = &std::cerr;
+
+    int nerr = 0;
+    {
+        MGmolInterface* mgmol;
+        if (ct.isLocMode())
+            mgmol = new MGmol<LocGridOrbitals>(global_comm, *MPIdata::sout);
+        else
+            mgmol
+                = new MGmol<ExtendedGridOrbitals>(global_comm, *MPIdata::sout);
+
+        unsigned ngpts[3]    = { ct.ngpts_[0], ct.ngpts_[1], ct.ngpts_[2] };
+        double origin[3]     = { ct.ox_, ct.oy_, ct.oz_ };
+        const double cell[3] = { ct.lx_, ct.ly_, ct.lz_ };
+        Mesh::setup(mmpi.commSpin(), ngpts, origin, cell, ct.lap_type,
+            ct.mesh_partition_);
+
+        mgmol->setupFromInput(input_file);
+        if (ct.restart_info < 3 || !ct.isLocMode())
+            mgmol->setupLRsFromInput(lrs_filename);
+        mgmol->setupConstraintsFromInput(constraints_filename);
+
+        ct.checkNLrange();
+
+        LocGridOrbitals::setDotProduct(ct.dot_product_type);
+
+        if (!ct.short_sighted)
+        {
+            MatricesBlacsContext::instance().setup(mmpi.commSpin(), ct.numst);
+
+            dist_matrix::DistMatrix<DISTMATDTYPE>::setBlockSize(64);
+
+            dist_matrix::DistMatrix<DISTMATDTYPE>::setDefaultBlacsContext(
+                MatricesBlacsContext::instance().bcxt());
+
+            ReplicatedWorkSpace<double>::instance().setup(ct.numst);
+
+            dist_matrix::SparseDistMatrix<DISTMATDTYPE>::
+                setRemoteTasksDistMatrixPtr(
+                    MGmol<LocGridOrbitals>::getRemoteTasksDistMatrixPtr());
+        }
+
+        mgmol->setup();
+
+        // displaced configuration, evaluated twice
+        std::vector<double> tau;
+        mgmol->getAtomicPositions(tau);
+        tau[0] += displacement;
+        std::vector<std::vector<double>> taus(2, tau);
+
+        std::vector<double> energies;
+        std::vector<std::vector<double>> forces;
+        mgmol->evaluateEnergyAndForces(taus, energies, forces);
+
+        const int nions = (int)tau.size() / 3;
+        if (onpe0)
+            for (unsigned i = 0; i < energies.size(); i++)
+            {
+                std::cout << std::setprecision(10) << std::fixed << "@@ "
+                          << i << " ENERGY " << energies[i] << std::endl;
+                for (int ia = 0; ia < nions; ia++)
+                    std::cout << std::setprecision(6) << std::scientific
+                              << "@@ " << i << " FORCE " << ia << " "
+                              << forces[i][3 * ia] << " "
+                              << forces[i][3 * ia + 1] << " "
+                              << forces[i][3 * ia + 2] << std::endl;
+            }
+
+        // second evaluation starts from converged first one
+        const double tole = 1.e-6;
+        const double tolf = 1.e-4;
+        if (std::abs(energies[1] - energies[0]) > tole)
+        {
+            if (onpe0)
+                std::cerr << "Energies of same configuration differ: "
+                          << energies[0] << " and " << energies[1]
+                          << std::endl;
+            nerr++;
+        }
+        for (int i = 0; i < 3 * nions; i++)
+            if (std::abs(forces[1][i] - forces[0][i]) > tolf)
+            {
+                if (onpe0)
+                    std::cerr << "Forces of same configuration differ: "
+                              << forces[0][i] << " and " << forces[1][i]
+                              << std::endl;
+                nerr++;
+            }
+
+        mgmol->cleanup();
+        delete mgmol;
+
+        if (!ct.short_sighted) MatricesBlacsContext::instance().clear();
+    }
+
+    PackedCommunicationBuffer::deleteStorage();
+    Mesh::deleteInstance();
+    Control::deleteInstance();
+    MGmol_MPI::deleteInstance();
+
+    MPI_Finalize();
+
+    return nerr > 0 ? 1 : 0;
+}
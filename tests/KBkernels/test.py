@@ -0,0 +1,38 @@
+#!/usr/bin/env python
+import sys
+import os
+import subprocess
+import string
+
+print("Test blocked KB projectors kernels...")
+
+nargs=len(sys.argv)
+
+mpicmd = sys.argv[1]+" "+sys.argv[2]+" "+sys.argv[3]
+for i in range(4,nargs-4):
+  mpicmd = mpicmd + " "+sys.argv[i]
+print("MPI run command: {}".format(mpicmd))
+
+exe = sys.argv[nargs-4]
+inp = sys.argv[nargs-3]
+coords = sys.argv[nargs-2]
+print("coordinates file: %s"%coords)
+
+#create links to potentials files
+for dst in ['pseudo.F_ONCV_PBE_SG15', 'pseudo.H_ONCV_PBE_SG15']:
+  src = sys.argv[nargs-1] + '/' + dst
+  if not os.path.exists(dst):
+    print("Create link to %s"%dst)
+    os.symlink(src, dst)
+
+#run test: non-zero return code if kernels disagree
+command = "{} {} -c {} -i {}".format(mpicmd,exe,inp,coords)
+print("Run command: {}".format(command))
+
+output = subprocess.check_output(command,shell=True)
+lines=output.split(b'\n')
+for line in lines:
+  if line.count(b'testKBkernels'):
+    print(line)
+
+sys.exit(0)
@@ -0,0 +1,296 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Compare blocked KB projectors kernels (dotPsiBlock, add_vnlpsi) with
+// per-function kernels (dotPsi, get_vnlpsi) for random functions.
+// Functions are set to zero on randomly chosen subdomains, flagged by a
+// global index -1, as for localized orbitals.
+// Same command line options as mgmol-opt, with several subdomains
+// (1 MPI task) and species with several projectors and l>0.
+
+#include "Control.h"
+#include "Ions.h"
+#include "KBPsiMatrixSparse.h"
+#include "KBprojector.h"
+#include "LapFactory.h"
+#include "MGmol_MPI.h"
+#include "MGmol_prototypes.h"
+#include "MPIdata.h"
+#include "Mesh.h"
+#include "Potentials.h"
+#include "Species.h"
+#include "read_config.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+static const int ncolors = 20;
+
+// number of values differing by more than tol, relative to largest value
+static int compare(const std::vector<double>& a, const std::vector<double>& b,
+    const double tol)
+{
+    assert(a.size() == b.size());
+
+    double vmax = 0.;
+    for (unsigned i = 0; i < a.size(); i++)
+        vmax = std::max(vmax, std::abs(a[i]));
+
+    int nerr = 0;
+    for (unsigned i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > tol * vmax) nerr++;
+
+    return nerr;
+}
+
+int main(int argc, char** argv)
+{
+    int mpirc = MPI_Init(&argc, &argv);
+    if (mpirc != MPI_SUCCESS)
+    {
+        std::cerr << "MPI Initialization failed!!!" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 0);
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, &mype);
+    onpe0 = (mype == 0);
+
+    int npes;
+    MPI_Comm_size(MPI_COMM_WORLD, &npes);
+    if (npes != 1)
+    {
+        if (onpe0)
+            std::cerr << "testKBkernels needs 1 MPI task" << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    std::vector<std::string> input_files;
+    std::string lrs_filename;
+    std::string constraints_filename;
+    bool tcheck      = false;
+    float total_spin = 0.;
+    bool with_spin   = false;
+    short nimages    = 1;
+    std::vector<int> image_tasks;
+
+    boost::program_options::variables_map vm;
+
+    int rc = read_config(argc, argv, vm, input_files, lrs_filename,
+        constraints_filename, total_spin, with_spin, tcheck, nimages,
+        image_tasks);
+    if (rc != 0 || input_files.empty())
+    {
+        MPI_Finalize();
+        return 1;
+    }
+
+    sout = &std::cout;
+    serr = &std::cerr;
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+
+    Control::setup(mmpi.commGlobal(), with_spin, total_spin);
+    Control& ct = *(Control::instance());
+
+    ct.setOptions(vm);
+    ct.sync();
+
+    int ret = ct.checkOptions();
+    if (ret < 0) return ret;
+
+    int nerr = 0;
+    {
+        unsigned ngpts[3]    = { ct.ngpts_[0], ct.ngpts_[1], ct.ngpts_[2] };
+        double origin[3]     = { ct.ox_, ct.oy_, ct.oz_ };
+        const double cell[3] = { ct.lx_, ct.ly_, ct.lz_ };
+        Mesh::setup(mmpi.commSpin(), ngpts, origin, cell, ct.lap_type,
+            ct.mesh_partition_);
+
+        Mesh* mymesh = Mesh::instance();
+        mymesh->subdivGridx(ct.getMGlevels());
+        const pb::Grid& mygrid = mymesh->grid();
+        const int subdivx      = mymesh->subdivx();
+        const int numpt        = mygrid.size();
+        const int loc_numpt    = mymesh->locNumpt();
+        if (subdivx < 2)
+        {
+            std::cerr << "testKBkernels: mesh not subdivided" << std::endl;
+            nerr++;
+        }
+
+        // species and radial functions
+        Potentials pot;
+        ct.registerPotentials(pot);
+        ct.setSpecies(pot);
+
+        std::vector<Species>& sp(ct.getSpecies());
+        short isp = 0;
+        for (std::vector<Species>::iterator it = sp.begin(); it != sp.end();
+             ++it)
+        {
+            it->initPotentials((bool)pot.pot_type(isp), mygrid.hmax(), false);
+            isp++;
+        }
+
+        const double lattice[3] = { mygrid.ll(0), mygrid.ll(1), mygrid.ll(2) };
+        Ions ions(lattice, sp);
+        ions.readAtoms(input_files[0], false);
+        ions.setup();
+
+        // global indexes: function "color" is state "color" or -1 (zero)
+        // on each subdomain, at least one subdomain with non-zero values
+        srand(1234);
+        std::vector<std::vector<int>> gids(
+            subdivx, std::vector<int>(ncolors, -1));
+        for (int color = 0; color < ncolors; color++)
+        {
+            gids[rand() % subdivx][color] = color;
+            for (int iloc = 0; iloc < subdivx; iloc++)
+                if (rand() % 3 > 0) gids[iloc][color] = color;
+        }
+
+        // random functions, with padding between functions
+        const int ld = numpt + 8;
+        std::vector<ORBDTYPE> psi(ncolors * ld, 0.);
+        for (int color = 0; color < ncolors; color++)
+            for (int iloc = 0; iloc < subdivx; iloc++)
+                if (gids[iloc][color] != -1)
+                    for (int i = 0; i < loc_numpt; i++)
+                        psi[color * ld + iloc * loc_numpt + i]
+                            = (ORBDTYPE)((double)rand() / (double)RAND_MAX
+                                         - 0.5);
+
+        const double tol = (sizeof(ORBDTYPE) == 4) ? 1.e-4 : 1.e-10;
+
+        // <KB|psi>, one function at a time
+        pb::Lap<ORBDTYPE>* lapop
+            = LapFactory<ORBDTYPE>::createLap(mygrid, ct.lap_type);
+        KBPsiMatrixSparse kbpsi(lapop, false);
+        kbpsi.setup(ions, ncolors);
+        for (int color = 0; color < ncolors; color++)
+        {
+            pb::GridFunc<ORBDTYPE> gf(&psi[color * ld], mygrid, 1, 1, 1, 'd');
+            kbpsi.computeKBpsi(ions, &gf, color, false);
+        }
+
+        // <KB|psi> for blocks of functions
+        const std::vector<Ion*>& nl_ions(ions.overlappingNL_ions());
+        std::map<std::pair<int, int>, double> kbpsi_block;
+        for (int iloc = 0; iloc < subdivx; iloc++)
+        {
+            std::vector<int> colors;
+            for (int color = 0; color < ncolors; color++)
+                if (gids[iloc][color] != -1) colors.push_back(color);
+            if (colors.empty()) continue;
+
+            for (unsigned i = 0; i < nl_ions.size(); i++)
+            {
+                const std::shared_ptr<KBprojector> kbproj(nl_ions[i]->kbproj());
+                if (!kbproj->overlaps(iloc)) continue;
+
+                std::vector<double> val;
+                kbproj->dotPsiBlock(
+                    iloc, colors, &psi[0], ld, mygrid.vel(), val);
+
+                std::vector<int> ion_gids;
+                nl_ions[i]->getGidsNLprojs(ion_gids);
+                const short nprojs = (short)ion_gids.size();
+                for (unsigned j = 0; j < colors.size(); j++)
+                    for (short p = 0; p < nprojs; p++)
+                        kbpsi_block[std::make_pair(ion_gids[p], colors[j])]
+                            += val[p + j * nprojs];
+            }
+        }
+
+        std::vector<double> ref;
+        std::vector<double> block;
+        bool multi_l = false;
+        for (unsigned i = 0; i < nl_ions.size(); i++)
+        {
+            if (nl_ions[i]->getSpecies().max_l() > 0
+                && !nl_ions[i]->kbproj()->onlyOneProjector())
+                multi_l = true;
+
+            std::vector<int> ion_gids;
+            nl_ions[i]->getGidsNLprojs(ion_gids);
+            for (unsigned p = 0; p < ion_gids.size(); p++)
+                for (int color = 0; color < ncolors; color++)
+                {
+                    ref.push_back(kbpsi.getValIonState(ion_gids[p], color));
+                    block.push_back(
+                        kbpsi_block[std::make_pair(ion_gids[p], color)]);
+                }
+        }
+        if (!multi_l)
+        {
+            std::cerr << "testKBkernels: no species with l>0 and several "
+                      << "projectors" << std::endl;
+            nerr++;
+        }
+        int n = compare(ref, block, tol);
+        if (n > 0)
+        {
+            std::cerr << "testKBkernels: " << n << " wrong <KB|psi> values"
+                      << std::endl;
+            nerr++;
+        }
+
+        // Vnl*psi, one function at a time
+        std::vector<ORBDTYPE> hnl(numpt);
+        std::vector<double> vnlpsi_ref(ncolors * ld, 0.);
+        for (int color = 0; color < ncolors; color++)
+        {
+            get_vnlpsi(ions, gids, color, &kbpsi, &hnl[0]);
+            for (int i = 0; i < numpt; i++)
+                vnlpsi_ref[color * ld + i] = hnl[i];
+        }
+
+        // Vnl*psi for blocks of functions, as in computeHnlPhiAndAdd2HPhi()
+        std::vector<ORBDTYPE> vpsi(ncolors * ld, 0.);
+        const short bsize = 16;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (short icolor = 0; icolor < ncolors; icolor += bsize)
+        {
+            const short nb = std::min(bsize, (short)(ncolors - icolor));
+            add_vnlpsi(ions, gids, icolor, nb, &kbpsi, &vpsi[0], ld);
+        }
+
+        std::vector<double> vnlpsi_block(vpsi.begin(), vpsi.end());
+        n = compare(vnlpsi_ref, vnlpsi_block, tol);
+        if (n > 0)
+        {
+            std::cerr << "testKBkernels: " << n << " wrong Vnl*psi values"
+                      << std::endl;
+            nerr++;
+        }
+
+        delete lapop;
+    }
+
+    if (nerr == 0)
+        std::cout << "testKBkernels: blocked and per-function kernels agree"
+                  << std::endl;
+
+    Mesh::deleteInstance();
+    Control::deleteInstance();
+    MGmol_MPI::deleteInstance();
+
+    MPI_Finalize();
+
+    return nerr > 0 ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+import sys
+import os
+import shutil
+import subprocess
+import string
+
+print("Test NEB with 3 images...")
+
+nargs=len(sys.argv)
+
+mpicmd = sys.argv[1]+" "+sys.argv[2]+" "+sys.argv[3]
+for i in range(4,nargs-6):
+  mpicmd = mpicmd + " "+sys.argv[i]
+print("MPI run command: {}".format(mpicmd))
+
+exe = sys.argv[nargs-6]
+inp = sys.argv[nargs-5]
+coords = [sys.argv[nargs-4], sys.argv[nargs-3], sys.argv[nargs-2]]
+print("coordinates files: {}".format(coords))
+
+#create links to potentials files
+dst = 'pseudo.H_ONCV_PBE_SG15'
+src = sys.argv[nargs-1] + '/' + dst
+
+cwd = os.getcwd()
+if not os.path.exists(cwd+'/'+dst):
+  print("Create link to %s"%dst)
+  os.symlink(src, dst)
+
+#remove restart files from previous runs
+restart = ''
+for line in open(inp):
+  if line.startswith('output_filename'):
+    restart = line.split('=')[1].strip()
+for i in range(3):
+  name = "{}_image{}".format(restart,i)
+  if os.path.exists(name):
+    shutil.rmtree(name)
+
+#run mgmol
+command = "{} {} -c {} -i {} -i {} -i {}".format(mpicmd,exe,inp,
+  coords[0],coords[1],coords[2])
+print("Run command: {}".format(command))
+
+output = subprocess.check_output(command,shell=True)
+
+#analyse mgmol standard output
+lines=output.split(b'\n')
+
+#energies of images at last step
+energies = []
+converged = False
+for i in range(len(lines)):
+  if lines[i].count(b'IMAGES ENERGIES'):
+    print(lines[i])
+    energies = []
+    for ii in range(i+1,i+4):
+      print(lines[ii])
+      words=lines[ii].split()
+      energies.append(eval(words[2]))
+  if lines[i].count(b'achieved for all images'):
+    converged = True
+
+if len(energies)!=3:
+  print("ERROR: energies of 3 images not found")
+  sys.exit(1)
+
+if not converged:
+  print("ERROR: NEB did not converge")
+  sys.exit(1)
+
+#images are translations of the same molecule:
+#energies should differ only by egg-box effect
+tol = 1.e-3
+for i in range(1,3):
+  if abs(energies[i]-energies[0])>tol:
+    print("ERROR: energy of image {} = {}, image 0 = {}".format(
+      i,energies[i],energies[0]))
+    sys.exit(1)
+
+#each image writes its own restart file
+for i in range(3):
+  name = "{}_image{}".format(restart,i)
+  if not os.path.exists(name):
+    print("ERROR: restart file {} not found".format(name))
+    sys.exit(1)
+
+sys.exit(0)
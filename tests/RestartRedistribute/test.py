@@ -0,0 +1,131 @@
+#!/usr/bin/env python
+import sys
+import os
+import glob
+import shutil
+import subprocess
+import string
+
+print("Test restart with a different number of MPI tasks...")
+
+nargs=len(sys.argv)
+
+#number of tasks writing the first restart files
+ntasks = eval(sys.argv[3])
+
+mpicmd = sys.argv[1]+" "+sys.argv[2]+" {}"
+for i in range(4,nargs-5):
+  mpicmd = mpicmd + " "+sys.argv[i]
+print("MPI run command: {}".format(mpicmd.format(ntasks)))
+
+exe = sys.argv[nargs-5]
+compare = sys.argv[nargs-4]
+inp = sys.argv[nargs-3]
+coords = sys.argv[nargs-2]
+print("coordinates file: %s"%coords)
+
+#create links to potentials files
+dst = 'pseudo.D_tm_pbe'
+src = sys.argv[nargs-1] + '/' + dst
+
+cwd = os.getcwd()
+if not os.path.exists(cwd+'/'+dst):
+  print("Create link to %s"%dst)
+  os.symlink(src, dst)
+
+#remove restart files from previous runs
+names = ['wf_quench','wf_a','wf_b','wf_c','wf_d']
+for name in names:
+  for d in glob.glob(name+'.h5*'):
+    shutil.rmtree(d)
+
+#run mgmol on np tasks with input file inp completed by restart options
+#(orbitals written in sparse layout), starting from restart files
+#written in directory restart.
+#Return restart directory written, energy and lines with atoms positions
+#and forces
+def run(name, np, restart=''):
+  cfg = name+'.cfg'
+  with open(cfg,'w') as f:
+    for line in open(inp):
+      if restart and line.startswith('max_steps'):
+        line = 'max_steps=0\n'
+      f.write(line)
+    f.write('output_filename={}.h5\n'.format(name))
+    f.write('output_sparse=true\n')
+    if restart:
+      f.write('input_level=3\n')
+      f.write('input_filename={}\n'.format(restart))
+
+  command = "{} {} -c {} -i {}".format(mpicmd.format(np),exe,cfg,coords)
+  print("Run command: {}".format(command))
+  output = subprocess.check_output(command,shell=True)
+  os.remove(cfg)
+
+  energy = 0.
+  atoms = []
+  for line in output.split(b'\n'):
+    if line.count(b'SC ENERGY'):
+      energy = eval(line.split()[-1])
+    if line.startswith(b'##') and len(line.split())==8:
+      atoms.append(line.decode())
+
+  dirs = glob.glob(name+'.h5*')
+  if len(dirs)!=1:
+    print("ERROR: restart directory {} not found".format(name))
+    sys.exit(1)
+  print("Restart files {}, energy {}".format(dirs[0],energy))
+  return dirs[0], energy, atoms
+
+#compare restart files in directories dir1 and dir2
+def compare_files(dir1, dir2, tol):
+  command = "{} {} {} {}".format(compare,dir1,dir2,tol)
+  print("Run command: {}".format(command))
+  output = subprocess.check_output(command,shell=True)
+  print(output.decode())
+
+#compare energies and atoms of two runs
+def compare_runs(e1, atoms1, e2, atoms2, tol):
+  if abs(e1-e2)>tol:
+    print("ERROR: energies {} and {} differ".format(e1,e2))
+    sys.exit(1)
+  if len(atoms1)==0 or len(atoms1)!=len(atoms2):
+    print("ERROR: atoms lists differ")
+    sys.exit(1)
+  for a1, a2 in zip(atoms1,atoms2):
+    w1 = a1.split()
+    w2 = a2.split()
+    #same atoms at same positions
+    if w1[1:5]!=w2[1:5]:
+      print("ERROR: {} and {} differ".format(a1,a2))
+      sys.exit(1)
+    for i in range(5,8):
+      if abs(eval(w1[i])-eval(w2[i]))>tol:
+        print("ERROR: forces {} and {} differ".format(a1,a2))
+        sys.exit(1)
+
+#quench on ntasks
+quench, e, atoms = run('wf_quench', ntasks)
+
+#restart without iterating on ntasks and ntasks/2 tasks
+a, e_a, atoms_a = run('wf_a', ntasks, quench)
+b, e_b, atoms_b = run('wf_b', ntasks//2, quench)
+
+#energies and forces are printed with 8 digits
+tol = 1.e-6
+tol_files = 1.e-8
+compare_runs(e_a, atoms_a, e_b, atoms_b, tol)
+compare_files(a, b, tol_files)
+
+#restart on ntasks from files written on ntasks and ntasks/2 tasks
+c, e_c, atoms_c = run('wf_c', ntasks, a)
+d, e_d, atoms_d = run('wf_d', ntasks, b)
+
+compare_runs(e_c, atoms_c, e_d, atoms_d, tol)
+compare_files(c, d, tol_files)
+
+for name in names:
+  for d in glob.glob(name+'.h5*'):
+    shutil.rmtree(d)
+
+sys.exit(0)
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+import sys
+import os
+import glob
+import shutil
+import subprocess
+import string
+
+print("Test restart files in sparse layout...")
+
+nargs=len(sys.argv)
+
+mpicmd = sys.argv[1]+" "+sys.argv[2]+" "+sys.argv[3]
+for i in range(4,nargs-5):
+  mpicmd = mpicmd + " "+sys.argv[i]
+print("MPI run command: {}".format(mpicmd))
+
+exe = sys.argv[nargs-5]
+compare = sys.argv[nargs-4]
+inp = sys.argv[nargs-3]
+coords = sys.argv[nargs-2]
+print("coordinates file: %s"%coords)
+
+#create links to potentials files
+dst = 'pseudo.D_tm_pbe'
+src = sys.argv[nargs-1] + '/' + dst
+
+cwd = os.getcwd()
+if not os.path.exists(cwd+'/'+dst):
+  print("Create link to %s"%dst)
+  os.symlink(src, dst)
+
+#remove restart files from previous runs
+names = ['wf_quench','wf_dense','wf_sparse','wf_ref','wf_check']
+for name in names:
+  for d in glob.glob(name+'.h5*'):
+    shutil.rmtree(d)
+
+#run mgmol with input file inp completed by restart options,
+#return restart directory written and energy at last step
+def run(name, options, restart_steps=True):
+  cfg = name+'.cfg'
+  with open(cfg,'w') as f:
+    for line in open(inp):
+      if restart_steps and line.startswith('max_steps'):
+        line = 'max_steps=0\n'
+      f.write(line)
+    f.write('output_filename={}.h5\n'.format(name))
+    for option in options:
+      f.write(option+'\n')
+
+  command = "{} {} -c {} -i {}".format(mpicmd,exe,cfg,coords)
+  print("Run command: {}".format(command))
+  output = subprocess.check_output(command,shell=True)
+  os.remove(cfg)
+
+  energy = ''
+  for line in output.split(b'\n'):
+    if line.count(b'SC ENERGY'):
+      energy = line.split()[-1].decode()
+
+  dirs = glob.glob(name+'.h5*')
+  if len(dirs)!=1:
+    print("ERROR: restart directory {} not found".format(name))
+    sys.exit(1)
+  print("Restart files {}, energy {}".format(dirs[0],energy))
+  return dirs[0], energy
+
+#quench and write orbitals in dense layout
+quench, e = run('wf_quench', [], False)
+
+#restart without iterating, write the same data in dense and sparse layouts
+dense, e = run('wf_dense',
+  ['input_level=3','input_filename={}'.format(quench)])
+sparse, e = run('wf_sparse',
+  ['input_level=3','input_filename={}'.format(quench),'output_sparse=true'])
+
+#restart from each layout without iterating, write dense layout
+ref, e_ref = run('wf_ref',
+  ['input_level=3','input_filename={}'.format(dense)])
+check, e_check = run('wf_check',
+  ['input_level=3','input_filename={}'.format(sparse)])
+
+if e_check != e_ref:
+  print("ERROR: energy {} after sparse restart, {} after dense restart".format(
+    e_check,e_ref))
+  sys.exit(1)
+
+#data read from both layouts should be identical
+command = "{} {} {} 0.".format(compare,ref,check)
+print("Run command: {}".format(command))
+output = subprocess.check_output(command,shell=True)
+print(output.decode())
+
+for name in names:
+  for d in glob.glob(name+'.h5*'):
+    shutil.rmtree(d)
+
+sys.exit(0)
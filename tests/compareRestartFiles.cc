@@ -0,0 +1,497 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Compare two restart directories written with one file per task
+// (Restart.output_type=distributed):
+//     compareRestartFiles dir1 dir2 tol
+// If both were written with the same decomposition, all the datasets and
+// their attributes are compared file by file (bitwise for tol=0).
+// Otherwise, dataset "/Decomposition" is used to assemble grid functions
+// (Vtotal, Density,...) on the global mesh, and localized orbitals written
+// in the sparse layout are assembled by gid. Atomic positions are matched
+// by atom name, localization centers by gid.
+// Differences are relative to the largest absolute value of the data.
+
+#include <hdf5.h>
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// values of a dataset or attribute: numbers are converted to double,
+// strings are kept as bytes
+struct Values
+{
+    std::vector<hsize_t> dims;
+    std::vector<double> num;
+    std::string str;
+};
+
+static int nerr = 0;
+
+static void error(const std::string& msg)
+{
+    std::cerr << "compareRestartFiles: " << msg << std::endl;
+    nerr++;
+}
+
+static bool readValues(hid_t obj_id, const bool is_attribute, Values& v)
+{
+    hid_t type_id  = is_attribute ? H5Aget_type(obj_id) : H5Dget_type(obj_id);
+    hid_t space_id = is_attribute ? H5Aget_space(obj_id) : H5Dget_space(obj_id);
+
+    const int rank = H5Sget_simple_extent_ndims(space_id);
+    v.dims.resize(rank);
+    if (rank > 0) H5Sget_simple_extent_dims(space_id, &v.dims[0], NULL);
+    const hssize_t n = H5Sget_simple_extent_npoints(space_id);
+    H5Sclose(space_id);
+
+    herr_t status = 0;
+    const H5T_class_t type_class = H5Tget_class(type_id);
+    if (type_class == H5T_INTEGER || type_class == H5T_FLOAT)
+    {
+        v.num.resize(n);
+        if (n > 0)
+            status = is_attribute
+                         ? H5Aread(obj_id, H5T_NATIVE_DOUBLE, &v.num[0])
+                         : H5Dread(obj_id, H5T_NATIVE_DOUBLE, H5S_ALL,
+                               H5S_ALL, H5P_DEFAULT, &v.num[0]);
+    }
+    else
+    {
+        hid_t mem_type_id = H5Tget_native_type(type_id, H5T_DIR_DEFAULT);
+        v.str.resize(n * H5Tget_size(mem_type_id));
+        if (n > 0)
+            status = is_attribute ? H5Aread(obj_id, mem_type_id, &v.str[0])
+                                  : H5Dread(obj_id, mem_type_id, H5S_ALL,
+                                        H5S_ALL, H5P_DEFAULT, &v.str[0]);
+        H5Tclose(mem_type_id);
+    }
+    H5Tclose(type_id);
+
+    return status >= 0;
+}
+
+static double maxAbs(const std::vector<double>& a)
+{
+    double vmax = 0.;
+    for (std::vector<double>::const_iterator it = a.begin(); it != a.end();
+         ++it)
+        vmax = std::max(vmax, std::abs(*it));
+    return vmax;
+}
+
+// number of values differing by more than tol, relative to largest value
+static int compare(
+    const std::vector<double>& a, const std::vector<double>& b, const double tol)
+{
+    if (a.size() != b.size()) return (int)std::max(a.size(), b.size());
+
+    const double vmax = maxAbs(a);
+
+    int n = 0;
+    for (unsigned i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > tol * vmax) n++;
+
+    return n;
+}
+
+static void compareValues(const Values& v1, const Values& v2,
+    const std::string& name, const double tol)
+{
+    if (v1.dims != v2.dims || v1.str != v2.str)
+    {
+        error(name + " differ");
+        return;
+    }
+    const int n = compare(v1.num, v2.num, tol);
+    if (n > 0) error(name + ": " + std::to_string(n) + " values differ");
+}
+
+static std::vector<std::string> listFiles(const std::string& dirname)
+{
+    std::vector<std::string> files;
+
+    DIR* dir = opendir(dirname.c_str());
+    if (dir == NULL)
+    {
+        error("cannot open directory " + dirname);
+        return files;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        const std::string name(entry->d_name);
+        if (name.compare(0, 4, "Task") == 0)
+            files.push_back(dirname + "/" + name);
+    }
+    closedir(dir);
+
+    // task numbers have the same number of digits
+    std::sort(files.begin(), files.end());
+
+    return files;
+}
+
+static std::vector<hid_t> openFiles(const std::vector<std::string>& names)
+{
+    std::vector<hid_t> files;
+    for (std::vector<std::string>::const_iterator it = names.begin();
+         it != names.end(); ++it)
+    {
+        hid_t file_id = H5Fopen(it->c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        if (file_id < 0)
+            error("cannot open " + *it);
+        else
+            files.push_back(file_id);
+    }
+    return files;
+}
+
+static void readDataset(hid_t file_id, const std::string& name, Values& v)
+{
+    hid_t dset_id = H5Dopen2(file_id, name.c_str(), H5P_DEFAULT);
+    if (dset_id < 0 || !readValues(dset_id, false, v))
+        error("cannot read dataset " + name);
+    if (dset_id >= 0) H5Dclose(dset_id);
+}
+
+static bool readAttribute(hid_t dset_id, const std::string& name, Values& v)
+{
+    if (H5Aexists(dset_id, name.c_str()) <= 0) return false;
+
+    hid_t attr_id = H5Aopen(dset_id, name.c_str(), H5P_DEFAULT);
+    const bool ok = readValues(attr_id, true, v);
+    H5Aclose(attr_id);
+    if (!ok) error("cannot read attribute " + name);
+
+    return ok;
+}
+
+static herr_t addDatasetName(hid_t /*obj_id*/, const char* name,
+    const H5O_info_t* info, void* op_data)
+{
+    if (info->type == H5O_TYPE_DATASET)
+        static_cast<std::vector<std::string>*>(op_data)->push_back(
+            std::string("/") + name);
+    return 0;
+}
+
+static std::vector<std::string> datasetNames(hid_t file_id)
+{
+    std::vector<std::string> names;
+    H5Ovisit(file_id, H5_INDEX_NAME, H5_ITER_INC, addDatasetName, &names);
+    return names;
+}
+
+static herr_t addAttributeName(hid_t /*obj_id*/, const char* name,
+    const H5A_info_t* /*info*/, void* op_data)
+{
+    static_cast<std::vector<std::string>*>(op_data)->push_back(name);
+    return 0;
+}
+
+static std::vector<std::string> attributeNames(hid_t dset_id)
+{
+    std::vector<std::string> names;
+    H5Aiterate2(dset_id, H5_INDEX_NAME, H5_ITER_INC, NULL, addAttributeName,
+        &names);
+    return names;
+}
+
+// compare all datasets of two files, and their attributes
+static void compareFiles(hid_t file1, hid_t file2, const std::string& fname,
+    const double tol)
+{
+    const std::vector<std::string> names1(datasetNames(file1));
+    const std::vector<std::string> names2(datasetNames(file2));
+    if (names1 != names2)
+    {
+        error("different datasets in " + fname);
+        return;
+    }
+
+    for (std::vector<std::string>::const_iterator it = names1.begin();
+         it != names1.end(); ++it)
+    {
+        const std::string name(fname + ":" + *it);
+
+        Values v1;
+        Values v2;
+        readDataset(file1, *it, v1);
+        readDataset(file2, *it, v2);
+        compareValues(v1, v2, name, tol);
+
+        hid_t dset1 = H5Dopen2(file1, it->c_str(), H5P_DEFAULT);
+        hid_t dset2 = H5Dopen2(file2, it->c_str(), H5P_DEFAULT);
+        const std::vector<std::string> attnames(attributeNames(dset1));
+        if (attnames != attributeNames(dset2))
+            error("different attributes for " + name);
+        else
+            for (std::vector<std::string>::const_iterator at
+                 = attnames.begin();
+                 at != attnames.end(); ++at)
+            {
+                Values a1;
+                Values a2;
+                readAttribute(dset1, *at, a1);
+                readAttribute(dset2, *at, a2);
+                compareValues(a1, a2, name + "/" + *at, tol);
+            }
+        H5Dclose(dset1);
+        H5Dclose(dset2);
+    }
+}
+
+static bool isOrbitalsDataset(const std::string& name)
+{
+    return name.find("Function") != std::string::npos;
+}
+
+// data of a restart directory on the global mesh
+struct GlobalData
+{
+    std::vector<int> boxes;
+    hsize_t dims[3];
+
+    // grid functions
+    std::map<std::string, std::vector<double>> functions;
+
+    // sparse orbitals by (name of set, gid)
+    std::map<std::pair<std::string, int>, std::vector<double>> orbitals;
+    int nfull_orbitals;
+
+    // localization center and radius by gid
+    std::map<int, std::vector<double>> centers;
+
+    // positions by atom name
+    std::map<std::string, std::vector<double>> positions;
+};
+
+static void readGlobalData(
+    const std::vector<hid_t>& files, const std::string& dirname, GlobalData& g)
+{
+    g.nfull_orbitals = 0;
+
+    Values dec;
+    readDataset(files[0], "/Decomposition", dec);
+    if (dec.num.size() != 6 * files.size())
+    {
+        error("no valid decomposition in " + dirname);
+        return;
+    }
+    g.boxes.assign(dec.num.begin(), dec.num.end());
+
+    for (short d = 0; d < 3; d++)
+    {
+        g.dims[d] = 0;
+        for (unsigned i = 0; i < files.size(); i++)
+            g.dims[d] = std::max(
+                g.dims[d], (hsize_t)(g.boxes[6 * i + d] + g.boxes[6 * i + 3 + d]));
+    }
+    const hsize_t size = g.dims[0] * g.dims[1] * g.dims[2];
+
+    for (unsigned i = 0; i < files.size(); i++)
+    {
+        const int* const box = &g.boxes[6 * i];
+
+        const std::vector<std::string> names(datasetNames(files[i]));
+        for (std::vector<std::string>::const_iterator it = names.begin();
+             it != names.end(); ++it)
+        {
+            Values v;
+            readDataset(files[i], *it, v);
+
+            hid_t dset_id = H5Dopen2(files[i], it->c_str(), H5P_DEFAULT);
+
+            if (isOrbitalsDataset(*it))
+            {
+                // localization centers and radii, and their gids
+                Values cr;
+                Values gids;
+                if (readAttribute(dset_id, "List of centers and radii", cr)
+                    && readAttribute(dset_id, "List of gids", gids))
+                    for (unsigned j = 0; j < gids.num.size(); j++)
+                    {
+                        std::vector<double> c(
+                            cr.num.begin() + 4 * j, cr.num.begin() + 4 * j + 4);
+                        const int gid = (int)gids.num[j];
+                        if (g.centers.count(gid) && g.centers[gid] != c)
+                            error("inconsistent centers for gid "
+                                  + std::to_string(gid) + " in " + dirname);
+                        g.centers[gid] = c;
+                    }
+
+                Values sboxes;
+                if (!readAttribute(dset_id, "List of sparse boxes", sboxes))
+                {
+                    g.nfull_orbitals++;
+                    H5Dclose(dset_id);
+                    continue;
+                }
+
+                // function of gid sboxes[0] in box of global start index
+                // sboxes[1..3] and extents sboxes[4..6]
+                const std::string set(
+                    it->substr(0, it->find_last_not_of("0123456789") + 1));
+                std::vector<double>::const_iterator pv = v.num.begin();
+                for (unsigned j = 0; j < sboxes.num.size(); j += 7)
+                {
+                    const std::vector<int> sb(
+                        sboxes.num.begin() + j, sboxes.num.begin() + j + 7);
+
+                    std::vector<double>& f(
+                        g.orbitals[std::make_pair(set, sb[0])]);
+                    f.resize(size, 0.);
+                    for (int ix = sb[1]; ix < sb[1] + sb[4]; ix++)
+                        for (int iy = sb[2]; iy < sb[2] + sb[5]; iy++)
+                            for (int iz = sb[3]; iz < sb[3] + sb[6]; iz++)
+                                f[(ix * g.dims[1] + iy) * g.dims[2] + iz]
+                                    += *(pv++);
+                }
+            }
+            else if (v.dims.size() == 3 && (int)v.dims[0] == box[3]
+                     && (int)v.dims[1] == box[4] && (int)v.dims[2] == box[5])
+            {
+                std::vector<double>& f(g.functions[*it]);
+                f.resize(size, 0.);
+                std::vector<double>::const_iterator pv = v.num.begin();
+                for (int ix = box[0]; ix < box[0] + box[3]; ix++)
+                    for (int iy = box[1]; iy < box[1] + box[4]; iy++)
+                        for (int iz = box[2]; iz < box[2] + box[5]; iz++)
+                            f[(ix * g.dims[1] + iy) * g.dims[2] + iz]
+                                = *(pv++);
+            }
+
+            H5Dclose(dset_id);
+        }
+
+        // atoms listed in this file
+        if (H5Lexists(files[i], "/Atomic_names", H5P_DEFAULT) > 0)
+        {
+            Values names;
+            Values tau;
+            readDataset(files[i], "/Atomic_names", names);
+            readDataset(files[i], "/Ionic_positions", tau);
+            const size_t natoms = tau.num.size() / 3;
+            const size_t len    = natoms > 0 ? names.str.size() / natoms : 0;
+            for (size_t ia = 0; ia < natoms; ia++)
+            {
+                const std::string name(names.str.c_str() + ia * len);
+                if (g.positions.count(name))
+                    error("atom " + name + " found twice in " + dirname);
+                g.positions[name] = std::vector<double>(
+                    tau.num.begin() + 3 * ia, tau.num.begin() + 3 * ia + 3);
+            }
+        }
+    }
+}
+
+template <typename Key>
+static void compareMaps(const std::map<Key, std::vector<double>>& m1,
+    const std::map<Key, std::vector<double>>& m2, const std::string& what,
+    const double tol)
+{
+    if (m1.size() != m2.size())
+    {
+        error("different numbers of " + what + ": "
+              + std::to_string(m1.size()) + " and "
+              + std::to_string(m2.size()));
+        return;
+    }
+    typename std::map<Key, std::vector<double>>::const_iterator it1
+        = m1.begin();
+    typename std::map<Key, std::vector<double>>::const_iterator it2
+        = m2.begin();
+    int ndiff = 0;
+    for (; it1 != m1.end(); ++it1, ++it2)
+        if (it1->first != it2->first
+            || compare(it1->second, it2->second, tol) > 0)
+            ndiff++;
+    if (ndiff > 0) error(std::to_string(ndiff) + " " + what + " differ");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: compareRestartFiles dir1 dir2 tol" << std::endl;
+        return 1;
+    }
+    const std::string dir1(argv[1]);
+    const std::string dir2(argv[2]);
+    const double tol = atof(argv[3]);
+
+    const std::vector<std::string> names1(listFiles(dir1));
+    const std::vector<std::string> names2(listFiles(dir2));
+    if (names1.empty() || names2.empty())
+    {
+        error("no restart files");
+        return 1;
+    }
+
+    std::vector<hid_t> files1(openFiles(names1));
+    std::vector<hid_t> files2(openFiles(names2));
+    if (nerr > 0) return 1;
+
+    Values dec1;
+    Values dec2;
+    readDataset(files1[0], "/Decomposition", dec1);
+    readDataset(files2[0], "/Decomposition", dec2);
+
+    if (dec1.num == dec2.num)
+    {
+        std::cout << "Compare " << files1.size()
+                  << " files with same decomposition" << std::endl;
+        for (unsigned i = 0; i < files1.size(); i++)
+            compareFiles(files1[i], files2[i],
+                names1[i].substr(dir1.size() + 1), tol);
+    }
+    else
+    {
+        std::cout << "Compare data assembled from " << files1.size()
+                  << " and " << files2.size() << " files" << std::endl;
+        GlobalData g1;
+        GlobalData g2;
+        readGlobalData(files1, dir1, g1);
+        readGlobalData(files2, dir2, g2);
+
+        if (g1.nfull_orbitals > 0 || g2.nfull_orbitals > 0)
+            error("orbitals can only be compared in sparse layout");
+        if (g1.positions.empty()) error("no atoms in " + dir1);
+
+        compareMaps(g1.functions, g2.functions, "grid functions", tol);
+        compareMaps(g1.orbitals, g2.orbitals, "orbitals", tol);
+        compareMaps(g1.centers, g2.centers, "localization centers", tol);
+        compareMaps(g1.positions, g2.positions, "atomic positions", tol);
+
+        std::cout << g1.functions.size() << " grid functions, "
+                  << g1.orbitals.size() << " orbitals, " << g1.centers.size()
+                  << " centers, " << g1.positions.size() << " atoms"
+                  << std::endl;
+    }
+
+    for (unsigned i = 0; i < files1.size(); i++)
+        H5Fclose(files1[i]);
+    for (unsigned i = 0; i < files2.size(); i++)
+        H5Fclose(files2[i]);
+
+    if (nerr == 0)
+        std::cout << "compareRestartFiles: " << dir1 << " and " << dir2
+                  << " agree" << std::endl;
+
+    return nerr > 0 ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "ChebyshevFermi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+double fermi(const double e, const double mu, const double width)
+{
+    return 1. / (1. + std::exp((e - mu) / width));
+}
+
+double entropy(const double f)
+{
+    double s = 0.;
+    if (f > 0.) s -= f * std::log(f);
+    if (f < 1.) s -= (1. - f) * std::log(1. - f);
+    return s;
+}
+
+double sumFermi(
+    const std::vector<double>& eigs, const double mu, const double width)
+{
+    double sum = 0.;
+    for (auto e : eigs)
+        sum += fermi(e, mu, width);
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "Test ChebyshevFermi" << std::endl;
+
+    // diagonal matrix: eigenvalues and spectral bounds
+    const int n = 12;
+    std::vector<double> eigs(n);
+    for (int i = 0; i < n; i++)
+        eigs[i] = -1. + 0.25 * i + 0.01 * i * i;
+    const double emin = eigs[0] - 0.1;
+    const double emax = eigs[n - 1] + 0.1;
+
+    const double width = 0.05;
+    const int ndigits  = 6;
+    const double tol   = std::pow(10., -ndigits);
+
+    const int order
+        = ChebyshevFermi::estimateOrder(emin, emax, width, ndigits);
+    std::cout << "Order: " << order << std::endl;
+
+    // a polynomial of the estimated degree should support that width
+    const double wmin = ChebyshevFermi::minWidth(emin, emax, order, ndigits);
+    if (wmin > width)
+    {
+        std::cerr << "minWidth(" << order << ")=" << wmin
+                  << " larger than width " << width << std::endl;
+        return 1;
+    }
+
+    ChebyshevFermi cheb(emin, emax, width, order);
+
+    // moments tr(T_k(X)) of diagonal matrix
+    std::vector<double> moments(order + 1, 0.);
+    for (auto e : eigs)
+    {
+        const double theta = std::acos(cheb.scale() * (e - cheb.center()));
+        for (int k = 0; k <= order; k++)
+            moments[k] += std::cos(k * theta);
+    }
+
+    // expansion coefficients vs. exact Fermi and entropy functions
+    {
+        const double mu = 0.3;
+        std::vector<double> cf;
+        std::vector<double> cs;
+        cheb.computeCoefficients(mu, cf);
+        cheb.computeEntropyCoefficients(mu, cs);
+
+        const int npts = 1000;
+        double errf    = 0.;
+        double errs    = 0.;
+        for (int j = 0; j <= npts; j++)
+        {
+            const double e     = emin + (emax - emin) * j / (double)npts;
+            const double x     = cheb.scale() * (e - cheb.center());
+            const double theta = std::acos(std::max(-1., std::min(1., x)));
+            double f = 0.;
+            double s = 0.;
+            for (int k = 0; k <= order; k++)
+            {
+                const double t = std::cos(k * theta);
+                f += cf[k] * t;
+                s += cs[k] * t;
+            }
+            const double fe = fermi(e, mu, width);
+            errf            = std::max(errf, std::abs(f - fe));
+            errs            = std::max(errs, std::abs(s - entropy(fe)));
+        }
+        std::cout << "Max. error Fermi function: " << errf << std::endl;
+        std::cout << "Max. error entropy function: " << errs << std::endl;
+        if (errf > tol)
+        {
+            std::cerr << "Fermi function approximation error " << errf
+                      << " larger than " << tol << std::endl;
+            return 1;
+        }
+        // entropy function has a cusp at mu: lower accuracy expected
+        if (errs > 10. * tol)
+        {
+            std::cerr << "Entropy function approximation error " << errs
+                      << " larger than " << 10. * tol << std::endl;
+            return 1;
+        }
+    }
+
+    // chemical potential: compare with exact bisection
+    const double nocc = 5.;
+    const double mu   = cheb.computeChemicalPotential(moments, nocc);
+
+    double mu1 = emin - 10. * width;
+    double mu2 = emax + 10. * width;
+    for (int it = 0; it < 200; it++)
+    {
+        const double mid = 0.5 * (mu1 + mu2);
+        if (sumFermi(eigs, mid, width) < nocc)
+            mu1 = mid;
+        else
+            mu2 = mid;
+    }
+    const double mu_exact = 0.5 * (mu1 + mu2);
+    std::cout << "mu = " << mu << ", exact mu = " << mu_exact << std::endl;
+
+    const double nel = sumFermi(eigs, mu, width);
+    if (std::abs(nel - nocc) > n * tol)
+    {
+        std::cerr << "Occupation " << nel << " at mu=" << mu
+                  << " differs from " << nocc << std::endl;
+        return 1;
+    }
+    if (std::abs(mu - mu_exact) > 1.e-3 * width)
+    {
+        std::cerr << "Chemical potential " << mu << " differs from exact "
+                  << mu_exact << std::endl;
+        return 1;
+    }
+
+    // entropy from moments vs. exact
+    {
+        double s_exact = 0.;
+        for (auto e : eigs)
+            s_exact += entropy(fermi(e, mu, width));
+        const double s = cheb.entropy(moments, mu);
+        std::cout << "Entropy = " << s << ", exact = " << s_exact
+                  << std::endl;
+        if (std::abs(s - s_exact) > 10. * n * tol)
+        {
+            std::cerr << "Entropy " << s << " differs from exact " << s_exact
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
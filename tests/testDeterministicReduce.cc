@@ -0,0 +1,99 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Check that threaded reductions give bitwise identical results
+// with 1, 2, 4 and 8 OpenMP threads
+
+#include "DeterministicReduce.h"
+#include "SquareLocalMatrices.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+static void setNumThreads(const int nthreads)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+#else
+    (void)nthreads;
+#endif
+}
+
+static bool sameBits(const double a, const double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    const int nthreads[4] = { 1, 2, 4, 8 };
+
+    // values of very different magnitudes, so that the result of a sum
+    // depends on the order of the additions
+    const int n = 10007;
+    std::vector<double> x(n);
+    std::vector<int> ids;
+    srand(11);
+    for (int i = 0; i < n; i++)
+    {
+        const double r = (double)rand() / (double)RAND_MAX - 0.5;
+        x[i]           = r * std::pow(10., (double)(rand() % 16));
+        if (i % 3 == 0) ids.push_back(i);
+    }
+
+    // diagonal of a local matrix
+    const int m = 500;
+    SquareLocalMatrices<double> mat(1, m);
+    double* const mdata = mat.getSubMatrix(0);
+    for (int i = 0; i < m; i++)
+        mdata[i * (m + 1)] = x[i];
+    std::vector<int> diag_ids;
+    for (int i = 0; i < m; i += 2)
+        diag_ids.push_back(i);
+
+    double ref[3] = { 0., 0., 0. };
+    for (int t = 0; t < 4; t++)
+    {
+        setNumThreads(nthreads[t]);
+
+        double val[3];
+        val[0] = deterministicSum(n, &x[0]);
+        val[1] = deterministicSum((int)ids.size(), &x[0], 1, &ids[0]);
+        val[2] = mat.computePartialTrace(diag_ids, 0);
+
+        std::cout << "Number of threads = " << nthreads[t] << std::endl;
+        for (int k = 0; k < 3; k++)
+        {
+            std::cout.precision(17);
+            std::cout << "    sum " << k << " = " << val[k] << std::endl;
+            if (t == 0)
+                ref[k] = val[k];
+            else if (!sameBits(val[k], ref[k]))
+            {
+                std::cerr << "Result for " << nthreads[t]
+                          << " threads differs from result with 1 thread!!!"
+                          << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
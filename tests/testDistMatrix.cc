@@ -22,6 +22,7 @@
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 
 int aa(int i, int j) { return i+2*j; }
@@ -165,6 +166,76 @@ int main(int argc, char **argv)
           
     std::cout << " results checked" << std::endl;
 
+    // local matrix times distributed matrix
+    {
+        if (mype == 0) std::cout << "DistMatrix::multiplyFromLeft..." << std::endl;
+        const int mloc = 5 + mype;
+        std::vector<double> x(mloc * b.m());
+        for (int k = 0; k < b.m(); k++)
+            for (int i = 0; i < mloc; i++)
+                x[i + k * mloc] = aa(i, k);
+        std::vector<double> y(mloc * b.n(), 1.);
+        b.multiplyFromLeft(mloc, 1., x.data(), mloc, 0., y.data(), mloc);
+        for (int j = 0; j < b.n(); j++)
+            for (int i = 0; i < mloc; i++)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < b.m(); k++)
+                    sum += aa(i, k) * bb(k, j);
+                if (fabs(y[i + j * mloc] - sum) > 1.e-8)
+                {
+                    std::cout << " multiplyFromLeft: error at element (" << i
+                              << "," << j << ") " << y[i + j * mloc] << " "
+                              << sum << std::endl;
+                    return 1;
+                }
+            }
+    }
+
+    // eigensolvers: full spectrum (syev, syevd) and lowest eigenpairs (syevr)
+    {
+        if (mype == 0) std::cout << "DistMatrix::syevd/syevr..." << std::endl;
+        dist_matrix::DistMatrix<double> h("h", bc, n, n, nb, nb);
+        for (int m = 0; m < h.nblocks(); m++)
+            for (int l = 0; l < h.mblocks(); l++)
+                for (int y = 0; y < h.nbs(m); y++)
+                    for (int x = 0; x < h.mbs(l); x++)
+                    {
+                        int i = h.i(l, x);
+                        int j = h.j(m, y);
+                        double hij = 1. / (1. + abs(i - j));
+                        if (i == j) hij += (double)i;
+                        h.setval(x + l * h.mb() + (y + m * h.nb()) * h.mloc(),
+                            hij);
+                    }
+        dist_matrix::DistMatrix<double> z("z", bc, n, n, nb, nb);
+        std::vector<double> wref(n);
+        dist_matrix::DistMatrix<double> h1(h);
+        h1.syev('n', 'l', wref, z);
+
+        std::vector<double> w(n);
+        dist_matrix::DistMatrix<double> h2(h);
+        h2.syevd('l', w, z);
+        for (int i = 0; i < n; i++)
+            if (fabs(w[i] - wref[i]) > 1.e-8)
+            {
+                std::cout << " syevd: error for eigenvalue " << i << " "
+                          << w[i] << " " << wref[i] << std::endl;
+                return 1;
+            }
+
+        const int nev = 5;
+        dist_matrix::DistMatrix<double> h3(h);
+        h3.syevr('l', 0, nev - 1, w, z);
+        for (int i = 0; i < nev; i++)
+            if (fabs(w[i] - wref[i]) > 1.e-8)
+            {
+                std::cout << " syevr: error for eigenvalue " << i << " "
+                          << w[i] << " " << wref[i] << std::endl;
+                return 1;
+            }
+    }
+
     double norma=a.norm('F');
     if(mype == 0)std::cout<<"Norm(a)="<<norma<<std::endl;
     if(mype == 0)std::cout<<"DistMatrix::matgather..."<<std::endl;
@@ -0,0 +1,154 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Check validation of user defined partitions against MG coarsening,
+// and init_vect_shift() with uniform and non-uniform partitions
+
+#include "Grid.h"
+#include "GridFunc.h"
+#include "MGmol_MPI.h"
+#include "PEenv.h"
+
+#include <mpi.h>
+
+#include <iostream>
+#include <vector>
+
+static double value(const int i, const int j, const int k)
+{
+    return i * 10000. + j * 100. + k;
+}
+
+// returns number of wrong values in shifted global array
+static int testShift(const bool uniform)
+{
+    unsigned ngpts[3] = { 24, 24, 24 };
+    pb::PEenv env(MPI_COMM_WORLD, ngpts[0], ngpts[1], ngpts[2], 4);
+    double origin[3] = { 0., 0., 0. };
+    double ll[3]     = { 24., 24., 24. };
+
+    // non-uniform: move 2 points from last to first interval
+    std::vector<unsigned> partition[3];
+    for (short d = 0; d < 3; d++)
+    {
+        const int n = env.n_mpi_task(d);
+        partition[d].assign(n, ngpts[d] / n);
+        if (!uniform && n > 1)
+        {
+            partition[d][0] += 2;
+            partition[d][n - 1] -= 2;
+        }
+    }
+    pb::Grid grid(origin, ll, ngpts, env, 1, 0, partition);
+
+    const int dim[3]
+        = { (int)grid.dim(0), (int)grid.dim(1), (int)grid.dim(2) };
+    std::vector<double> loc(dim[0] * dim[1] * dim[2]);
+    for (int i = 0; i < dim[0]; i++)
+        for (int j = 0; j < dim[1]; j++)
+            for (int k = 0; k < dim[2]; k++)
+                loc[(i * dim[1] + j) * dim[2] + k]
+                    = value(grid.istart(0) + i, grid.istart(1) + j,
+                        grid.istart(2) + k);
+    pb::GridFunc<double> gf(&loc[0], grid, 1, 1, 1, 'd');
+
+    // global function shifted by half the domain in each direction
+    const int n[3] = { (int)ngpts[0], (int)ngpts[1], (int)ngpts[2] };
+    std::vector<double> global(n[0] * n[1] * n[2], -1.);
+    gf.init_vect_shift(&global[0]);
+
+    int nerr = 0;
+    for (int i = 0; i < n[0]; i++)
+        for (int j = 0; j < n[1]; j++)
+            for (int k = 0; k < n[2]; k++)
+            {
+                const int si = (i + n[0] / 2) % n[0];
+                const int sj = (j + n[1] / 2) % n[1];
+                const int sk = (k + n[2] / 2) % n[2];
+                if (global[(si * n[1] + sj) * n[2] + sk] != value(i, j, k))
+                    nerr++;
+            }
+
+    return nerr;
+}
+
+int main(int argc, char** argv)
+{
+    int mpirc = MPI_Init(&argc, &argv);
+    if (mpirc != MPI_SUCCESS)
+    {
+        std::cerr << "MPI Initialization failed!!!" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 0);
+    }
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+    const int mype  = mmpi.mypeGlobal();
+
+    int nerr = 0;
+
+    // partition validation
+    {
+        std::vector<unsigned> valid = { 16, 8, 12 };
+        if (pb::Grid::checkCoarsening(valid, 2, 1) != -1)
+        {
+            if (mype == 0)
+                std::cerr << "Valid partition rejected" << std::endl;
+            nerr++;
+        }
+        // 12 not a multiple of 2^3
+        std::vector<unsigned> notdiv = { 16, 12, 24 };
+        if (pb::Grid::checkCoarsening(notdiv, 3, 1) != 1)
+        {
+            if (mype == 0)
+                std::cerr << "Partition not divisible by 2^3 accepted"
+                          << std::endl;
+            nerr++;
+        }
+        // 8 is only 2 points at coarsest level, less than 2*2 ghosts
+        if (pb::Grid::checkCoarsening(valid, 2, 2) != 1)
+        {
+            if (mype == 0)
+                std::cerr << "Partition too small at coarsest level accepted"
+                          << std::endl;
+            nerr++;
+        }
+        // no MG levels: only ghosts matter
+        std::vector<unsigned> odd = { 7, 3 };
+        if (pb::Grid::checkCoarsening(odd, -1, 1) != -1
+            || pb::Grid::checkCoarsening(odd, 0, 2) != 1)
+        {
+            if (mype == 0)
+                std::cerr << "Wrong check without coarsening" << std::endl;
+            nerr++;
+        }
+    }
+
+    // init_vect_shift
+    for (short u = 0; u < 2; u++)
+    {
+        const bool uniform = (u == 0);
+        int err            = testShift(uniform);
+        mmpi.allreduce(&err, 1, MPI_SUM);
+        if (err > 0)
+        {
+            if (mype == 0)
+                std::cerr << "init_vect_shift: " << err << " wrong values"
+                          << (uniform ? " (uniform)" : " (non-uniform)")
+                          << std::endl;
+            nerr++;
+        }
+    }
+
+    MGmol_MPI::deleteInstance();
+    MPI_Finalize();
+
+    return nerr > 0 ? 1 : 0;
+}
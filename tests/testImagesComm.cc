@@ -0,0 +1,112 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Check communicators set up by MGmol_MPI for 3 images with unequal
+// numbers of tasks (1, 3 and 2 tasks), so that groups of tasks with the
+// same rank within their image have fewer than 3 members for rank>0
+
+#include "MGmol_MPI.h"
+
+#include <mpi.h>
+
+#include <iostream>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    int mpirc = MPI_Init(&argc, &argv);
+    if (mpirc != MPI_SUCCESS)
+    {
+        std::cerr << "MPI Initialization failed!!!" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 0);
+    }
+
+    int npes;
+    int mype;
+    MPI_Comm_size(MPI_COMM_WORLD, &npes);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mype);
+    if (npes != 6)
+    {
+        if (mype == 0)
+            std::cerr << "testImagesComm needs 6 MPI tasks" << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    const int nimages = 3;
+    std::vector<int> image_tasks = { 1, 3, 2 };
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout, false, nimages, image_tasks);
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+
+    // expected image and rank within image for each global task
+    const int images[6] = { 0, 1, 1, 1, 2, 2 };
+    const int keys[6]   = { 0, 0, 1, 2, 0, 1 };
+
+    int nerr = 0;
+    if (mmpi.nimages() != nimages || mmpi.myimage() != images[mype])
+    {
+        std::cerr << "Task " << mype << ": image " << mmpi.myimage()
+                  << " instead of " << images[mype] << std::endl;
+        nerr++;
+    }
+    if (mmpi.size() != image_tasks[images[mype]]
+        || mmpi.mypeSpin() != keys[mype])
+    {
+        std::cerr << "Task " << mype << ": rank " << mmpi.mypeSpin() << " of "
+                  << mmpi.size() << " in image, instead of " << keys[mype]
+                  << " of " << image_tasks[images[mype]] << std::endl;
+        nerr++;
+    }
+    if (mmpi.instancePE0() != (keys[mype] == 0))
+    {
+        std::cerr << "Task " << mype << ": wrong instancePE0()" << std::endl;
+        nerr++;
+    }
+
+    // group of tasks with same rank in their image:
+    // number of members and sum of their image indexes
+    // (rank 0: 3 images, rank 1: images 1 and 2, rank 2: image 1)
+    const int group_size[3] = { 3, 2, 1 };
+    const int group_sum[3]  = { 3, 3, 1 };
+    double data[2]          = { 1., (double)mmpi.myimage() };
+    mmpi.allreduceImages(data, 2, MPI_SUM);
+    if ((int)data[0] != group_size[keys[mype]]
+        || (int)data[1] != group_sum[keys[mype]])
+    {
+        std::cerr << "Task " << mype << ": images group of size "
+                  << data[0] << " instead of " << group_size[keys[mype]]
+                  << std::endl;
+        nerr++;
+    }
+
+    // number of tasks of each image, as gathered by ImagesEnsemble
+    std::vector<int> ntasks(nimages, 0);
+    if (mmpi.instancePE0())
+    {
+        std::vector<int> mytasks(1, mmpi.size());
+        mmpi.allGatherImages(mytasks, ntasks);
+    }
+    mmpi.bcast(&ntasks[0], nimages);
+    for (int i = 0; i < nimages; i++)
+        if (ntasks[i] != image_tasks[i])
+        {
+            std::cerr << "Task " << mype << ": image " << i << " has "
+                      << ntasks[i] << " tasks instead of " << image_tasks[i]
+                      << std::endl;
+            nerr++;
+        }
+
+    MPI_Allreduce(MPI_IN_PLACE, &nerr, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+    MGmol_MPI::deleteInstance();
+    MPI_Finalize();
+
+    return nerr > 0 ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Check mixed-precision gemm/syrk against dgemm,
+// and compare timings of MPgemm with sgemm and dgemm
+// Usage: testMPgemm [m n k]
+
+#include "Timer.h"
+#include "mputils.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// fill a float matrix and its double copy with the same random values
+static void setRandom(std::vector<float>& af, std::vector<double>& ad)
+{
+    for (size_t i = 0; i < af.size(); i++)
+    {
+        af[i] = (float)(rand() % 1000) / 1000.f - 0.5f;
+        ad[i] = (double)af[i];
+    }
+}
+
+// max. relative difference between c and reference cref
+static double relDiff(const int m, const int n, const float* const c,
+    const int ldc, const std::vector<double>& cref)
+{
+    double maxref  = 0.;
+    double maxdiff = 0.;
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < m; i++)
+        {
+            const double ref = cref[j * ldc + i];
+            maxref           = std::max(maxref, std::abs(ref));
+            maxdiff = std::max(maxdiff, std::abs(c[j * ldc + i] - ref));
+        }
+    return maxref > 0. ? maxdiff / maxref : maxdiff;
+}
+
+static int checkGemm(const char transa, const char transb, const int m,
+    const int n, const int k)
+{
+    const int lda = (transa == 'N') ? m : k;
+    const int ldb = (transb == 'N') ? k : n;
+    const int acols = (transa == 'N') ? k : m;
+    const int bcols = (transb == 'N') ? n : k;
+
+    std::vector<float> af(lda * acols);
+    std::vector<double> ad(lda * acols);
+    std::vector<float> bf(ldb * bcols);
+    std::vector<double> bd(ldb * bcols);
+    std::vector<float> cf(m * n);
+    std::vector<double> cd(m * n);
+    setRandom(af, ad);
+    setRandom(bf, bd);
+    setRandom(cf, cd);
+
+    const double alpha = 0.5;
+    const double beta  = -2.;
+    MPgemm(transa, transb, m, n, k, alpha, &af[0], lda, &bf[0], ldb, beta,
+        &cf[0], m);
+    DGEMM(&transa, &transb, &m, &n, &k, &alpha, &ad[0], &lda, &bd[0], &ldb,
+        &beta, &cd[0], &m);
+
+    const double diff = relDiff(m, n, &cf[0], m, cd);
+    std::cout << "MPgemm " << transa << transb << ", m=" << m << ", n=" << n
+              << ", k=" << k << ", rel. difference = " << diff << std::endl;
+    if (diff > 1.e-6)
+    {
+        std::cerr << "MPgemm failed!!!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+static int checkSyrk(const char uplo, const char trans, const int n, const int k)
+{
+    const int lda   = (trans == 'N') ? n : k;
+    const int acols = (trans == 'N') ? k : n;
+
+    std::vector<float> af(lda * acols);
+    std::vector<double> ad(lda * acols);
+    std::vector<float> cf(n * n);
+    std::vector<double> cd(n * n);
+    setRandom(af, ad);
+    setRandom(cf, cd);
+
+    // reference: full matrix with dgemm
+    const char transb  = (trans == 'N') ? 'T' : 'N';
+    const double alpha = 1.;
+    const double beta  = 0.5;
+    std::vector<double> cref(cd);
+    DGEMM(&trans, &transb, &n, &n, &k, &alpha, &ad[0], &lda, &ad[0], &lda,
+        &beta, &cref[0], &n);
+
+    MPsyrk(uplo, trans, n, k, alpha, &af[0], lda, beta, &cf[0], n);
+
+    // triangle not referenced should be unchanged
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < n; i++)
+        {
+            const bool referenced = (uplo == 'U') ? (i <= j) : (i >= j);
+            if (!referenced) cref[j * n + i] = cd[j * n + i];
+        }
+
+    const double diff = relDiff(n, n, &cf[0], n, cref);
+    std::cout << "MPsyrk " << uplo << trans << ", n=" << n << ", k=" << k
+              << ", rel. difference = " << diff << std::endl;
+    if (diff > 1.e-6)
+    {
+        std::cerr << "MPsyrk failed!!!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// time C = A^T*B, typical of overlap matrices computations
+static void benchmark(const int m, const int n, const int k, const int nrep)
+{
+    std::vector<float> af(k * m);
+    std::vector<double> ad(k * m);
+    std::vector<float> bf(k * n);
+    std::vector<double> bd(k * n);
+    std::vector<float> cf(m * n);
+    std::vector<double> cd(m * n);
+    setRandom(af, ad);
+    setRandom(bf, bd);
+
+    const char transa = 'T';
+    const char transb = 'N';
+
+    Timer mp_tm("MPgemm");
+    Timer s_tm("sgemm");
+    Timer d_tm("dgemm");
+
+    for (int i = 0; i < nrep; i++)
+    {
+        mp_tm.start();
+        MPgemm(transa, transb, m, n, k, 1., &af[0], k, &bf[0], k, 0., &cf[0],
+            m);
+        mp_tm.stop();
+
+        const float falpha = 1.f;
+        const float fbeta  = 0.f;
+        s_tm.start();
+        SGEMM(&transa, &transb, &m, &n, &k, &falpha, &af[0], &k, &bf[0], &k,
+            &fbeta, &cf[0], &m);
+        s_tm.stop();
+
+        const double dalpha = 1.;
+        const double dbeta  = 0.;
+        d_tm.start();
+        DGEMM(&transa, &transb, &m, &n, &k, &dalpha, &ad[0], &k, &bd[0], &k,
+            &dbeta, &cd[0], &m);
+        d_tm.stop();
+    }
+
+    std::cout << "Timings for C = A^T*B, m=" << m << ", n=" << n
+              << ", k=" << k << std::endl;
+    mp_tm.print(std::cout);
+    s_tm.print(std::cout);
+    d_tm.print(std::cout);
+}
+
+int main(int argc, char** argv)
+{
+    MPI_Init(&argc, &argv);
+
+    std::cout << "Test MPgemm" << std::endl;
+
+    int m = 200;
+    int n = 200;
+    int k = 20000;
+    if (argc > 3)
+    {
+        m = atoi(argv[1]);
+        n = atoi(argv[2]);
+        k = atoi(argv[3]);
+    }
+
+    int status = 0;
+
+    // sizes not multiple of blocking sizes
+    const char trans[2] = { 'N', 'T' };
+    for (int ia = 0; ia < 2; ia++)
+        for (int ib = 0; ib < 2; ib++)
+        {
+            status += checkGemm(trans[ia], trans[ib], 77, 131, 301);
+            status += checkGemm(trans[ia], trans[ib], 5, 3, 2);
+        }
+
+    const char uplo[2] = { 'U', 'L' };
+    for (int iu = 0; iu < 2; iu++)
+        for (int it = 0; it < 2; it++)
+        {
+            status += checkSyrk(uplo[iu], trans[it], 139, 517);
+            status += checkSyrk(uplo[iu], trans[it], 7, 3);
+        }
+
+    benchmark(m, n, k, 5);
+
+    MPI_Finalize();
+
+    return status;
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// Written by J.-L. Fattebert, D. Osei-Kuffuor and I.S. Dunn.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+// Check schedule of Hartree sweeps and DM updates of SCFController
+// for a sequence of energy variations
+
+#include "MGmol_MPI.h"
+#include "SCFController.h"
+
+#include <mpi.h>
+
+#include <iostream>
+
+// spend some time in a phase, so that its cost is measurable
+static void busyPhase(SCFController& scf, const SCFController::Phase phase,
+    const double seconds)
+{
+    scf.startPhase();
+    const double t0 = MPI_Wtime();
+    while (MPI_Wtime() - t0 < seconds)
+        ;
+    scf.stopPhase(phase);
+}
+
+// one SCF iteration with given DM update cost, returns true if DM updated
+static bool iteration(
+    SCFController& scf, const double de, const double dm_cost)
+{
+    busyPhase(scf, SCFController::Density, 0.002);
+    const bool dm_updated = scf.updateDM();
+    if (dm_updated) busyPhase(scf, SCFController::DMUpdate, dm_cost);
+    scf.endIteration(de);
+
+    return dm_updated;
+}
+
+static int check(const bool cond, const char* const msg, const int mype)
+{
+    if (!cond)
+    {
+        if (mype == 0) std::cerr << "testSCFController: " << msg << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int mpirc = MPI_Init(&argc, &argv);
+    if (mpirc != MPI_SUCCESS)
+    {
+        std::cerr << "MPI Initialization failed!!!" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 0);
+    }
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+    const int mype  = mmpi.mypeGlobal();
+
+    const double tol = 1.e-8;
+    int nerr         = 0;
+
+    // inactive controller: full sweeps and DM update at every iteration
+    {
+        SCFController scf(false, tol);
+        for (int it = 0; it < 5; it++)
+        {
+            nerr += check(scf.hartreeSweeps(10) == 10,
+                "inactive controller changed number of sweeps", mype);
+            nerr += check(iteration(scf, 1.e-3 * it, 0.002),
+                "inactive controller skipped DM update", mype);
+            nerr += check(
+                scf.dmUpToDate(), "inactive: DM not up to date", mype);
+        }
+    }
+
+    // active controller, fast convergence with expensive DM updates
+    {
+        SCFController scf(true, tol);
+
+        // far from convergence: half sweeps, at least one
+        nerr += check(scf.hartreeSweeps(10) == 5,
+            "far from convergence: expected 5 sweeps", mype);
+        nerr += check(scf.hartreeSweeps(1) == 1,
+            "far from convergence: expected 1 sweep", mype);
+
+        // energy variation reduced by 10 at each iteration
+        double de        = 1.e-1;
+        int nskipped     = 0;
+        int nconsecutive = 0;
+        for (int it = 0; it < 12; it++)
+        {
+            const bool updated = iteration(scf, de, 0.01);
+            if (updated)
+            {
+                nconsecutive = 0;
+            }
+            else
+            {
+                nskipped++;
+                nconsecutive++;
+            }
+            nerr += check(nconsecutive < 4,
+                "more than 3 consecutive DM updates skipped", mype);
+            de *= 0.1;
+            if (de < 10. * tol) break;
+        }
+        nerr += check(nskipped > 0,
+            "fast convergence: no DM update skipped", mype);
+
+        // slow convergence: back to DM update at every iteration
+        de = 1.e-2;
+        iteration(scf, de, 0.01);
+        for (int it = 0; it < 4; it++)
+        {
+            de *= 0.9;
+            nerr += check(iteration(scf, de, 0.01),
+                "slow convergence: DM update skipped", mype);
+        }
+
+        // close to convergence: full sweeps, DM update at every iteration
+        de = tol;
+        for (int it = 0; it < 4; it++)
+        {
+            de *= 0.1;
+            nerr += check(iteration(scf, de, 0.01),
+                "close to convergence: DM update skipped", mype);
+            nerr += check(scf.hartreeSweeps(10) == 10,
+                "close to convergence: expected 10 sweeps", mype);
+        }
+    }
+
+    // active controller, fast convergence with cheap DM updates:
+    // DM update never skipped
+    {
+        SCFController scf(true, tol);
+        double de = 1.e-1;
+        for (int it = 0; it < 5; it++)
+        {
+            nerr += check(iteration(scf, de, 0.),
+                "cheap DM update skipped", mype);
+            de *= 0.1;
+        }
+    }
+
+    if (mype == 0 && nerr == 0)
+        std::cout << "testSCFController: all checks passed" << std::endl;
+
+    MGmol_MPI::deleteInstance();
+    MPI_Finalize();
+
+    return nerr > 0 ? 1 : 0;
+}